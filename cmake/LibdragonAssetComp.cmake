@@ -0,0 +1,64 @@
+# Detects if libdragon's asset compressor (the code behind 'mkasset') can be compiled into a host target.
+#
+# assetcomp.c relies on the compressors in 'tools/common' and libdragon's own decompressors,
+# which depending on the libdragon version are either included by assetcomp.c itself or separate sources.
+# Both layouts are tried with a test program that also pins the signature of 'asset_compress'.
+#
+# Sets:
+#   P64_ASSETCOMP_FOUND    - TRUE if a working set of sources was found
+#   P64_ASSETCOMP_SOURCES  - sources to add to a target
+#   P64_ASSETCOMP_INCLUDES - include directories needed by them
+
+set(P64_ASSETCOMP_FOUND FALSE)
+set(P64_ASSETCOMP_SOURCES "")
+set(P64_ASSETCOMP_INCLUDES "")
+
+set(_LIBDRAGON_DIR "${CMAKE_CURRENT_LIST_DIR}/../vendored/libdragon")
+cmake_path(NORMAL_PATH _LIBDRAGON_DIR)
+set(_ASSETCOMP_MAIN "${_LIBDRAGON_DIR}/tools/common/assetcomp.c")
+
+if(NOT P64_NATIVE_ASSETCOMP)
+    message(STATUS "Native asset compression: disabled")
+elseif(NOT EXISTS "${_ASSETCOMP_MAIN}")
+    message(STATUS "Native asset compression: libdragon submodule missing, using mkasset")
+else()
+    set(_ASSETCOMP_INCLUDES
+        "${_LIBDRAGON_DIR}"
+        "${_LIBDRAGON_DIR}/include"
+        "${_LIBDRAGON_DIR}/src"
+        "${_LIBDRAGON_DIR}/tools/common"
+    )
+
+    # compressors next to assetcomp.c, used as separate sources if assetcomp.c doesn't include them
+    file(GLOB _ASSETCOMP_COMPANIONS
+        "${_LIBDRAGON_DIR}/tools/common/*_compress.c"
+        "${_LIBDRAGON_DIR}/tools/common/*_compress.cpp"
+        "${_LIBDRAGON_DIR}/tools/common/binout.c"
+    )
+
+    set(_ASSETCOMP_CANDIDATE_0 "${_ASSETCOMP_MAIN}")
+    set(_ASSETCOMP_CANDIDATE_1 "${_ASSETCOMP_MAIN};${_ASSETCOMP_COMPANIONS}")
+
+    foreach(_IDX 0 1)
+        try_compile(_ASSETCOMP_OK
+            "${CMAKE_BINARY_DIR}/assetcomp_check_${_IDX}"
+            SOURCES "${CMAKE_CURRENT_LIST_DIR}/assetcompCheck.cpp" ${_ASSETCOMP_CANDIDATE_${_IDX}}
+            CMAKE_FLAGS "-DINCLUDE_DIRECTORIES=${_ASSETCOMP_INCLUDES}"
+            CXX_STANDARD 20
+            OUTPUT_VARIABLE _ASSETCOMP_LOG
+        )
+        if(_ASSETCOMP_OK)
+            set(P64_ASSETCOMP_FOUND TRUE)
+            set(P64_ASSETCOMP_SOURCES ${_ASSETCOMP_CANDIDATE_${_IDX}})
+            set(P64_ASSETCOMP_INCLUDES ${_ASSETCOMP_INCLUDES})
+            break()
+        endif()
+    endforeach()
+
+    if(P64_ASSETCOMP_FOUND)
+        list(LENGTH P64_ASSETCOMP_SOURCES _ASSETCOMP_COUNT)
+        message(STATUS "Native asset compression: enabled (${_ASSETCOMP_COUNT} source files)")
+    else()
+        message(WARNING "Native asset compression: libdragon's assetcomp.c failed to build or link, using mkasset.\n${_ASSETCOMP_LOG}")
+    endif()
+endif()
@@ -0,0 +1,16 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Configure-time check, see 'LibdragonAssetComp.cmake'.
+// Fails to compile if 'asset_compress' doesn't have the signature 'Build::AssetCompress' expects,
+// and fails to link if any of the compressors it needs are missing.
+extern "C" {
+  #include "tools/common/assetcomp.h"
+}
+
+int main()
+{
+  bool (*fn)(const char*, const char*, int, int) = asset_compress;
+  return fn ? 0 : 1;
+}
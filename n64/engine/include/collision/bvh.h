@@ -9,17 +9,40 @@
 namespace P64::Coll
 {
   constexpr int MAX_RESULT_COUNT = 32;
+  // max. tree depth that can be traversed, deeper nodes are skipped and reported via 'BVHResult::overflow'
+  constexpr int MAX_STACK_SIZE = 32;
 
+  /**
+   * Result and traversal state of a BVH query.
+   * The state is kept here (and not in the BVH) so queries are reentrant,
+   * and so a query can continue once 'triIndex' is full, see 'BVH::vsAABB'.
+   */
   struct BVHResult {
     int16_t triIndex[MAX_RESULT_COUNT]{};
     int16_t count{};
+    uint16_t nodesVisited{}; // metrics only, number of nodes tested during the query
 
-    void reset() { count = 0; }
+    uint16_t stack[MAX_STACK_SIZE]{}; // node indices left to check, starts with the root
+    uint8_t stackSize{1};
+    bool overflow{}; // tree was deeper than 'MAX_STACK_SIZE', results are incomplete
+
+    void reset() {
+      count = 0;
+      nodesVisited = 0;
+      stack[0] = 0;
+      stackSize = 1;
+      overflow = false;
+    }
+
+    [[nodiscard]] bool hasMore() const { return stackSize != 0; }
   };
 
   struct BVHNode {
     AABB aabb{};
     uint16_t value{};
+
+    [[nodiscard]] int getDataCount() const { return value & 0b1111; }
+    [[nodiscard]] int getOffset() const { return (int16_t)value >> 4; }
   };
   static_assert(sizeof(BVHNode) == (7 * sizeof(int16_t)));
 
@@ -29,12 +52,109 @@ namespace P64::Coll
     BVHNode nodes[];
     // uint16_t data[];
 
-    void vsAABB(const AABB &aabb, BVHResult &res) const;
+    [[nodiscard]] const int16_t* getData() const {
+      return (const int16_t*)&nodes[nodeCount]; // data starts right after nodes
+    }
 
-    inline void vsBCS(const BCS &bcs, BVHResult &res) const {
-      vsAABB((bcs).toAABB(), res);
+    /**
+     * Collects all triangles whose leaf overlaps with the given AABB.
+     * If 'res.triIndex' gets full, the query stops and returns false.
+     * Calling it again with the same result continues where it left off, e.g.:
+     *
+     *   res.reset();
+     *   do {
+     *     bvh.vsAABB(aabb, res);
+     *     // ...handle 'res.triIndex'
+     *   } while(res.hasMore());
+     *
+     * @return true if the query is done, false if there are more results
+     */
+    bool vsAABB(const AABB &aabb, BVHResult &res) const;
+
+    inline bool vsBCS(const BCS &bcs, BVHResult &res) const {
+      return vsAABB((bcs).toAABB(), res);
     }
 
-    void raycast(const fm_vec3_t &pos, const fm_vec3_t &dir, BVHResult &res) const;
+    /**
+     * Casts a ray, visiting nodes front-to-back.
+     * 'testTri(triIndex)' must return the hit distance along 'dir' (in units of 'dir'), or a negative value if missed.
+     * Nodes further away than the closest hit so far are skipped.
+     * Resets 'res', only its metrics and overflow flag are used.
+     *
+     * @return distance of the closest hit, negative if nothing was hit
+     */
+    template<typename F>
+    float raycast(const fm_vec3_t &pos, const fm_vec3_t &dir, BVHResult &res, F &&testTri) const;
   };
-}
\ No newline at end of file
+
+  template<typename F>
+  float BVH::raycast(const fm_vec3_t &pos, const fm_vec3_t &dir, BVHResult &res, F &&testTri) const
+  {
+    res.reset();
+    res.stackSize = 0;
+    if(nodeCount == 0)return -1.0f;
+
+    const auto invDir = AABB::getInvDir(dir);
+    const int16_t *data = getData();
+
+    float stackDist[MAX_STACK_SIZE];
+    float closest = -1.0f;
+
+    auto push = [&](int idx, float dist) {
+      if(res.stackSize == MAX_STACK_SIZE) {
+        res.overflow = true;
+        return;
+      }
+      stackDist[res.stackSize] = dist;
+      res.stack[res.stackSize++] = idx;
+    };
+
+    ++res.nodesVisited;
+    float rootDist = nodes[0].aabb.rayDist(pos, invDir);
+    if(rootDist >= 0.0f)push(0, rootDist);
+
+    while(res.stackSize != 0)
+    {
+      --res.stackSize;
+      const int idx = res.stack[res.stackSize];
+      // may have been pushed before a closer hit was found
+      if(closest >= 0.0f && stackDist[res.stackSize] > closest)continue;
+
+      const BVHNode &node = nodes[idx];
+      int leafCount = node.getDataCount();
+      int offset = node.getOffset();
+
+      if(leafCount != 0) {
+        for(int i=offset; i < offset+leafCount; ++i) {
+          float dist = testTri(data[i]);
+          if(dist >= 0.0f && (closest < 0.0f || dist < closest))closest = dist;
+        }
+        continue;
+      }
+
+      int idxA = idx + offset;
+      int idxB = idxA + 1;
+      res.nodesVisited += 2;
+      float distA = nodes[idxA].aabb.rayDist(pos, invDir);
+      float distB = nodes[idxB].aabb.rayDist(pos, invDir);
+      bool hitA = distA >= 0.0f && (closest < 0.0f || distA <= closest);
+      bool hitB = distB >= 0.0f && (closest < 0.0f || distB <= closest);
+
+      // push the far child first, so the near one is checked next
+      if(hitA && hitB) {
+        if(distA <= distB) {
+          push(idxB, distB);
+          push(idxA, distA);
+        } else {
+          push(idxA, distA);
+          push(idxB, distB);
+        }
+      } else if(hitA) {
+        push(idxA, distA);
+      } else if(hitB) {
+        push(idxB, distB);
+      }
+    }
+    return closest;
+  }
+}
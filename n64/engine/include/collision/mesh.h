@@ -22,13 +22,33 @@ namespace P64::Coll
     // mirrors the collion data in the t3dm extension
     uint32_t triCount{};
     uint32_t vertCount{};
-    float collScale{};
-    fm_vec3_t *verts{};
-    IVec3 *normals{};
+    float vertScale{}; // scale of the fixed-point vertices
+    IVec3 *verts{}; // use 'getVert'
+    uint16_t *normals{}; // octahedral encoded per triangle, use 'getNormal'
     BVH* bvh{};
     // data follows here: indices, normals, verts, BVH
     int16_t indices[];
 
+    [[nodiscard]] fm_vec3_t getVert(uint32_t idx) const {
+      return {{
+        (float)verts[idx].v[0] * vertScale,
+        (float)verts[idx].v[1] * vertScale,
+        (float)verts[idx].v[2] * vertScale
+      }};
+    }
+
+    [[nodiscard]] fm_vec3_t getNormal(uint32_t triIdx) const;
+
+    /**
+     * Decodes a triangle (vertices + normal) into the given struct, the AABB is left untouched.
+     */
+    void getTriangle(uint32_t triIdx, Triangle &tri) const {
+      tri.normal = getNormal(triIdx);
+      tri.v[0] = getVert(indices[triIdx*3]);
+      tri.v[1] = getVert(indices[triIdx*3+1]);
+      tri.v[2] = getVert(indices[triIdx*3+2]);
+    }
+
     [[nodiscard]] CollInfo vsSphere(const BCS &sphere, const Triangle& triangle) const;
     [[nodiscard]] CollInfo vsBox(const BCS &box, const Triangle& triangle) const;
     [[nodiscard]] RaycastRes vsRay(const fm_vec3_t &pos, const fm_vec3_t &dir, const Triangle& triangle) const;
@@ -36,15 +56,65 @@ namespace P64::Coll
     static Mesh* load(void* rawData);
   };
 
+  /**
+   * Collision mesh split into chunks, each with its own BVH.
+   * Large meshes are split by the editor so that every chunk fits 16-bit indices and the 12-bit BVH offsets,
+   * small meshes have a single chunk.
+   */
+  struct MeshChunks
+  {
+    struct Chunk {
+      AABB aabb{}; // local-space bounds of the chunk, same as the root of its BVH
+      uint32_t offset{}; // relative to the start of 'MeshChunks'
+    };
+    static_assert(sizeof(Chunk) == 16);
+
+    uint32_t chunkCount{};
+    AABB aabb{}; // local-space bounds of all chunks
+    Chunk chunks[];
+
+    [[nodiscard]] const Mesh& getMesh(uint32_t idx) const {
+      return *(const Mesh*)((const char*)this + chunks[idx].offset);
+    }
+
+    /**
+     * Resolves the pointers of all chunks, safe to call multiple times on the same data
+     * (e.g. a model shared by multiple objects).
+     */
+    static MeshChunks* load(void* rawData);
+  };
+
   struct MeshInstance {
-    Mesh *mesh{};
+    MeshChunks *mesh{};
     P64::Object* object{};
 
     fm_vec3_t invScale{};
     fm_quat_t invRot{};
 
+    // world-space bounds, only updated if the object moved
+    fm_vec3_t aabbMin{};
+    fm_vec3_t aabbMax{};
+
+    // transform the cached data above was calculated from
+    fm_quat_t lastRot{};
+    fm_vec3_t lastPos{};
+    fm_vec3_t lastScale{};
+
+    uint8_t maskWrite{0xFF}; // collides with objects whose 'maskRead' matches
+
     fm_vec3_t intoLocalSpace(const fm_vec3_t &p) const;
     fm_vec3_t outOfLocalSpace(const fm_vec3_t &p) const;
-    void update();
+
+    /**
+     * Updates the cached inverse transform and world bounds.
+     * Does nothing if the object's transform didn't change, unless 'force' is set.
+     */
+    void update(bool force = false);
+
+    [[nodiscard]] bool vsAABB(const fm_vec3_t &min, const fm_vec3_t &max) const {
+      return min.x <= aabbMax.x && max.x >= aabbMin.x
+          && min.y <= aabbMax.y && max.y >= aabbMin.y
+          && min.z <= aabbMax.z && max.z >= aabbMin.z;
+    }
   };
 }
@@ -6,7 +6,6 @@
 
 #include "mesh.h"
 #include "shapes.h"
-#include <set>
 #include <vector>
 
 namespace P64::Coll
@@ -15,8 +14,24 @@ namespace P64::Coll
     private:
       constexpr static uint32_t VOID_SPHERE_COUNT = 2;
 
-      std::set<MeshInstance*> meshes{};
-      std::vector<BCS*> collBCS{};
+      std::vector<MeshInstance*> meshes{};
+      struct MeshTriRange {
+        AABB aabb{}; // local-space volume the triangles were queried with
+        uint32_t start{};
+        uint32_t end{};
+      };
+
+      // chunk of a mesh instance, overlapping the movement checked in 'vsBCS'
+      struct MeshCandidate {
+        MeshInstance *inst{};
+        const Mesh *mesh{};
+      };
+
+      // scratch buffers for 'vsBCS', kept to avoid allocations
+      std::vector<MeshCandidate> meshCandidates{};
+      std::vector<MeshTriRange> meshTriRanges{};
+      std::vector<Triangle> triCache{};
+      std::vector<BCS*> collBCS{}; // kept sorted by min. X for the broadphase
 
       CollInfo vsBCS(BCS &bcs, const fm_vec3_t &velocity, float deltaTime);
 
@@ -25,13 +40,36 @@ namespace P64::Coll
       uint64_t ticksBVH{0};
       uint64_t raycastCount{0};
 
+      // per-frame query metrics, shown in the debug overlay
+      uint32_t bvhQueryCount{0};
+      uint32_t bvhNodeCount{0};
+      uint32_t triTestCount{0};
+      uint32_t pairCount{0}; // pairs of objects overlapping in the broadphase
+      uint32_t pairTestCount{0}; // pairs with matching masks, tested for an actual collision
+
+      void resetMetrics() {
+        ticks = 0;
+        ticksBVH = 0;
+        raycastCount = 0;
+        bvhQueryCount = 0;
+        bvhNodeCount = 0;
+        triTestCount = 0;
+        pairCount = 0;
+        pairTestCount = 0;
+      }
+
       void registerMesh(MeshInstance *mesh) {
-        mesh->update();
-        meshes.insert(mesh);
+        mesh->update(true);
+        for(auto m : meshes) {
+          if(m == mesh)return;
+        }
+        meshes.push_back(mesh);
       }
 
       void unregisterMesh(MeshInstance *mesh) {
-        meshes.erase(mesh);
+        for(auto it = meshes.begin(); it != meshes.end(); ++it) {
+          if(*it == mesh)return (void)meshes.erase(it);
+        }
       }
 
       void registerBCS(BCS *bcs) {
@@ -30,6 +30,14 @@ namespace P64::Coll
     bool vsAABB(const AABB &other) const;
     bool vsRay(const fm_vec3_t &pos, const fm_vec3_t &dir) const;
     bool vsPoint(const IVec3 &pos) const;
+
+    /**
+     * Distance along the ray until it enters the box (0 if it starts inside), or -1 if missed.
+     * @param invDir inverse ray direction, see 'getInvDir'
+     */
+    float rayDist(const fm_vec3_t &pos, const fm_vec3_t &invDir) const;
+
+    static fm_vec3_t getInvDir(const fm_vec3_t &dir);
   };
   static_assert(sizeof(AABB) == (6 * sizeof(int16_t)));
 
@@ -111,7 +119,7 @@ namespace P64::Coll
   struct Triangle
   {
     fm_vec3_t normal{};
-    fm_vec3_t* v[3]{};
+    fm_vec3_t v[3]{};
     AABB aabb{};
   };
 
@@ -0,0 +1,96 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <libdragon.h>
+#include <vector>
+
+#include "lib/types.h"
+
+namespace P64::Mem
+{
+  /**
+   * Allocator for memory that lives at most as long as a scene (objects + components).
+   * Memory is taken from a few large chunks instead of one heap allocation per object,
+   * and freed all at once when the pool is destroyed (or 'freeAll' is called).
+   *
+   * Freed blocks are kept in free-lists per size-class (16-byte steps),
+   * so objects spawned/removed at runtime reuse memory without touching the heap.
+   * Blocks above the largest size-class are allocated from the heap directly.
+   *
+   * Returned pointers are 8-byte aligned, a small header in front of each block holds its size.
+   */
+  class ObjectPool
+  {
+    public:
+      struct Stats
+      {
+        uint32_t bytesReserved{}; // chunks + large blocks taken from the heap
+        uint32_t bytesUsed{}; // live blocks (incl. headers)
+        uint32_t bytesFree{}; // blocks sitting in the free-lists
+        uint32_t allocCount{}; // live blocks
+      };
+
+    private:
+      constexpr static uint32_t CHUNK_SIZE = 1024 * 16;
+      constexpr static uint32_t BLOCK_ALIGN = 16;
+      constexpr static uint32_t CLASS_COUNT = 32;
+      constexpr static uint32_t MAX_CLASS_SIZE = CLASS_COUNT * BLOCK_ALIGN;
+
+      struct FreeBlock {
+        FreeBlock *next;
+      };
+
+      std::vector<void*> chunks{};
+      std::vector<void*> largeBlocks{};
+      FreeBlock* freeLists[CLASS_COUNT]{};
+      char* chunkPtr{nullptr};
+      char* chunkEnd{nullptr};
+      Stats stats{};
+
+      void pushFree(void* block, uint32_t blockSize);
+      void newChunk(uint32_t size);
+
+    public:
+      ObjectPool() = default;
+      ~ObjectPool() { freeAll(); }
+
+      CLASS_NO_COPY_MOVE(ObjectPool);
+
+      /**
+       * Size a call to 'alloc' would take from the pool's chunks, including the header.
+       * Returns 0 if the size is too large and would be allocated from the heap directly.
+       */
+      constexpr static uint32_t getPooledSize(uint32_t size) {
+        uint32_t blockSize = (size + 8 /* header */ + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1);
+        return blockSize > MAX_CLASS_SIZE ? 0 : blockSize;
+      }
+
+      /**
+       * Makes sure the next 'bytes' (see 'getPooledSize') can be allocated without further heap allocations.
+       * Used to allocate a whole scene in one go if the total size is known upfront.
+       */
+      void reserve(uint32_t bytes);
+
+      /**
+       * Allocates a block of at least 'size' bytes.
+       * Memory is NOT cleared.
+       */
+      void* alloc(uint32_t size);
+
+      /**
+       * Returns a block to the pool, it will be reused by the next 'alloc' of a similar size.
+       * NOP for nullptr.
+       */
+      void release(void* ptr);
+
+      /**
+       * Frees all memory of the pool at once.
+       * Any pointer previously returned by 'alloc' becomes invalid, destructors are NOT called.
+       */
+      void freeAll();
+
+      [[nodiscard]] const Stats& getStats() const { return stats; }
+  };
+}
@@ -30,8 +30,13 @@ namespace P64
     FuncOnEvent onEvent{};
     FuncOnColl onColl{};
     FuncGetAllocSize getAllocSize{};
+    const char* name{};
   };
 
   constexpr uint32_t COMP_TABLE_SIZE = 16;
   extern const ComponentDef COMP_TABLE[COMP_TABLE_SIZE];
+
+  // order in which component types are updated/drawn by the scene, matches the priority used in the editor
+  constexpr uint32_t COMP_DISPATCH_COUNT = 11;
+  extern const uint8_t COMP_DISPATCH_ORDER[COMP_DISPATCH_COUNT];
 }
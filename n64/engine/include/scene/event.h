@@ -4,10 +4,14 @@
 */
 #pragma once
 #include <libdragon.h>
+#include <vector>
 
 namespace P64
 {
-  constexpr uint32_t MAX_EVENT_COUNT = 128;
+  // upper limit of events queued per frame, anything above is dropped (e.g. objects endlessly replying to each other)
+  constexpr uint32_t MAX_EVENT_COUNT = 2048;
+  // normal priority events delivered per frame, the rest is delivered in the next frame(s)
+  constexpr uint32_t EVENT_BUDGET = 256;
 
   constexpr uint16_t EVENT_TYPE_ENABLE = 0xFFFF;
   constexpr uint16_t EVENT_TYPE_DISABLE = 0xFFFE;
@@ -16,6 +20,19 @@ namespace P64
   constexpr uint16_t EVENT_TYPE_CUSTOM_START = 0x0000;
   constexpr uint16_t EVENT_TYPE_CUSTOM_END   = 0xF000;
 
+  enum class EventTarget : uint8_t
+  {
+    OBJECT, // object with the target ID
+    CHILDREN, // all direct children of the target ID
+    BROADCAST, // all objects in the scene, target ID is ignored
+  };
+
+  enum class EventPrio : uint8_t
+  {
+    NORMAL, // delivered in order, within the per-frame budget
+    HIGH, // delivered before any normal event, ignores the budget
+  };
+
   struct ObjectEvent
   {
     uint16_t senderId{};
@@ -27,28 +44,33 @@ namespace P64
   {
     ObjectEvent event{};
     uint16_t targetId{};
+    EventTarget target{};
+    EventPrio prio{};
   };
 
   struct ObjectEventQueue
   {
-    ObjectEventWrapper events[MAX_EVENT_COUNT]{};
-    uint32_t eventCount{0};
-
-    void add(uint16_t targetId, uint16_t senderId, uint16_t type, uint32_t value) {
-      if (eventCount < MAX_EVENT_COUNT) {
-        events[eventCount].targetId = targetId;
-        events[eventCount].event =
-        {
-          .senderId = senderId,
-          .type = type,
-          .value = value
-        };
-        eventCount++;
+    std::vector<ObjectEventWrapper> events{};
+    uint32_t highPrioCount{0};
+    uint32_t droppedCount{0}; // events dropped since the last 'clear'
+
+    ObjectEventQueue() {
+      events.reserve(128);
+    }
+
+    void add(const ObjectEventWrapper &ev) {
+      if(events.size() >= MAX_EVENT_COUNT) {
+        ++droppedCount;
+        return;
       }
+      events.push_back(ev);
+      if(ev.prio == EventPrio::HIGH)++highPrioCount;
     }
 
     void clear() {
-      eventCount = 0;
+      events.clear();
+      highPrioCount = 0;
+      droppedCount = 0;
     }
   };
 }
\ No newline at end of file
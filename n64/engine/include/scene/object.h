@@ -43,6 +43,9 @@ namespace P64
       fm_vec3_t pos{};
       fm_vec3_t scale{};
 
+      // next object with the same parent, see 'Scene::iterObjectChildren'
+      Object* nextSibling{nullptr};
+
       // component references, this is then also followed by a buffer for the actual data
       // the object allocation logic keeps extra space to fit everything
 
@@ -15,6 +15,7 @@ namespace P64::ObjectFlags
   constexpr uint16_t HAS_CHILDREN   = 1 << 2; // true if object has children (aka other objects list this as their parent ID)
   constexpr uint16_t PENDING_REMOVE = 1 << 4; // flagged for removal at the end of the frame
   constexpr uint16_t IS_CULLED      = 1 << 5; // if true, object is not drawn this frame (usually set by culling logic)
+  constexpr uint16_t HAS_EVENTS     = 1 << 6; // true if any component handles events, otherwise events are skipped
 
   constexpr uint16_t ACTIVE = SELF_ACTIVE | PARENTS_ACTIVE;
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <libdragon.h>
+#include <array>
+
+#include "lib/types.h"
+
+namespace P64
+{
+  class Object;
+
+  /**
+   * Lookup table covering the full 16-bit object ID space,
+   * plus a list of direct children for each ID (children of ID 0 are the root objects).
+   *
+   * IDs are split into pages of 256 entries, which are only allocated once an ID in them is used.
+   * Children are linked through 'Object::nextSibling' and kept in the order they were added.
+   */
+  class ObjectTable
+  {
+    private:
+      constexpr static uint32_t PAGE_SIZE = 256;
+      constexpr static uint32_t PAGE_COUNT = 0x10000 / PAGE_SIZE;
+
+      struct Entry {
+        Object* obj;
+        Object* firstChild;
+        Object* lastChild;
+      };
+
+      std::array<Entry*, PAGE_COUNT> pages{};
+
+      Entry& getOrAllocEntry(uint16_t id);
+
+      [[nodiscard]] const Entry* getEntry(uint16_t id) const {
+        auto page = pages[id / PAGE_SIZE];
+        return page ? &page[id % PAGE_SIZE] : nullptr;
+      }
+
+    public:
+      ObjectTable() = default;
+      ~ObjectTable() { clear(); }
+
+      CLASS_NO_COPY_MOVE(ObjectTable);
+
+      /**
+       * Registers an object under its ID, and appends it to the children of its parent ('Object::group').
+       * The ID must not be in use already.
+       */
+      void add(Object &obj);
+
+      /**
+       * Removes the object from the lookup and the child list of its parent.
+       * Children of the object itself stay registered under its ID.
+       */
+      void remove(Object &obj);
+
+      /**
+       * Frees all pages, any object still registered is forgotten (but not deleted).
+       */
+      void clear();
+
+      [[nodiscard]] Object* get(uint16_t id) const {
+        auto entry = getEntry(id);
+        return entry ? entry->obj : nullptr;
+      }
+
+      /**
+       * First direct child of the given ID, or nullptr if it has none.
+       * Further children can be reached via 'Object::nextSibling'.
+       */
+      [[nodiscard]] Object* getFirstChild(uint16_t parentId) const {
+        auto entry = getEntry(parentId);
+        return entry ? entry->firstChild : nullptr;
+      }
+  };
+}
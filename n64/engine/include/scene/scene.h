@@ -4,12 +4,16 @@
 */
 #pragma once
 #include <libdragon.h>
+#include <array>
 #include <vector>
 
+#include "componentTable.h"
 #include "event.h"
 #include "lighting.h"
 #include "object.h"
+#include "objectTable.h"
 #include "collision/scene.h"
+#include "lib/objectPool.h"
 #include "lib/types.h"
 #include "renderer/drawLayer.h"
 #include "renderer/pipeline.h"
@@ -79,13 +83,24 @@ namespace P64
 
       RenderPipeline *renderPipeline{nullptr};
 
-      // @TODO: avoid vector + fragmented alloc
+      // memory for objects and their components, freed all at once with the scene
+      Mem::ObjectPool objectPool{};
+
+      // @TODO: avoid vector
       std::vector<Object*> objects{};
       std::vector<PrefabParams> objectsToAdd{};
 
-      // create a direct lookup table for the first few IDs
-      // most scene probably don't exceed that much anyway
-      std::array<Object*, 128> idLookup{};
+      struct CompEntry {
+        Object* obj;
+        void* data;
+      };
+
+      // components of all objects grouped by type (in load order), used to update/draw one type at a time
+      std::array<std::vector<CompEntry>, COMP_TABLE_SIZE> compLists{};
+
+      // ID to object lookup + children of each object
+      ObjectTable objectTable{};
+      uint16_t nextId{0xFF}; // last ID handed out to a spawned object
 
       Coll::Scene collScene{};
       std::vector<Object*> pendingObjDelete{};
@@ -99,8 +114,23 @@ namespace P64
       SceneConf conf{};
       uint16_t id;
 
+      // memory layout of an object entry, see 'getObjectLayout'
+      struct ObjectLayout {
+        uint32_t allocSize; // object + comp. table + comp. data
+        uint32_t offsetData; // offset of the comp. data, relative to the comp. table
+        uint32_t entrySize; // size of the entry in the object file
+        uint32_t compSizeIdx; // first component in 'compSizes'
+      };
+      // aligned data size of each component, filled by 'getObjectLayout', kept to avoid allocations
+      std::vector<uint32_t> compSizes{};
+
       void loadSceneConfig();
+      ObjectLayout getObjectLayout(const uint8_t* objFile);
+      Object* loadObject(const uint8_t* objFile, const ObjectLayout &layout, std::function<void(Object&)> callback = {});
       Object* loadObject(uint8_t* &objFile, std::function<void(Object&)> callback = {});
+      void unregisterComponents(Object &obj);
+      uint16_t allocObjectId();
+      void dispatchEvents();
       void loadScene();
 
     public:
@@ -108,6 +138,12 @@ namespace P64
       uint64_t ticksGlobalUpdate{0};
       uint64_t ticksGlobalDraw{0};
       uint64_t ticksDraw{0};
+      // per component type (see 'COMP_TABLE'), time spent in update/draw this frame
+      std::array<uint32_t, COMP_TABLE_SIZE> ticksCompUpdate{};
+      std::array<uint32_t, COMP_TABLE_SIZE> ticksCompDraw{};
+      uint32_t eventCount{0}; // events delivered this frame
+      uint32_t eventDeferredCount{0}; // events left for the next frame (over budget)
+      uint32_t eventDroppedCount{0}; // events dropped since the scene was loaded (queue full)
 
       explicit Scene(uint16_t sceneId, Scene** ref);
       ~Scene();
@@ -125,8 +161,42 @@ namespace P64
 
       void onObjectCollision(const Coll::CollEvent &event);
 
-      void sendEvent(uint16_t targetId, uint16_t senderId, uint16_t type, uint32_t value) {
-        eventQueue[eventQueueIdx].add(targetId, senderId, type, value);
+      /**
+       * Queues an event for an object, delivered at the end of the frame
+       * to all components of the object that handle events.
+       * Events sent while events are delivered arrive in the next frame.
+       *
+       * @param targetId object receiving the event
+       * @param senderId object sending the event (or 0)
+       * @param type event type, see 'EVENT_TYPE_CUSTOM_START'
+       * @param value custom value
+       * @param prio high priority events are delivered first, and are not limited by 'EVENT_BUDGET'
+       */
+      void sendEvent(uint16_t targetId, uint16_t senderId, uint16_t type, uint32_t value, EventPrio prio = EventPrio::NORMAL) {
+        eventQueue[eventQueueIdx].add({
+          .event = {.senderId = senderId, .type = type, .value = value},
+          .targetId = targetId, .target = EventTarget::OBJECT, .prio = prio
+        });
+      }
+
+      /**
+       * Same as 'sendEvent', but sends the event to all direct children of the given object.
+       */
+      void sendEventToChildren(uint16_t parentId, uint16_t senderId, uint16_t type, uint32_t value, EventPrio prio = EventPrio::NORMAL) {
+        eventQueue[eventQueueIdx].add({
+          .event = {.senderId = senderId, .type = type, .value = value},
+          .targetId = parentId, .target = EventTarget::CHILDREN, .prio = prio
+        });
+      }
+
+      /**
+       * Same as 'sendEvent', but sends the event to every object in the scene.
+       */
+      void broadcastEvent(uint16_t senderId, uint16_t type, uint32_t value, EventPrio prio = EventPrio::NORMAL) {
+        eventQueue[eventQueueIdx].add({
+          .event = {.senderId = senderId, .type = type, .value = value},
+          .targetId = 0, .target = EventTarget::BROADCAST, .prio = prio
+        });
       }
 
       void addCamera(Camera *cam) {
@@ -179,9 +249,13 @@ namespace P64
 
       void removeObject(Object &obj);
 
-      Object* getObjectById(uint16_t objId) const;
+      [[nodiscard]] Object* getObjectById(uint16_t objId) const {
+        return objectTable.get(objId);
+      }
 
       uint32_t getObjectCount() const { return objects.size(); }
+      uint32_t getComponentCount(uint8_t type) const { return compLists[type].size(); }
+      [[nodiscard]] const Mem::ObjectPool::Stats& getObjectPoolStats() const { return objectPool.getStats(); }
 
       /**
        * Iterates over all direct children of the given parent object ID.
@@ -197,8 +271,7 @@ namespace P64
        */
       template<typename F>
       void iterObjectChildren(uint16_t parentId, F&& f) const {
-        for (auto o : objects) {
-          if(o->group != parentId)continue;
+        for(auto o = objectTable.getFirstChild(parentId); o; o = o->nextSibling) {
           f(o);
         }
       }
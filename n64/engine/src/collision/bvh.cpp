@@ -5,65 +5,45 @@
 #include "collision/bvh.h"
 // #include "../debug/debugDraw.h"
 
-namespace {
-  const int16_t *ctxData;
-  const P64::Coll::AABB *ctxAABB;
-  const fm_vec3_t *ctxRayPos;
-  const fm_vec3_t *ctxRayDir;
-  P64::Coll::BVHResult *ctxRes;
+bool P64::Coll::BVH::vsAABB(const AABB &aabb, BVHResult &res) const
+{
+  const int16_t *data = getData();
+  res.count = 0;
+  if(nodeCount == 0)res.stackSize = 0;
 
-  void queryNodeAABB(const P64::Coll::BVHNode *node)
+  while(res.stackSize != 0)
   {
-    if(!node->aabb.vsAABB(*ctxAABB))return;
+    const int idx = res.stack[res.stackSize-1];
+    const BVHNode &node = nodes[idx];
 
-    int dataCount = node->value & 0b1111;
-    int offset = (int16_t)node->value >> 4;
-
-    if(dataCount == 0) {
-      queryNodeAABB(&node[offset]);
-      queryNodeAABB(&node[offset + 1]);
-      return;
-    }
-
-    int offsetEnd = offset + dataCount;
-    while(offset < offsetEnd && ctxRes->count < P64::Coll::MAX_RESULT_COUNT) {
-      ctxRes->triIndex[ctxRes->count++] = ctxData[offset++];
+    ++res.nodesVisited;
+    if(!node.aabb.vsAABB(aabb)) {
+      --res.stackSize;
+      continue;
     }
-  }
 
-  void queryNodeRaycast(const P64::Coll::BVHNode *node)
-  {
-    if(!node->aabb.vsRay(*ctxRayPos, *ctxRayDir))return;
+    int leafCount = node.getDataCount();
+    int offset = node.getOffset();
 
-    int dataCount = node->value & 0b1111;
-    int offset = (int16_t)node->value >> 4;
+    if(leafCount != 0) {
+      // leaf doesn't fit anymore, keep it on the stack for the next call
+      if(res.count + leafCount > MAX_RESULT_COUNT)return false;
+      --res.stackSize;
 
-    if(dataCount == 0) {
-      queryNodeRaycast(&node[offset]);
-      queryNodeRaycast(&node[offset + 1]);
-      return;
+      for(int i=offset; i < offset+leafCount; ++i) {
+        res.triIndex[res.count++] = data[i];
+      }
+      continue;
     }
 
-    int offsetEnd = offset + dataCount;
-    while(offset < offsetEnd && ctxRes->count < P64::Coll::MAX_RESULT_COUNT) {
-      ctxRes->triIndex[ctxRes->count++] = ctxData[offset++];
+    // push in reverse, so the first child is checked next
+    --res.stackSize;
+    if(res.stackSize + 2 > MAX_STACK_SIZE) {
+      res.overflow = true;
+      continue;
     }
+    res.stack[res.stackSize++] = idx + offset + 1;
+    res.stack[res.stackSize++] = idx + offset;
   }
+  return true;
 }
-
-void P64::Coll::BVH::vsAABB(const AABB &aabb, BVHResult &res) const {
-  ctxData = (int16_t*)&nodes[nodeCount]; // data starts right after nodes;
-  ctxAABB = &aabb;
-  ctxRes = &res;
-  queryNodeAABB(nodes);
-}
-
-void P64::Coll::BVH::raycast(const fm_vec3_t &pos, const fm_vec3_t &dir, BVHResult &res) const {
-  ctxData = (int16_t*)&nodes[nodeCount]; // data starts right after nodes;
-  ctxRayPos = &pos;
-  ctxRayDir = &dir;
-  ctxRes = &res;
-  queryNodeRaycast(nodes);
-}
-
-
@@ -108,9 +108,9 @@ namespace {
   {
     const auto &bcsPos = sphere.center;
 
-    const auto &vert0 = *face.v[0];
-    const auto &vert1 = *face.v[1];
-    const auto &vert2 = *face.v[2];
+    const auto &vert0 = face.v[0];
+    const auto &vert1 = face.v[1];
+    const auto &vert2 = face.v[2];
 
     // Face tests
     float planeDist = pointPlaneDistance(bcsPos, vert0, face.normal);
@@ -172,9 +172,9 @@ namespace {
   P64::Coll::CollInfo triVsBox(const P64::Coll::BCS &box, const P64::Coll::Triangle &face)
   {
     // move triangle to origin
-    const auto v0 = *face.v[0] - box.center;
-    const auto v1 = *face.v[1] - box.center;
-    const auto v2 = *face.v[2] - box.center;
+    const auto v0 = face.v[0] - box.center;
+    const auto v1 = face.v[1] - box.center;
+    const auto v2 = face.v[2] - box.center;
 
     const auto edge0 = v1 - v0;
     const auto edge1 = v2 - v1;
@@ -301,9 +301,9 @@ P64::Coll::CollInfo P64::Coll::Mesh::vsBox(const P64::Coll::BCS &box, const P64:
 
 Coll::RaycastRes Coll::Mesh::vsRay(const fm_vec3_t &rayStart, const fm_vec3_t &dir, const P64::Coll::Triangle &face) const
 {
-  const auto &vert0 = *face.v[0];
-  const auto &vert1 = *face.v[1];
-  const auto &vert2 = *face.v[2];
+  const auto &vert0 = face.v[0];
+  const auto &vert1 = face.v[1];
+  const auto &vert2 = face.v[2];
 
   // In most cases we want floor ray-casting, which can be  transformed into a 2D case.
   // Otherwise, fallback to a full 3D intersection test.
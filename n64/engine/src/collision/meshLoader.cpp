@@ -36,7 +36,7 @@ namespace {
 
   [[maybe_unused]] static void debugDrawBVTree(const P64::Coll::BVH *bvh) {
     const int16_t *data = (int16_t*)&bvh->nodes[bvh->nodeCount]; // data starts right after nodes
-    uint32_t basePtr = (uint32_t)(char*)bvh;
+    uint32_t basePtr = (uint32_t)(uintptr_t)bvh;
     debugDrawBVTreeNode(data, basePtr, bvh->nodes, 0);
   }
 }
@@ -51,13 +51,13 @@ P64::Coll::Mesh* P64::Coll::Mesh::load(void* rawData)
 
   data += mesh->triCount * sizeof(int16_t) * 3;
   data = align(data, 4);
-  mesh->normals = (IVec3*)data;
+  mesh->normals = (uint16_t*)data;
 
-  data += mesh->triCount * sizeof(IVec3);
+  data += mesh->triCount * sizeof(uint16_t);
   data = align(data, 4);
-  mesh->verts = (fm_vec3_t *)data;
+  mesh->verts = (IVec3*)data;
 
-  data += mesh->vertCount * sizeof(fm_vec3_t);
+  data += mesh->vertCount * sizeof(IVec3);
   data = align(data, 4);
   mesh->bvh = (BVH*)data;
 
@@ -66,3 +66,30 @@ P64::Coll::Mesh* P64::Coll::Mesh::load(void* rawData)
 
   return mesh;
 }
+
+fm_vec3_t P64::Coll::Mesh::getNormal(uint32_t triIdx) const
+{
+  // octahedral encoding, 8-bit per axis, see 'encodeNormalOct' in the editor
+  uint16_t packed = normals[triIdx];
+  float x = (float)(int8_t)(packed & 0xFF) * (1.0f / 127.0f);
+  float y = (float)(int8_t)(packed >> 8) * (1.0f / 127.0f);
+  float z = 1.0f - fabsf(x) - fabsf(y);
+  if(z < 0.0f) {
+    float oldX = x;
+    x = (1.0f - fabsf(y)) * (oldX >= 0.0f ? 1.0f : -1.0f);
+    y = (1.0f - fabsf(oldX)) * (y >= 0.0f ? 1.0f : -1.0f);
+  }
+
+  fm_vec3_t res{{x, y, z}};
+  fm_vec3_norm(&res, &res);
+  return res;
+}
+
+P64::Coll::MeshChunks* P64::Coll::MeshChunks::load(void* rawData)
+{
+  auto chunks = (MeshChunks*)rawData;
+  for(uint32_t c=0; c<chunks->chunkCount; ++c) {
+    Mesh::load((char*)rawData + chunks->chunks[c].offset);
+  }
+  return chunks;
+}
@@ -16,15 +16,46 @@ namespace
   constexpr float MIN_PENETRATION = 0.00004f;
   constexpr float FLOOR_ANGLE = 0.4f;
 
-  constexpr bool isFloor(const P64::Coll::IVec3 &normal) {
-    return normal.v[1] > (int16_t)(0x7FFF * FLOOR_ANGLE);
-  }
   constexpr bool isFloor(const fm_vec3_t &normal) {
     return normal.v[1] > FLOOR_ANGLE;
   }
   constexpr bool isFloor(float normY) {
     return normY > FLOOR_ANGLE;
   }
+
+  P64::Coll::AABB getTriangleAABB(const P64::Coll::Triangle &tri)
+  {
+    P64::Coll::AABB res{};
+    for(int i=0; i<3; ++i) {
+      float vMin = fminf(tri.v[0].v[i], fminf(tri.v[1].v[i], tri.v[2].v[i]));
+      float vMax = fmaxf(tri.v[0].v[i], fmaxf(tri.v[1].v[i], tri.v[2].v[i]));
+      // same padding as the BVH, to not be stricter than its leaves
+      res.min.v[i] = (int16_t)floorf(vMin) - 1;
+      res.max.v[i] = (int16_t)ceilf(vMax) + 1;
+    }
+    return res;
+  }
+
+  bool containsAABB(const P64::Coll::AABB &outer, const P64::Coll::AABB &inner)
+  {
+    for(int i=0; i<3; ++i) {
+      if(inner.min.v[i] < outer.min.v[i] || inner.max.v[i] > outer.max.v[i])return false;
+    }
+    return true;
+  }
+
+  // bounds used for the broadphase, spheres only use the Y extend as their radius
+  fm_vec3_t getBroadMin(const P64::Coll::BCS &bcs) {
+    if(bcs.flags & P64::Coll::BCSFlags::SHAPE_BOX)return bcs.getMinAABB();
+    float r = bcs.getRadius();
+    return bcs.center - fm_vec3_t{r, r, r};
+  }
+
+  fm_vec3_t getBroadMax(const P64::Coll::BCS &bcs) {
+    if(bcs.flags & P64::Coll::BCSFlags::SHAPE_BOX)return bcs.getMaxAABB();
+    float r = bcs.getRadius();
+    return bcs.center + fm_vec3_t{r, r, r};
+  }
 }
 
 P64::Coll::CollInfo P64::Coll::Scene::vsBCS(BCS &bcs, const fm_vec3_t &velocity, float deltaTime) {
@@ -40,43 +71,117 @@ P64::Coll::CollInfo P64::Coll::Scene::vsBCS(BCS &bcs, const fm_vec3_t &velocity,
   P64::Coll::CollInfo res{};
   P64::Coll::BVHResult bvhRes{};
 
+  // only meshes overlapping the entire movement of this step are checked,
+  // with some extra space since resolving collisions can push the shape around too
+  auto extend = isBox ? bcs.halfExtend : fm_vec3_t{bcs.getRadius(), bcs.getRadius(), bcs.getRadius()};
+  extend = extend * 2.0f;
+  auto posEnd = bcs.center + velocity * deltaTime;
+  fm_vec3_t sweepMin{
+    fminf(bcs.center.x, posEnd.x) - extend.x,
+    fminf(bcs.center.y, posEnd.y) - extend.y,
+    fminf(bcs.center.z, posEnd.z) - extend.z,
+  };
+  fm_vec3_t sweepMax{
+    fmaxf(bcs.center.x, posEnd.x) + extend.x,
+    fmaxf(bcs.center.y, posEnd.y) + extend.y,
+    fmaxf(bcs.center.z, posEnd.z) + extend.z,
+  };
+
+  // Query each BVH once with the whole movement, and re-use the triangles for all steps.
+  // Should a step leave that volume (e.g. pushed away by a collision), the BVH is queried again.
+  meshCandidates.clear();
+  meshTriRanges.clear();
+  triCache.clear();
+
+  auto queryMesh = [&](uint32_t m, const AABB &aabb)
+  {
+    auto &mesh = *meshCandidates[m].mesh;
+    auto &range = meshTriRanges[m];
+    range.aabb = aabb;
+    range.start = triCache.size();
+
+    auto ticksBvhStart = get_ticks();
+    bvhRes.reset();
+    do {
+      mesh.bvh->vsAABB(aabb, bvhRes);
+      for(int b=0; b<bvhRes.count; ++b) {
+        auto &tri = triCache.emplace_back();
+        mesh.getTriangle(bvhRes.triIndex[b], tri);
+        tri.aabb = getTriangleAABB(tri);
+      }
+    } while(bvhRes.hasMore());
+    ticksBVH += get_ticks() - ticksBvhStart;
+
+    range.end = triCache.size();
+    ++bvhQueryCount;
+    bvhNodeCount += bvhRes.nodesVisited;
+    if(bvhRes.overflow) {
+      P64::Log::error("BVH too deep, exceeded stack size (%d)\n", P64::Coll::MAX_STACK_SIZE);
+    }
+  };
+
+  for(auto meshInst : meshes) {
+    if(!(bcs.maskRead & meshInst->maskWrite) || !meshInst->vsAABB(sweepMin, sweepMax))continue;
+
+    auto localStart = meshInst->intoLocalSpace(bcs.center);
+    auto localEnd = meshInst->intoLocalSpace(posEnd);
+    // the shape may be rotated in local space, so extend by the largest axis in every direction
+    float extendMax = fmaxf(extend.x, fmaxf(extend.y, extend.z));
+    auto extendLocal = fm_vec3_t{extendMax, extendMax, extendMax} * meshInst->invScale;
+
+    BCS sweep{
+      .center = (localStart + localEnd) * 0.5f,
+      .halfExtend = fm_vec3_t{
+        fabsf(localEnd.x - localStart.x) * 0.5f + fabsf(extendLocal.x),
+        fabsf(localEnd.y - localStart.y) * 0.5f + fabsf(extendLocal.y),
+        fabsf(localEnd.z - localStart.z) * 0.5f + fabsf(extendLocal.z),
+      }
+    };
+    auto sweepAABB = sweep.toAABB();
+
+    // large meshes are split into chunks, only check those overlapping the movement
+    const auto &chunks = *meshInst->mesh;
+    for(uint32_t c=0; c<chunks.chunkCount; ++c) {
+      if(!chunks.chunks[c].aabb.vsAABB(sweepAABB))continue;
+      meshCandidates.push_back({meshInst, &chunks.getMesh(c)});
+      meshTriRanges.emplace_back();
+      queryMesh(meshCandidates.size()-1, sweepAABB);
+    }
+  }
+
   for(int s=0; s<steps; ++s)
   {
     bcs.center = bcs.center + velocityStep;
 
-    for(auto meshInst : meshes)
+    for(uint32_t m=0; m<meshCandidates.size(); ++m)
     {
-      auto &mesh = *meshInst->mesh;
+      auto meshInst = meshCandidates[m].inst;
+      auto &mesh = *meshCandidates[m].mesh;
 
       auto bcsLocal = bcs;
       bcsLocal.center = meshInst->intoLocalSpace(bcs.center);
       bcsLocal.halfExtend *= meshInst->invScale;
 
-      auto ticksBvhStart = get_ticks();
-      bvhRes.reset();
-      mesh.bvh->vsBCS(bcsLocal, bvhRes);
-
-      ticksBVH += get_ticks() - ticksBvhStart;
-      if(bvhRes.count >= P64::Coll::MAX_RESULT_COUNT-1) {
-        P64::Log::error("BVH result count exceeded max limit (%d)\n", bvhRes.count);
+      auto stepAABB = bcsLocal.toAABB();
+      if(!containsAABB(meshTriRanges[m].aabb, stepAABB)) {
+        // re-query for the remaining movement starting here
+        float rest = len * (float)(steps - s) / (float)steps;
+        auto restLocal = fm_vec3_t{rest, rest, rest} * meshInst->invScale;
+        auto query = bcsLocal;
+        query.halfExtend = fm_vec3_t{
+          fabsf(bcsLocal.halfExtend.x) * 2.0f + fabsf(restLocal.x),
+          fabsf(bcsLocal.halfExtend.y) * 2.0f + fabsf(restLocal.y),
+          fabsf(bcsLocal.halfExtend.z) * 2.0f + fabsf(restLocal.z),
+        };
+        queryMesh(m, query.toAABB());
       }
+      const auto &range = meshTriRanges[m];
 
-      for(int b=0; b<bvhRes.count; ++b) {
-        uint32_t t = bvhRes.triIndex[b];
-
-        int idxA = mesh.indices[t*3];
-        int idxB = mesh.indices[t*3+1];
-        int idxC = mesh.indices[t*3+2];
-        auto &norm = mesh.normals[t];
-
-        Triangle tri{
-          .normal = {{
-           (float)norm.v[0] * (1.0f / 32767.0f),
-           (float)norm.v[1] * (1.0f / 32767.0f),
-           (float)norm.v[2] * (1.0f / 32767.0f)
-          }},
-          .v = {&mesh.verts[idxA], &mesh.verts[idxB], &mesh.verts[idxC]}
-        };
+      for(uint32_t t=range.start; t<range.end; ++t)
+      {
+        auto &tri = triCache[t];
+        if(!tri.aabb.vsAABB(stepAABB))continue;
+        ++triTestCount;
 
         auto collInfo = isBox
           ? mesh.vsBox(bcsLocal, tri)
@@ -104,10 +209,10 @@ P64::Coll::CollInfo P64::Coll::Scene::vsBCS(BCS &bcs, const fm_vec3_t &velocity,
 
           bcsLocal.center -= collInfo.penetration;
         }
-      } // BVH res
+      } // triangles
 
       bcs.center = meshInst->outOfLocalSpace(bcsLocal.center);
-    } // meshes
+    } // mesh chunks
   } // steps
 
   return res;
@@ -124,14 +229,50 @@ fm_vec3_t P64::Coll::MeshInstance::outOfLocalSpace(const fm_vec3_t &p) const {
   return object->rot * (p * object->scale) + object->pos;
 }
 
-void P64::Coll::MeshInstance::update()
+void P64::Coll::MeshInstance::update(bool force)
 {
+  const auto &rot = object->rot;
+  const auto &pos = object->pos;
+  const auto &scale = object->scale;
+
+  bool changed = force
+    || pos.x != lastPos.x || pos.y != lastPos.y || pos.z != lastPos.z
+    || scale.x != lastScale.x || scale.y != lastScale.y || scale.z != lastScale.z
+    || rot.v[0] != lastRot.v[0] || rot.v[1] != lastRot.v[1] || rot.v[2] != lastRot.v[2] || rot.v[3] != lastRot.v[3];
+  if(!changed)return;
+
+  lastPos = pos;
+  lastRot = rot;
+  lastScale = scale;
+
   invScale = fm_vec3_t{
-    1.0f / object->scale.x,
-    1.0f / object->scale.y,
-    1.0f / object->scale.z,
+    1.0f / scale.x,
+    1.0f / scale.y,
+    1.0f / scale.z,
   };
-  fm_quat_inverse(&invRot, &object->rot);
+  fm_quat_inverse(&invRot, &rot);
+
+  // world bounds from the corners of the local bounds
+  if(!mesh || mesh->chunkCount == 0) {
+    aabbMin = aabbMax = pos;
+    return;
+  }
+
+  const auto &localAABB = mesh->aabb;
+  for(int i=0; i<8; ++i) {
+    fm_vec3_t corner{
+      (float)((i & 1) ? localAABB.max.v[0] : localAABB.min.v[0]),
+      (float)((i & 2) ? localAABB.max.v[1] : localAABB.min.v[1]),
+      (float)((i & 4) ? localAABB.max.v[2] : localAABB.min.v[2]),
+    };
+    corner = outOfLocalSpace(corner);
+    if(i == 0) {
+      aabbMin = aabbMax = corner;
+      continue;
+    }
+    aabbMin = {fminf(aabbMin.x, corner.x), fminf(aabbMin.y, corner.y), fminf(aabbMin.z, corner.z)};
+    aabbMax = {fmaxf(aabbMax.x, corner.x), fmaxf(aabbMax.y, corner.y), fmaxf(aabbMax.z, corner.z)};
+  }
 }
 
 void P64::Coll::Scene::update(float deltaTime)
@@ -150,12 +291,9 @@ void P64::Coll::Scene::update(float deltaTime)
   for(uint32_t s=0; s < collBCS.size(); ++s) {
     auto &bcsA = collBCS[s];
 
-    // Static/Triangle mesh collision
+    // Static/Triangle mesh collision, read/write masks are checked per mesh in 'vsBCS'
     bool checkColl = bcsA->isSolid() && !bcsA->isFixed();
 
-    // @TODO: use r/w mask
-    //bcsA->maskRead & Mask::TRI_MESH;
-
     if(checkColl) {
       auto res = vsBCS(*bcsA, bcsA->velocity, deltaTime);
       if(res.collCount)
@@ -178,15 +316,41 @@ void P64::Coll::Scene::update(float deltaTime)
         gameScene.onObjectCollision({bcsA, nullptr, nullptr, res.meshInstance});
       }
     }
+  }
+
+  // Dynamic Colliders, broadphase via sweep-and-prune along X.
+  // The list stays sorted across frames, so it's almost sorted already and an insertion-sort is ~O(n)
+  for(uint32_t s=1; s < collBCS.size(); ++s) {
+    auto bcs = collBCS[s];
+    float minX = getBroadMin(*bcs).x;
+    uint32_t s2 = s;
+    for(; s2 > 0 && getBroadMin(*collBCS[s2-1]).x > minX; --s2) {
+      collBCS[s2] = collBCS[s2-1];
+    }
+    collBCS[s2] = bcs;
+  }
+
+  for(uint32_t s=0; s < collBCS.size(); ++s)
+  {
+    auto bcsA = collBCS[s];
+    auto minA = getBroadMin(*bcsA);
+    auto maxA = getBroadMax(*bcsA);
 
-    // Dynamic Colliders
+    // only objects starting before the end of this one can overlap
     for(uint32_t s2=s+1; s2 < collBCS.size(); ++s2)
     {
-      bool maskMatchA = bcsA->maskRead & collBCS[s2]->maskWrite;
-      bool maskMatchB = collBCS[s2]->maskRead & bcsA->maskWrite;
-      if(!maskMatchA && !maskMatchB)continue;
-
       auto bcsB = collBCS[s2];
+      auto minB = getBroadMin(*bcsB);
+      if(minB.x > maxA.x)break;
+
+      auto maxB = getBroadMax(*bcsB);
+      if(minB.y > maxA.y || maxB.y < minA.y || minB.z > maxA.z || maxB.z < minA.z)continue;
+      ++pairCount;
+
+      bool maskMatchA = bcsA->maskRead & bcsB->maskWrite;
+      bool maskMatchB = bcsB->maskRead & bcsA->maskWrite;
+      if(!maskMatchA && !maskMatchB)continue;
+      ++pairTestCount;
 
       bool isBoxA = bcsA->flags & BCSFlags::SHAPE_BOX;
       bool isBoxB = bcsB->flags & BCSFlags::SHAPE_BOX;
@@ -208,9 +372,11 @@ void P64::Coll::Scene::update(float deltaTime)
         gameScene.onObjectCollision({bcsA, bcsB});
       }
     }
+  }
 
-    if(bcsA->isSolid()) {
-      bcsA->obj->pos = bcsA->center - bcsA->parentOffset;
+  for(auto bcs : collBCS) {
+    if(bcs->isSolid()) {
+      bcs->obj->pos = bcs->center - bcs->parentOffset;
     }
   }
   ticks += get_ticks() - ticksStart;
@@ -221,55 +387,62 @@ P64::Coll::RaycastRes P64::Coll::Scene::raycast(const fm_vec3_t &pos, const fm_v
   P64::Coll::RaycastRes res{};
 
   float highestFloor = -99999.0f;
+  float closestDist = 0.0f;
   for(auto meshInst : meshes)
   {
-    auto &mesh = *meshInst->mesh;
+    const auto &chunks = *meshInst->mesh;
     auto posLocal = meshInst->intoLocalSpace(pos);
     auto dirLocal = meshInst->invRot * dir;
-
-    P64::Coll::IVec3 posInt = {
-      .v = {
-        (int16_t)(posLocal.v[0]),
-        (int16_t)(posLocal.v[1]),
-        (int16_t)(posLocal.v[2])
-      }
-    };
+    auto invDirLocal = AABB::getInvDir(dirLocal);
+    float closestLocal = 0.0f;
 
     P64::Coll::BVHResult bvhRes{};
 
     //Debug::drawLine(meshInst->outOfLocalSpace(posLocal), meshInst->outOfLocalSpace(posLocal + dirLocal * 100.0f), color_t{0xFF,0x00,0xFF,0xFF});
 
-    mesh.bvh->raycast(posLocal, dirLocal, bvhRes);
-
-    for(int b=0; b<bvhRes.count; ++b) {
-      uint32_t t = bvhRes.triIndex[b];
-    //for(uint32_t b=0; b<mesh.triCount; ++b) {
-      //uint32_t t = b;
-
-      int idxA = mesh.indices[t*3];
-      int idxB = mesh.indices[t*3+1];
-      int idxC = mesh.indices[t*3+2];
-      auto &norm = mesh.normals[t];
-
-      Triangle tri{
-        .normal = {{
-         (float)norm.v[0] * (1.0f/32767.0f),
-         (float)norm.v[1] * (1.0f/32767.0f),
-         (float)norm.v[2] * (1.0f/32767.0f)
-        }},
-        .v = {&mesh.verts[idxA], &mesh.verts[idxB], &mesh.verts[idxC]}
-      };
-
-      auto collInfo = mesh.vsRay(posLocal, dirLocal, tri);
-      if(collInfo.hasResult())
+    RaycastRes hitLocal{};
+    for(uint32_t c=0; c<chunks.chunkCount; ++c)
+    {
+      // skip chunks the ray misses, or which start behind the closest hit so far
+      float chunkDist = chunks.chunks[c].aabb.rayDist(posLocal, invDirLocal);
+      if(chunkDist < 0.0f || (hitLocal.hasResult() && chunkDist > closestLocal))continue;
+
+      // BVH is traversed front-to-back, with the first hit only closer triangles get tested
+      const auto &mesh = chunks.getMesh(c);
+      mesh.bvh->raycast(posLocal, dirLocal, bvhRes, [&](uint32_t t) -> float
       {
-        res.flags |= collInfo.flags;
-        res.hitPos = meshInst->outOfLocalSpace(collInfo.hitPos);
-        //if(res.hitPos.v[1] > highestFloor)
-        {
-          res.normal = meshInst->object->rot * collInfo.normal;
-          highestFloor = res.hitPos.v[1];
+        ++triTestCount;
+        Triangle tri;
+        mesh.getTriangle(t, tri);
+
+        auto collInfo = mesh.vsRay(posLocal, dirLocal, tri);
+        if(!collInfo.hasResult())return -1.0f;
+
+        auto diff = collInfo.hitPos - posLocal;
+        float dist = t3d_vec3_dot(&diff, &dirLocal) / t3d_vec3_dot(&dirLocal, &dirLocal);
+        if(!hitLocal.hasResult() || dist < closestLocal) {
+          hitLocal = collInfo;
+          closestLocal = dist;
         }
+        return dist;
+      });
+
+      ++bvhQueryCount;
+      bvhNodeCount += bvhRes.nodesVisited;
+    }
+
+    if(hitLocal.hasResult())
+    {
+      auto hitPos = meshInst->outOfLocalSpace(hitLocal.hitPos);
+      auto diff = hitPos - pos;
+      float dist = t3d_vec3_dot(&diff, &dir);
+      // closest hit across all meshes
+      if(!res.hasResult() || dist < closestDist) {
+        closestDist = dist;
+        res.flags |= hitLocal.flags;
+        res.hitPos = hitPos;
+        res.normal = meshInst->object->rot * hitLocal.normal;
+        highestFloor = res.hitPos.v[1];
       }
     }
   }
@@ -298,23 +471,25 @@ void P64::Coll::Scene::debugDraw(bool showMesh, bool showSpheres)
 {
   if(showMesh) {
     for(const auto &meshInst : meshes) {
-      auto &mesh = *meshInst->mesh;
-      for(uint32_t t=0; t<mesh.triCount; ++t) {
-        int idxA = mesh.indices[t*3];
-        int idxB = mesh.indices[t*3+1];
-        int idxC = mesh.indices[t*3+2];
-        auto v0 = (mesh.verts[idxA] * meshInst->object->scale + meshInst->object->pos);
-        auto v1 = (mesh.verts[idxB] * meshInst->object->scale + meshInst->object->pos);
-        auto v2 = (mesh.verts[idxC] * meshInst->object->scale + meshInst->object->pos);
-
-        if(mesh.normals[t].v[2] < 0)continue;
-        auto color = isFloor(mesh.normals[t])
-          ? color_t{0x00, 0xAA, 0xEE, 0xFF}
-          : color_t{0x00, 0xEE, 0x42, 0xFF};
-
-        Debug::drawLine(v0, v1, color);
-        Debug::drawLine(v1, v2, color);
-        Debug::drawLine(v2, v0, color);
+      const auto &chunks = *meshInst->mesh;
+      for(uint32_t c=0; c<chunks.chunkCount; ++c) {
+        const auto &mesh = chunks.getMesh(c);
+        for(uint32_t t=0; t<mesh.triCount; ++t) {
+          Triangle tri;
+          mesh.getTriangle(t, tri);
+          auto v0 = (tri.v[0] * meshInst->object->scale + meshInst->object->pos);
+          auto v1 = (tri.v[1] * meshInst->object->scale + meshInst->object->pos);
+          auto v2 = (tri.v[2] * meshInst->object->scale + meshInst->object->pos);
+
+          if(tri.normal.v[2] < 0.0f)continue;
+          auto color = isFloor(tri.normal)
+            ? color_t{0x00, 0xAA, 0xEE, 0xFF}
+            : color_t{0x00, 0xEE, 0x42, 0xFF};
+
+          Debug::drawLine(v0, v1, color);
+          Debug::drawLine(v1, v2, color);
+          Debug::drawLine(v2, v0, color);
+        }
       }
     }
   }
@@ -88,6 +88,7 @@ namespace {
   bool matrixDebug = false;
   bool showMenuScene = false;
   bool showFrameTime = false;
+  bool showCompTime = false;
 
   bool isVisible = false;
   bool didInit = false;
@@ -151,6 +152,7 @@ void Debug::Overlay::draw(P64::Scene &scene, surface_t* surf)
     addBoolItem(menu, "Coll-Tri", showCollMesh);
     addBoolItem(menu, "Memory", matrixDebug);
     addBoolItem(menu, "Frames", showFrameTime);
+    addBoolItem(menu, "Comp-Time", showCompTime);
 
     addActionItem(menuScenes, "< Back >", []([[maybe_unused]] auto &item) {
       showMenuScene = false;
@@ -242,6 +244,13 @@ void Debug::Overlay::draw(P64::Scene &scene, surface_t* surf)
   // posX = Debug::printf(posX, posY, "T:%d", triCount) + 8;
   Debug::printf(posX-32, posY, "H:%dkb", heap_stats.used);
   Debug::printf(posX, posY+8, "O:%d\n", scene.getObjectCount());
+  // object pool: used / reserved, free-listed blocks
+  const auto &poolStats = scene.getObjectPoolStats();
+  Debug::printf(posX-32, posY+16, "P:%lu/%lukb F:%lukb",
+    poolStats.bytesUsed / 1024, poolStats.bytesReserved / 1024, poolStats.bytesFree / 1024
+  );
+  // events: delivered / left for next frame, dropped in total
+  Debug::printf(posX-32, posY+24, "Ev:%lu/%lu D:%lu", scene.eventCount, scene.eventDeferredCount, scene.eventDroppedCount);
 
   posX = 24;
 
@@ -264,11 +273,44 @@ void Debug::Overlay::draw(P64::Scene &scene, surface_t* surf)
     posY += 8;
   }
 
+  // per component type: count, update and draw time in ms
+  if(showCompTime)
+  {
+    posX = 160;
+    posY = 38;
+    for(auto type : P64::COMP_DISPATCH_ORDER) {
+      uint32_t compCount = scene.getComponentCount(type);
+      if(compCount == 0)continue;
+      Debug::printf(posX, posY, "%s:%lu %.2f %.2f", P64::COMP_TABLE[type].name, compCount,
+        (double)TICKS_TO_US((uint64_t)scene.ticksCompUpdate[type]) / 1000.0,
+        (double)TICKS_TO_US((uint64_t)scene.ticksCompDraw[type]) / 1000.0
+      );
+      posY += 8;
+    }
+  }
+
   // audio channels
   posX = 24;
   posY = SCREEN_HEIGHT - 24;
 
-  posX = Debug::printf(posX, posY, "CH (TODO)");
+  posX = Debug::printf(posX, posY, "CH (TODO)") + 16;
+
+  // collision queries: count, BVH nodes visited, triangles tested, avg. BVH time per query
+  if(collScene.bvhQueryCount > 0) {
+    double usPerQuery = (double)TICKS_TO_US(collScene.ticksBVH) / (double)collScene.bvhQueryCount;
+    rdpq_set_prim_color(COLOR_BVH);
+    Debug::printf(posX, posY, "BVH Q:%lu N:%lu T:%lu %.1fus/Q",
+      collScene.bvhQueryCount, collScene.bvhNodeCount, collScene.triTestCount, usPerQuery
+    );
+    rdpq_set_prim_color({0xFF,0xFF,0xFF, 0xFF});
+  }
+
+  // dynamic colliders: count, pairs found by the broadphase, pairs tested
+  rdpq_set_prim_color(COLOR_COLL);
+  Debug::printf(posX, posY - 8, "BCS:%u Pairs:%lu/%lu",
+    collScene.getSpheres().size(), collScene.pairCount, collScene.pairTestCount
+  );
+  rdpq_set_prim_color({0xFF,0xFF,0xFF, 0xFF});
   /*uint32_t audioMask = scene.getAudio().getActiveChannelMask();
   for(int i=0; i<16; ++i) {
     bool isActive = audioMask & (1 << i);
@@ -0,0 +1,114 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "lib/objectPool.h"
+#include "lib/math.h"
+
+namespace
+{
+  struct BlockHeader {
+    uint32_t size; // size of the whole block, incl. this header
+    uint32_t _padding;
+  };
+  static_assert(sizeof(BlockHeader) == 8);
+
+  constexpr uint32_t getClassIndex(uint32_t blockSize) {
+    return (blockSize / 16) - 1;
+  }
+}
+
+void P64::Mem::ObjectPool::pushFree(void* block, uint32_t blockSize)
+{
+  auto freeBlock = (FreeBlock*)block;
+  auto &list = freeLists[getClassIndex(blockSize)];
+  freeBlock->next = list;
+  list = freeBlock;
+  stats.bytesFree += blockSize;
+}
+
+void P64::Mem::ObjectPool::newChunk(uint32_t size)
+{
+  // keep the rest of the old chunk around, it can still serve smaller blocks
+  uint32_t rest = chunkEnd - chunkPtr;
+  while(rest != 0) {
+    uint32_t restBlock = rest > MAX_CLASS_SIZE ? MAX_CLASS_SIZE : rest;
+    pushFree(chunkPtr, restBlock);
+    chunkPtr += restBlock;
+    rest -= restBlock;
+  }
+
+  chunkPtr = (char*)memalign(BLOCK_ALIGN, size);
+  chunkEnd = chunkPtr + size;
+  chunks.push_back(chunkPtr);
+  stats.bytesReserved += size;
+}
+
+void P64::Mem::ObjectPool::reserve(uint32_t bytes)
+{
+  bytes = Math::alignUp(bytes, BLOCK_ALIGN);
+  if((uint32_t)(chunkEnd - chunkPtr) >= bytes)return;
+  newChunk(bytes > CHUNK_SIZE ? bytes : CHUNK_SIZE);
+}
+
+void* P64::Mem::ObjectPool::alloc(uint32_t size)
+{
+  uint32_t blockSize = Math::alignUp(size + sizeof(BlockHeader), BLOCK_ALIGN);
+  BlockHeader *block;
+  static_assert(getPooledSize(1) == 16 && getPooledSize(8) == 16 && getPooledSize(9) == 32);
+
+  if(blockSize > MAX_CLASS_SIZE)
+  {
+    block = (BlockHeader*)memalign(BLOCK_ALIGN, blockSize);
+    largeBlocks.push_back(block);
+    stats.bytesReserved += blockSize;
+  }
+  else if(auto &list = freeLists[getClassIndex(blockSize)])
+  {
+    block = (BlockHeader*)list;
+    list = list->next;
+    stats.bytesFree -= blockSize;
+  }
+  else
+  {
+    if((uint32_t)(chunkEnd - chunkPtr) < blockSize)newChunk(CHUNK_SIZE);
+    block = (BlockHeader*)chunkPtr;
+    chunkPtr += blockSize;
+  }
+
+  block->size = blockSize;
+  stats.bytesUsed += blockSize;
+  ++stats.allocCount;
+  return block + 1;
+}
+
+void P64::Mem::ObjectPool::release(void* ptr)
+{
+  if(!ptr)return;
+  auto block = (BlockHeader*)ptr - 1;
+  uint32_t blockSize = block->size;
+
+  stats.bytesUsed -= blockSize;
+  --stats.allocCount;
+
+  if(blockSize > MAX_CLASS_SIZE) {
+    std::erase(largeBlocks, block);
+    stats.bytesReserved -= blockSize;
+    free(block);
+    return;
+  }
+  pushFree(block, blockSize);
+}
+
+void P64::Mem::ObjectPool::freeAll()
+{
+  for(auto chunk : chunks)free(chunk);
+  for(auto block : largeBlocks)free(block);
+  chunks.clear();
+  largeBlocks.clear();
+
+  for(auto &list : freeLists)list = nullptr;
+  chunkPtr = nullptr;
+  chunkEnd = nullptr;
+  stats = {};
+}
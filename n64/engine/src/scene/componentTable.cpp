@@ -47,6 +47,7 @@ namespace
     .onEvent = (FuncOnEvent)(get_event<Comp::NAME>()), \
     .onColl = (FuncOnColl)(get_coll<Comp::NAME>()), \
     .getAllocSize = reinterpret_cast<FuncGetAllocSize>(Comp::NAME::getAllocSize), \
+    .name = #NAME, \
   }
 
 namespace P64
@@ -64,4 +65,18 @@ namespace P64
     SET_COMP(NodeGraph),
     SET_COMP(AnimModel),
   };
+
+  const uint8_t COMP_DISPATCH_ORDER[COMP_DISPATCH_COUNT] {
+    Comp::Constraint::ID, // must come before culling and any drawing
+    Comp::Culling::ID, // must come before any models
+    Comp::Code::ID,
+    Comp::Model::ID,
+    Comp::Light::ID,
+    Comp::Camera::ID,
+    Comp::CollMesh::ID,
+    Comp::CollBody::ID,
+    Comp::Audio2D::ID,
+    Comp::NodeGraph::ID,
+    Comp::AnimModel::ID,
+  };
 }
@@ -17,7 +17,7 @@ namespace
   {
     uint16_t assetIdx;
     uint8_t flags;
-    uint8_t _padding;
+    uint8_t maskWrite;
   };
 
   constexpr uint8_t FLAG_EXTERNAL = 1 << 0;
@@ -57,7 +57,8 @@ namespace P64::Comp
     }
 
     data->meshInstance.object = &obj;
-    data->meshInstance.mesh = Coll::Mesh::load(rawData);
+    data->meshInstance.mesh = Coll::MeshChunks::load(rawData);
+    data->meshInstance.maskWrite = initData->maskWrite;
     obj.getScene().getCollision().registerMesh(&data->meshInstance);
   }
 
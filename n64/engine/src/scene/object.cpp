@@ -27,7 +27,7 @@ void P64::Object::setEnabled(bool isEnabled)
     flags &= ~ObjectFlags::SELF_ACTIVE;
   }
 
-  if(oldFlags == flags)return;
+  if(oldFlags == flags || !(flags & ObjectFlags::HAS_EVENTS))return;
 
   auto compRefs = getCompRefs();
   for (uint32_t i=0; i<compCount; ++i) {
@@ -0,0 +1,65 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "scene/objectTable.h"
+#include "scene/object.h"
+
+P64::ObjectTable::Entry& P64::ObjectTable::getOrAllocEntry(uint16_t id)
+{
+  auto &page = pages[id / PAGE_SIZE];
+  if(!page) {
+    page = (Entry*)malloc(sizeof(Entry) * PAGE_SIZE);
+    memset(page, 0, sizeof(Entry) * PAGE_SIZE);
+  }
+  return page[id % PAGE_SIZE];
+}
+
+void P64::ObjectTable::add(Object &obj)
+{
+  auto &entry = getOrAllocEntry(obj.id);
+  assertf(entry.obj == nullptr, "Object ID %d already in use!", obj.id);
+  entry.obj = &obj;
+
+  auto &parent = getOrAllocEntry(obj.group);
+  obj.nextSibling = nullptr;
+  if(parent.lastChild) {
+    parent.lastChild->nextSibling = &obj;
+  } else {
+    parent.firstChild = &obj;
+  }
+  parent.lastChild = &obj;
+}
+
+void P64::ObjectTable::remove(Object &obj)
+{
+  auto &entry = getOrAllocEntry(obj.id);
+  if(entry.obj == &obj)entry.obj = nullptr;
+
+  auto &parent = getOrAllocEntry(obj.group);
+  Object* prev = nullptr;
+  for(auto child = parent.firstChild; child; child = child->nextSibling)
+  {
+    if(child != &obj) {
+      prev = child;
+      continue;
+    }
+
+    if(prev) {
+      prev->nextSibling = obj.nextSibling;
+    } else {
+      parent.firstChild = obj.nextSibling;
+    }
+    if(parent.lastChild == &obj)parent.lastChild = prev;
+    break;
+  }
+  obj.nextSibling = nullptr;
+}
+
+void P64::ObjectTable::clear()
+{
+  for(auto &page : pages) {
+    free(page);
+    page = nullptr;
+  }
+}
@@ -4,6 +4,7 @@
 */
 #include "scene/scene.h"
 
+#include <algorithm>
 #include <libdragon.h>
 #include <rspq_profile.h>
 #include <t3d/t3d.h>
@@ -30,7 +31,6 @@
 
 namespace
 {
-  uint16_t nextId = 0xFF;
 #if RSPQ_PROFILE
   uint32_t frameCount = 0;
 #endif
@@ -96,10 +96,14 @@ P64::Scene::~Scene()
 {
   rspq_wait();
 
+  // the memory itself is released all at once by the pool
   for(auto obj : objects) {
     obj->~Object();
-    free(obj);
   }
+  objects.clear();
+  objectTable.clear();
+  for(auto &list : compLists)list.clear();
+  objectPool.freeAll();
 
   AudioManager::stopAll();
   MatrixManager::reset();
@@ -122,9 +126,8 @@ void P64::Scene::update(float deltaTime)
   ticksActorUpdate = 0;
   ticksDraw = 0;
   ticksGlobalDraw = 0;
-  collScene.ticks = 0;
-  collScene.ticksBVH = 0;
-  collScene.raycastCount = 0;
+  ticksCompDraw = {};
+  collScene.resetMetrics();
   AudioManager::ticksUpdate = 0;
 
   AudioManager::update();
@@ -151,17 +154,18 @@ void P64::Scene::update(float deltaTime)
   ticksGlobalUpdate = get_user_ticks() - ticksGlobalUpdate;
 
   ticksActorUpdate = get_ticks();
-  for(auto obj : objects)
+  for(auto type : COMP_DISPATCH_ORDER)
   {
-    if(!obj->isEnabled())continue;
+    const auto &compDef = COMP_TABLE[type];
+    if(!compDef.update)continue;
 
-    auto compRefs = obj->getCompRefs();
-
-    for (uint32_t i=0; i<obj->compCount; ++i) {
-      const auto &compDef = COMP_TABLE[compRefs[i].type];
-      char* dataPtr = (char*)obj + compRefs[i].offset;
-      compDef.update(*obj, dataPtr, deltaTime);
+    auto t = get_ticks();
+    for(const auto &entry : compLists[type]) {
+      if(entry.obj->isEnabled()) {
+        compDef.update(*entry.obj, entry.data, deltaTime);
+      }
     }
+    ticksCompUpdate[type] = get_ticks() - t;
   }
 
   for(auto &cam : cameras) {
@@ -173,38 +177,86 @@ void P64::Scene::update(float deltaTime)
 
   for(auto &obj : pendingObjDelete)
   {
-    idLookup[obj->id] = nullptr;
+    unregisterComponents(*obj);
+    objectTable.remove(*obj);
     std::erase(objects, obj);
     obj->~Object();
-    free(obj);
+    objectPool.release(obj);
   }
   pendingObjDelete.clear();
 
-  // events, switch now to prevent infinite loops for objects that push events in response to events
+  dispatchEvents();
+
+  AudioManager::update();
+
+  VI::SwapChain::nextFrame();
+}
+
+void P64::Scene::dispatchEvents()
+{
+  // switch now to prevent infinite loops for objects that push events in response to events
   auto &evQueue = eventQueue[eventQueueIdx];
   eventQueueIdx = (eventQueueIdx + 1) % 2;
-  for(uint32_t e=0; e<evQueue.eventCount; ++e)
+  auto &evQueueNext = eventQueue[eventQueueIdx];
+
+  auto sendToObject = [](Object &obj, const ObjectEvent &event) {
+    if(!(obj.flags & ObjectFlags::HAS_EVENTS))return;
+
+    auto compRefs = obj.getCompRefs();
+    for (uint32_t i=0; i<obj.compCount; ++i) {
+      const auto &compDef = COMP_TABLE[compRefs[i].type];
+      if(compDef.onEvent)
+      {
+        char* dataPtr = (char*)&obj + compRefs[i].offset;
+        compDef.onEvent(obj, dataPtr, event);
+      }
+    }
+  };
+
+  // high priority first, otherwise keep the order events were sent in
+  auto &events = evQueue.events;
+  if(evQueue.highPrioCount != 0) {
+    std::stable_partition(events.begin(), events.end(), [](const ObjectEventWrapper &entry) {
+      return entry.prio == EventPrio::HIGH;
+    });
+  }
+
+  uint32_t count = events.size();
+  uint32_t budget = evQueue.highPrioCount + EVENT_BUDGET;
+  if(count > budget)count = budget;
+
+  for(uint32_t e=0; e<count; ++e)
   {
-    auto &entry = evQueue.events[e];
-    auto obj = getObjectById(entry.targetId);
-    if(obj)
+    const auto &entry = events[e];
+    switch(entry.target)
     {
-      auto compRefs = obj->getCompRefs();
-      for (uint32_t i=0; i<obj->compCount; ++i) {
-        const auto &compDef = COMP_TABLE[compRefs[i].type];
-        if(compDef.onEvent)
-        {
-          char* dataPtr = (char*)obj + compRefs[i].offset;
-          compDef.onEvent(*obj, dataPtr, entry.event);
+      case EventTarget::OBJECT: {
+        auto obj = getObjectById(entry.targetId);
+        if(obj)sendToObject(*obj, entry.event);
+      } break;
+
+      case EventTarget::CHILDREN:
+        iterObjectChildren(entry.targetId, [&](Object *child) {
+          sendToObject(*child, entry.event);
+        });
+      break;
+
+      case EventTarget::BROADCAST:
+        for(auto obj : objects) {
+          sendToObject(*obj, entry.event);
         }
-      }
+      break;
     }
   }
-  evQueue.clear();
 
-  AudioManager::update();
-
-  VI::SwapChain::nextFrame();
+  // over budget, the rest is delivered before anything sent this frame
+  eventCount = count;
+  eventDeferredCount = events.size() - count;
+  eventDroppedCount += evQueue.droppedCount;
+  if(eventDeferredCount != 0) {
+    evQueueNext.events.insert(evQueueNext.events.begin(), events.begin() + count, events.end());
+  }
+  evQueue.clear();
 }
 
 void P64::Scene::draw([[maybe_unused]] float deltaTime)
@@ -232,26 +284,24 @@ void P64::Scene::draw([[maybe_unused]] float deltaTime)
 
     GlobalScript::callHooks(GlobalScript::HookType::SCENE_PRE_DRAW_3D);
 
-    //debugf("Drawing objects:\n");
-    for(auto obj : objects)
+    for(auto type : COMP_DISPATCH_ORDER)
     {
-      //debugf(" - %d\n", obj->id);
-      if(!obj->isEnabled())continue;
-      auto compRefs = obj->getCompRefs();
-
-      for (uint32_t i=0; i<obj->compCount; ++i)
-      {
-        if(obj->flags & ObjectFlags::IS_CULLED)break;
-        const auto &compDef = COMP_TABLE[compRefs[i].type];
-        if(compDef.draw)
-        {
-          char* dataPtr = (char*)obj + compRefs[i].offset;
-          compDef.draw(*obj, dataPtr, deltaTime);
+      const auto &compDef = COMP_TABLE[type];
+      if(!compDef.draw)continue;
+
+      auto t = get_ticks();
+      for(const auto &entry : compLists[type]) {
+        // culling is drawn before any other type, and may have culled the object
+        if(entry.obj->isEnabled() && !(entry.obj->flags & ObjectFlags::IS_CULLED)) {
+          compDef.draw(*entry.obj, entry.data, deltaTime);
         }
       }
+      ticksCompDraw[type] += get_ticks() - t;
+    }
 
-      // culling resets directly after a draw, otherwise objects can get stuck culled.
-      // this is also needed to handle multiple cameras correctly.
+    // culling resets directly after a draw, otherwise objects can get stuck culled.
+    // this is also needed to handle multiple cameras correctly.
+    for(auto obj : objects) {
       obj->setFlag(ObjectFlags::IS_CULLED, false);
     }
 
@@ -322,6 +372,17 @@ void P64::Scene::onObjectCollision(const Coll::CollEvent &event)
   }
 }
 
+void P64::Scene::unregisterComponents(Object &obj)
+{
+  auto compRefs = obj.getCompRefs();
+  for (uint32_t i=0; i<obj.compCount; ++i) {
+    // keeps the order, so that update/draw order stays the same
+    std::erase_if(compLists[compRefs[i].type], [&obj](const CompEntry &entry) {
+      return entry.obj == &obj;
+    });
+  }
+}
+
 uint16_t P64::Scene::addObject(
   uint32_t prefabIdx,
   const fm_vec3_t &pos,
@@ -334,47 +395,47 @@ uint16_t P64::Scene::addObject(
     .pos = pos,
     .scale = scale,
     .rot = rot,
-    .objectId = ++nextId,
+    .objectId = allocObjectId(),
   });
-  return nextId;
-}
-
-void P64::Scene::removeObject(Object &obj)
-{
-  pendingObjDelete.push_back(&obj);
+  return objectsToAdd.back().objectId;
 }
 
-P64::Object* P64::Scene::getObjectById(uint16_t objId) const
+uint16_t P64::Scene::allocObjectId()
 {
-  // the first IDs get a direct lookup, under the assumption most
-  // scenes keep object count in a reasonable amount
-  if(objId < idLookup.size()) {
-    return idLookup[objId];
-  }
+  // IDs are handed out round-robin over the entire ID range, skipping used ones.
+  // A freed ID is therefore only reused once all others have been used too,
+  // so stale references to removed objects don't resolve to a new object right away.
+  for(uint32_t i=0; i<0xFFFF; ++i)
+  {
+    if(++nextId == 0)continue;
+    if(objectTable.get(nextId))continue;
 
-  // otherwise fallback to a linear scan
-  for(auto obj : objects) {
-    if (objId == obj->id) {
-      return obj;
+    bool isPending = false;
+    for(auto &params : objectsToAdd) {
+      isPending |= params.objectId == nextId;
     }
+    if(!isPending)return nextId;
   }
-  return nullptr;
+  assertf(false, "No free object ID left!");
+  return 0;
+}
+
+void P64::Scene::removeObject(Object &obj)
+{
+  pendingObjDelete.push_back(&obj);
 }
 
 void P64::Scene::setGroupEnabled(uint16_t groupId, bool enabled) const
 {
   if(groupId == 0)return;
 
-  for(auto obj : objects)
-  {
-    if (groupId == obj->id) {
-      obj->setFlag(ObjectFlags::SELF_ACTIVE, enabled);
-    }
-    if (groupId == obj->group) {
-      //debugf("-> obj %d active = %d\n", obj->id, enabled);
-      obj->setFlag(ObjectFlags::PARENTS_ACTIVE, enabled);
-    }
-  }
+  auto obj = getObjectById(groupId);
+  if(obj)obj->setFlag(ObjectFlags::SELF_ACTIVE, enabled);
+
+  iterObjectChildren(groupId, [enabled](Object *child) {
+    //debugf("-> obj %d active = %d\n", child->id, enabled);
+    child->setFlag(ObjectFlags::PARENTS_ACTIVE, enabled);
+  });
 }
 
 P64::Lighting & P64::Scene::startLightingOverride(bool copyExisting)
@@ -16,7 +16,7 @@ namespace {
     uint16_t flags;
     uint16_t id;
     uint16_t group;
-    uint16_t _padding;
+    uint16_t compCount;
     fm_vec3_t pos;
     fm_vec3_t scale;
     uint32_t packedRot;
@@ -64,56 +64,76 @@ void P64::Scene::loadSceneConfig()
   }
 }
 
-P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object&)> callback)
+/**
+ * Calculates the memory layout of an object entry, see 'loadObject'.
+ * The size of each component is appended to 'compSizes', so it is only queried once.
+ */
+P64::Scene::ObjectLayout P64::Scene::getObjectLayout(const uint8_t* objFile)
 {
-  ObjectEntry* objEntry = (ObjectEntry*)objFile;
-
-  // pre-scan components to get total allocation size
-  uint32_t allocSize = sizeof(Object);
-
   // some alignment logic below relies on an at a minimum 4-byte size
-  static_assert(sizeof(Object) % 4 == 0);
-  static_assert(sizeof(Object::CompRef) % 4 == 0);
+  static_assert(sizeof(P64::Object) % 4 == 0);
+  static_assert(sizeof(P64::Object::CompRef) % 4 == 0);
 
+  auto objEntry = (const ObjectEntry*)objFile;
   auto ptrIn = objFile + sizeof(ObjectEntry);
-  uint32_t compCount = 0;
+  uint32_t compCount = objEntry->compCount;
   uint32_t compDataSize = 0;
-  while(ptrIn[1] != 0) {
-    auto compId = ptrIn[0];
-    auto argSize = ptrIn[1] * 4;
+  uint32_t compSizeIdx = compSizes.size();
 
+  for(uint32_t i=0; i<compCount; ++i) {
+    auto compId = ptrIn[0];
     assertf(compId < COMP_TABLE_SIZE, "Invalid component ID %d!", compId);
     const auto &compDef = COMP_TABLE[compId];
     assertf(compDef.getAllocSize != nullptr, "Component %d unknown!", compId);
-    compDataSize += Math::alignUp(compDef.getAllocSize(ptrIn + 4), DATA_ALIGN);
-    allocSize += sizeof(Object::CompRef);
 
-    ptrIn += argSize;
-    ++compCount;
+    uint32_t size = Math::alignUp(compDef.getAllocSize((void*)(ptrIn + 4)), DATA_ALIGN);
+    compSizes.push_back(size);
+    compDataSize += size;
+    ptrIn += ptrIn[1] * 4;
   }
 
   // component data must be 8-byte aligned, GCC tries to be smart
   // and some structs cuse 64-bit writes to members.
   // if it is misaligned, add spacing after the comp table
-  uint32_t offsetData = (sizeof(Object::CompRef) * compCount);
-  if(allocSize % 8 != 0) {
-    compDataSize += 4;
-    offsetData += 4;
+  ObjectLayout layout{
+    .allocSize = sizeof(Object) + sizeof(Object::CompRef) * compCount,
+    .offsetData = sizeof(Object::CompRef) * compCount,
+    .entrySize = (uint32_t)(ptrIn + 4 - objFile), // includes the terminator
+    .compSizeIdx = compSizeIdx,
+  };
+  if(layout.allocSize % 8 != 0) {
+    layout.allocSize += 4;
+    layout.offsetData += 4;
   }
+  layout.allocSize += compDataSize;
+  return layout;
+}
+
+P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object&)> callback)
+{
+  compSizes.clear();
+  auto layout = getObjectLayout(objFile);
+  auto obj = loadObject(objFile, layout, callback);
+  objFile += layout.entrySize;
+  return obj;
+}
 
-  allocSize += compDataSize;
+P64::Object* P64::Scene::loadObject(const uint8_t* objFile, const ObjectLayout &layout, std::function<void(Object&)> callback)
+{
+  auto objEntry = (const ObjectEntry*)objFile;
+  uint32_t compCount = objEntry->compCount;
 
-  //debugf("Allocating object %d | comps: %d | size: %lu bytes\n", objEntry->id, compCount, allocSize);
+  //debugf("Allocating object %d | comps: %lu | size: %lu bytes\n", objEntry->id, compCount, layout.allocSize);
 
-  void* objMem = memalign(DATA_ALIGN, allocSize); // @TODO: custom allocator
-  if(allocSize < 16) {
-    memset(objMem, 0, allocSize);
+  void* objMem = objectPool.alloc(layout.allocSize);
+  if(layout.allocSize < 16) {
+    memset(objMem, 0, layout.allocSize);
   } else {
-    sys_hw_memset(objMem, 0, allocSize);
+    sys_hw_memset(objMem, 0, layout.allocSize);
   }
 
   auto objCompTablePtr = (Object::CompRef*)((char*)objMem + sizeof(Object));
-  auto objCompDataPtr = (char*)(objCompTablePtr) + offsetData;
+  auto objCompDataPtr = (char*)(objCompTablePtr) + layout.offsetData;
 
   Object* obj = new(objMem) Object();
   obj->id = objEntry->id;
@@ -126,8 +146,9 @@ P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object
 
   if(callback)callback(*obj);
 
-  ptrIn = objFile + sizeof(ObjectEntry);
-  while(ptrIn[1] != 0)
+  auto ptrIn = (uint8_t*)objFile + sizeof(ObjectEntry);
+  const uint32_t* objCompSizes = compSizes.data() + layout.compSizeIdx;
+  for(uint32_t i=0; i<compCount; ++i)
   {
     uint8_t compId = ptrIn[0];
     uint8_t argSize = ptrIn[1] * 4;
@@ -141,7 +162,9 @@ P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object
     ++objCompTablePtr;
 
     compDef.initDel(*obj, objCompDataPtr, ptrIn + 4);
-    objCompDataPtr += Math::alignUp(compDef.getAllocSize(ptrIn + 4), 8);
+    compLists[compId].push_back({obj, objCompDataPtr});
+    if(compDef.onEvent)obj->flags |= ObjectFlags::HAS_EVENTS;
+    objCompDataPtr += objCompSizes[i];
     ptrIn += argSize;
   }
 
@@ -151,10 +174,8 @@ P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object
     compCount
   );*/
 
-  objFile = ptrIn + 4;
-
   objects.push_back(obj);
-  idLookup[obj->id] = obj;
+  objectTable.add(*obj);
 
   return obj;
 }
@@ -170,15 +191,37 @@ void P64::Scene::loadScene() {
   {
     auto *objFileStart = (uint8_t*)(loadSubFile('o'));
 
-    // now process all other objects
+    // size all objects first, so the pool can allocate the entire scene at once,
+    // the layouts are kept to load the objects without sizing their components again
+    std::vector<ObjectLayout> layouts{};
+    layouts.reserve(conf.objectCount);
+    compSizes.clear();
+
+    uint32_t sceneAllocSize = 0;
     auto objFile = objFileStart;
     for(uint32_t i=0; i<conf.objectCount; ++i) {
-      loadObject(objFile);
+      auto &layout = layouts.emplace_back(getObjectLayout(objFile));
+      sceneAllocSize += Mem::ObjectPool::getPooledSize(layout.allocSize);
+      objFile += layout.entrySize;
+    }
+    objectPool.reserve(sceneAllocSize);
+    objects.reserve(conf.objectCount);
+
+    // now process all other objects
+    objFile = objFileStart;
+    for(auto &layout : layouts) {
+      loadObject(objFile, layout);
+      objFile += layout.entrySize;
     }
 
     free(objFileStart);
   }
 
+  // spawned objects continue after the highest ID from the editor
+  for(auto obj : objects) {
+    if(obj->id > nextId)nextId = obj->id;
+  }
+
   // update groups
   for(auto obj : objects)
   {
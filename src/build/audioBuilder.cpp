@@ -26,7 +26,7 @@ bool Build::buildAudioAssets(Project::Project &project, SceneCtx &sceneCtx)
 
     sceneCtx.files.push_back(Utils::FS::toUnixPath(asset.outPath));
 
-    if(!assetBuildNeeded(asset, outPath))continue;
+    if(!assetBuildNeeded(sceneCtx, asset, outPath, "audioconv64"))continue;
 
     std::string cmd = mkAudio.string();
     if(asset.conf.wavForceMono.value) {
@@ -40,9 +40,11 @@ bool Build::buildAudioAssets(Project::Project &project, SceneCtx &sceneCtx)
     cmd += " -o \"" + outDir.string() + "\"";
     cmd += " \"" + asset.path + "\"";
 
-    if(!sceneCtx.toolchain.runCmdSyncLogged(cmd)) {
-      return false;
-    }
+    sceneCtx.jobs.add("audioconv64: " + asset.name, [&sceneCtx, cmd, outPath]() {
+      if(!sceneCtx.toolchain.runCmdSyncLogged(cmd, true))return false;
+      sceneCtx.buildCache.store(outPath);
+      return true;
+    });
   }
   return true;
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "buildCache.h"
+
+#include <chrono>
+#include <cstring>
+
+#include "json.hpp"
+#include "SHA256.h"
+#include "../utils/fs.h"
+#include "../utils/logger.h"
+
+namespace
+{
+  // unreferenced cache entries are kept around for a while to make branch switches cheap
+  constexpr auto MAX_UNUSED_AGE = std::chrono::hours{24 * 14};
+
+  std::string toHex(const uint8_t* data, uint32_t size)
+  {
+    constexpr char HEX[] = "0123456789abcdef";
+    std::string res(size * 2, '0');
+    for(uint32_t i=0; i<size; ++i) {
+      res[i*2+0] = HEX[data[i] >> 4];
+      res[i*2+1] = HEX[data[i] & 0xF];
+    }
+    return res;
+  }
+
+  std::string uriDecode(const std::string &uri)
+  {
+    std::string res{};
+    for(size_t i=0; i<uri.size(); ++i) {
+      if(uri[i] == '%' && i+2 < uri.size()) {
+        res += (char)std::stoi(uri.substr(i+1, 2), nullptr, 16);
+        i += 2;
+      } else {
+        res += uri[i];
+      }
+    }
+    return res;
+  }
+
+  /**
+   * Returns external files referenced by a glTF/GLB (buffers and images).
+   * Embedded data ('data:' URIs or the GLB binary chunk) is covered by the file hash already.
+   */
+  std::vector<fs::path> getGLTFDependencies(const fs::path &path)
+  {
+    auto ext = path.extension().string();
+    if(ext != ".gltf" && ext != ".glb")return {};
+
+    auto data = Utils::FS::loadTextFile(path);
+    std::string jsonStr{};
+    if(ext == ".glb") {
+      // header (magic, version, length) + first chunk (length, type), which is always JSON
+      if(data.size() < 20 || data.substr(0, 4) != "glTF")return {};
+      uint32_t chunkLen;
+      memcpy(&chunkLen, data.data() + 12, sizeof(chunkLen));
+      if(20 + (size_t)chunkLen > data.size())return {};
+      jsonStr = data.substr(20, chunkLen);
+    } else {
+      jsonStr = std::move(data);
+    }
+
+    auto doc = nlohmann::json::parse(jsonStr, nullptr, false);
+    if(!doc.is_object())return {};
+
+    std::vector<fs::path> res{};
+    for(auto key : {"buffers", "images"}) {
+      if(!doc.contains(key) || !doc[key].is_array())continue;
+      for(auto &item : doc[key]) {
+        auto uri = item.value("uri", std::string{});
+        if(uri.empty() || uri.starts_with("data:"))continue;
+        res.push_back(path.parent_path() / uriDecode(uri));
+      }
+    }
+    return res;
+  }
+}
+
+std::string Build::BuildCache::hashSource(const fs::path &path)
+{
+  std::error_code ec{};
+  auto size = fs::file_size(path, ec);
+  if(ec)return "";
+  uint64_t time = Utils::FS::getFileAge(path);
+
+  auto relPath = getRelPath(path);
+  auto &src = sources[relPath];
+  if(!src.hash.empty() && src.time == time && src.size == size) {
+    return src.hash;
+  }
+
+  SHA256 sha{};
+  sha.update(Utils::FS::loadTextFile(path));
+  auto digest = sha.digest();
+
+  src = {time, size, toHex(&digest[0], 16)};
+  dirty = true;
+  return src.hash;
+}
+
+std::string Build::BuildCache::getRelPath(const fs::path &path) const {
+  return Utils::FS::toUnixPath(fs::absolute(path).lexically_relative(projectPath));
+}
+
+fs::path Build::BuildCache::getObjectPath(const std::string &key) const {
+  return cachePath / "obj" / key;
+}
+
+void Build::BuildCache::load(const fs::path &projPath)
+{
+  std::lock_guard lock{mtx};
+  projectPath = fs::absolute(projPath);
+  cachePath = projectPath / "build" / ".p64cache";
+  sources.clear();
+  outputs.clear();
+  pending.clear();
+  dirty = false;
+
+  auto doc = nlohmann::json::parse(Utils::FS::loadTextFile(cachePath / "index.json"), nullptr, false);
+  if(!doc.is_object() || doc.value<uint32_t>("version", 0) != VERSION)return;
+
+  for(auto &[path, src] : doc["sources"].items()) {
+    sources[path] = {
+      src.value<uint64_t>("time", 0),
+      src.value<uint64_t>("size", 0),
+      src.value("hash", std::string{}),
+    };
+  }
+  for(auto &[path, out] : doc["outputs"].items()) {
+    if(out.is_string()) {
+      outputs[path] = {out.get<std::string>()};
+      continue;
+    }
+    auto &entry = outputs[path];
+    entry.key = out.value("key", std::string{});
+    entry.extraFiles = out.value("extra", std::vector<std::string>{});
+    entry.extrasKnown = true;
+  }
+}
+
+void Build::BuildCache::save()
+{
+  std::lock_guard lock{mtx};
+  if(!dirty || cachePath.empty())return;
+
+  nlohmann::json doc{};
+  doc["version"] = VERSION;
+  doc["sources"] = nlohmann::json::object();
+  doc["outputs"] = nlohmann::json::object();
+  for(auto &[path, src] : sources) {
+    doc["sources"][path] = {{"time", src.time}, {"size", src.size}, {"hash", src.hash}};
+  }
+  for(auto &[path, out] : outputs) {
+    doc["outputs"][path] = {{"key", out.key}, {"extra", out.extraFiles}};
+  }
+
+  fs::create_directories(cachePath);
+  Utils::FS::saveTextFile(cachePath / "index.json", doc.dump());
+  dirty = false;
+
+  // prune entries that are neither in use nor were created recently
+  std::error_code ec{};
+  auto objDir = cachePath / "obj";
+  if(!fs::exists(objDir))return;
+
+  std::unordered_map<std::string, bool> usedKeys{};
+  for(auto &[path, out] : outputs)usedKeys[out.key] = true;
+
+  auto now = fs::file_time_type::clock::now();
+  for(auto &entry : fs::directory_iterator{objDir, ec}) {
+    if(usedKeys.contains(entry.path().filename().string()))continue;
+    auto age = now - fs::last_write_time(entry.path(), ec);
+    if(!ec && age > MAX_UNUSED_AGE) {
+      fs::remove_all(entry.path(), ec);
+    }
+  }
+}
+
+bool Build::BuildCache::check(const fs::path &outPath, const fs::path &srcPath, const std::string &settings)
+{
+  std::lock_guard lock{mtx};
+
+  SHA256 sha{};
+  sha.update("P64-" + std::to_string(VERSION) + "-" PYRITE_VERSION "\n");
+  sha.update(hashSource(srcPath) + "\n");
+  for(auto &dep : getGLTFDependencies(srcPath)) {
+    sha.update(getRelPath(dep) + ":" + hashSource(dep) + "\n");
+  }
+  sha.update(settings);
+  auto digest = sha.digest();
+  auto key = toHex(&digest[0], 16);
+
+  auto relPath = getRelPath(outPath);
+  auto itOut = outputs.find(relPath);
+  if(itOut != outputs.end() && itOut->second.key == key && itOut->second.extrasKnown && fs::exists(outPath))
+  {
+    // a build can produce more than one file, all of them must still be there
+    bool complete = true;
+    for(auto &file : itOut->second.extraFiles) {
+      complete &= fs::exists(outPath.parent_path() / file);
+    }
+    if(complete)return false;
+  }
+
+  std::error_code ec{};
+  auto objPath = getObjectPath(key);
+  if(fs::is_directory(objPath, ec))
+  {
+    bool restored = true;
+    OutputEntry entry{key, {}, true};
+    for(auto &objFile : fs::directory_iterator{objPath, ec}) {
+      auto fileName = objFile.path().filename();
+      restored &= fs::copy_file(objFile.path(), outPath.parent_path() / fileName,
+        fs::copy_options::overwrite_existing, ec);
+      if(fileName != outPath.filename())entry.extraFiles.push_back(fileName.string());
+    }
+    if(restored && fs::exists(outPath)) {
+      Utils::Logger::log("Restored Asset from cache: " + srcPath.string());
+      outputs[relPath] = std::move(entry);
+      dirty = true;
+      return false;
+    }
+  }
+
+  Utils::Logger::log("Building Asset: " + srcPath.string());
+  pending[relPath] = key;
+  return true;
+}
+
+void Build::BuildCache::store(const fs::path &outPath, const std::vector<fs::path> &extraFiles)
+{
+  std::lock_guard lock{mtx};
+  auto relPath = getRelPath(outPath);
+  auto itPending = pending.find(relPath);
+  if(itPending == pending.end())return;
+
+  auto key = itPending->second;
+  pending.erase(itPending);
+
+  std::error_code ec{};
+  auto objPath = getObjectPath(key);
+  fs::create_directories(objPath, ec);
+
+  OutputEntry entry{key, {}, true};
+  bool stored = fs::copy_file(outPath, objPath / outPath.filename(), fs::copy_options::overwrite_existing, ec);
+  for(auto &file : extraFiles) {
+    stored &= fs::copy_file(file, objPath / file.filename(), fs::copy_options::overwrite_existing, ec);
+    entry.extraFiles.push_back(file.filename().string());
+  }
+
+  if(!stored) {
+    // never keep partial entries around, otherwise a restore could miss files
+    fs::remove_all(objPath, ec);
+    Utils::Logger::log("Failed to cache Asset: " + outPath.string(), Utils::Logger::LEVEL_WARN);
+    return;
+  }
+
+  outputs[relPath] = std::move(entry);
+  dirty = true;
+}
@@ -0,0 +1,81 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Build
+{
+  /**
+   * Persistent, content-hash based cache for asset builds (stored in 'build/.p64cache').
+   * Each output is keyed by a hash of the source data, its dependencies (e.g. glTF buffers/textures),
+   * the asset settings and the tool + arguments used to convert it.
+   * Converted files are kept per key, so switching back to a known state restores them without
+   * running any tool again.
+   */
+  class BuildCache
+  {
+    private:
+      struct SourceHash
+      {
+        uint64_t time{};
+        uint64_t size{};
+        std::string hash{};
+      };
+
+      struct OutputEntry
+      {
+        std::string key{};
+        std::vector<std::string> extraFiles{}; // file names next to the main output
+        bool extrasKnown{false}; // false for entries from older index files
+      };
+
+      fs::path projectPath{};
+      fs::path cachePath{};
+
+      std::unordered_map<std::string, SourceHash> sources{};
+      std::unordered_map<std::string, OutputEntry> outputs{};
+      std::unordered_map<std::string, std::string> pending{};
+      std::mutex mtx{};
+      bool dirty{false};
+
+      std::string hashSource(const fs::path &path);
+      std::string getRelPath(const fs::path &path) const;
+      fs::path getObjectPath(const std::string &key) const;
+
+    public:
+      // bump whenever the output of an asset changes, e.g. a new file format
+      constexpr static uint32_t VERSION = 3;
+
+      void load(const fs::path &projectPath);
+      void save();
+
+      /**
+       * Calculates the key of an output, and checks if it is up to date.
+       * If a matching build is in the cache, the files get restored.
+       * Otherwise the key is remembered until 'store()' is called for the same output.
+       *
+       * @param outPath main output file
+       * @param srcPath source asset
+       * @param settings anything else affecting the output (serialized asset-conf, tool + arguments, ...)
+       * @return true if the output needs to be built
+       */
+      bool check(const fs::path &outPath, const fs::path &srcPath, const std::string &settings);
+
+      /**
+       * Saves a freshly built output in the cache, must be called after a successful build.
+       * Thread-safe, so it can be called from a build job.
+       * @param outPath main output file, as passed to 'check()'
+       * @param extraFiles additional files produced by the same build (e.g. streaming data)
+       */
+      void store(const fs::path &outPath, const std::vector<fs::path> &extraFiles = {});
+  };
+}
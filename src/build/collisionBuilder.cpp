@@ -3,9 +3,11 @@
 * @license MIT
 */
 #include "projectBuilder.h"
+#include <cmath>
+
+#include "tools/collisionMesh.h"
 #include "../utils/binaryFile.h"
 #include "../utils/fs.h"
-#include "../project/assets/collision.h"
 #include "tiny3d/tools/gltf_importer/src/cgltfHelper.h"
 #include "tiny3d/tools/gltf_importer/src/parser.h"
 #include "tiny3d/tools/gltf_importer/src/lib/cgltf.h"
@@ -13,14 +15,6 @@
 
 namespace
 {
-  struct CollisionMesh
-  {
-    std::vector<glm::vec3> verticesFloat{};
-    std::vector<glm::i16vec3> vertices{};
-    std::vector<glm::i16vec3> normals{};
-    std::vector<uint16_t> indices{};
-  };
-
   namespace {
     Mat4 parseNodeMatrix(const cgltf_node *node, const Vec3 &posScale)
     {
@@ -73,10 +67,8 @@ namespace
 
     cgltf_load_buffers(&options, data, gltfPath);
 
-    std::vector<Vec3> verticesFloat{};
-    std::vector<glm::i16vec3> vertices{};
-    std::vector<glm::i16vec3> normals{};
-    std::vector<uint16_t> indices{};
+    std::vector<glm::vec3> verticesFloat{};
+    std::vector<uint32_t> indices{};
 
     for(int i=0; i<data->nodes_count; ++i)
     {
@@ -97,8 +89,7 @@ namespace
 
       for(int j = 0; j < mesh->primitives_count; j++)
       {
-        int baseIndex = vertices.size();
-        assert(baseIndex < 0x10000);
+        uint32_t baseIndex = verticesFloat.size();
 
         auto prim = &mesh->primitives[j];
 
@@ -132,11 +123,6 @@ namespace
                 vert[1] * baseScale,
                 vert[2] * baseScale
               });
-              vertices.push_back({
-                (int16_t)(vert[0] * baseScale),
-                (int16_t)(vert[1] * baseScale),
-                (int16_t)(vert[2] * baseScale)
-              });
               basePtr += Gltf::getDataSize(acc->component_type) * 3;
             }
           }
@@ -145,62 +131,7 @@ namespace
       } // primitives
     } // nodes
 
-    // generate normals
-    for(int v=0; v<indices.size(); v+=3) {
-      Vec3 edge1 = verticesFloat[indices[v+1]] - verticesFloat[indices[v]];
-      Vec3 edge2 = verticesFloat[indices[v+2]] - verticesFloat[indices[v]];
-      Vec3 edge3 = verticesFloat[indices[v+2]] - verticesFloat[indices[v]];
-
-      if(edge1.length() < 0.01f || edge2.length() < 0.01f || edge3.length() < 0.01f) {
-        printf("Degenerate triangle:\nA: %.4f %.4f %.4f\nB: %.4f %.4f %.4f\nC: %.4f %.4f %.4f\n",
-          verticesFloat[indices[v]][0], verticesFloat[indices[v]][1], verticesFloat[indices[v]][2],
-          verticesFloat[indices[v+1]][0], verticesFloat[indices[v+1]][1], verticesFloat[indices[v+1]][2],
-          verticesFloat[indices[v+2]][0], verticesFloat[indices[v+2]][1], verticesFloat[indices[v+2]][2]
-        );
-        printf("Indices: %d %d %d\n", indices[v], indices[v+1], indices[v+2]);
-        throw std::runtime_error("Degenerate triangle!");
-      }
-
-      Vec3 normal = edge1.cross(edge2);
-      normal = normal * (1.0f / normal.length());
-      normals.push_back({
-        (int16_t)(normal[0] * 32767.0f),
-        (int16_t)(normal[1] * 32767.0f),
-        (int16_t)(normal[2] * 32767.0f)
-      });
-    }
-
-    assert(indices.size() % 3 == 0);
-
-    // printf("Vert/Index count: %lu %lu\n", vertices.size(), indices.size());
-
-    auto bvh = Project::Assets::Collision::createBVH(vertices, indices);
-
-    file.write<uint32_t>(indices.size() / 3);
-    file.write<uint32_t>(vertices.size());
-    file.write<float>(1.0f);// / baseScale);
-    file.write<uint32_t>(0); // vertex pointer
-    file.write<uint32_t>(0); // normals pointer
-    file.write<uint32_t>(0); // BVH pointer
-
-    file.writeArray(indices.data(), indices.size());
-    file.align(4);
-
-    for(auto& n : normals) {
-      file.write(n.x);
-      file.write(n.y);
-      file.write(n.z);
-    }
-    file.align(4);
-
-    for(auto& v : verticesFloat) {
-      file.writeArray(v.data, 3);
-    }
-    file.align(4);
-
-    file.writeArray(bvh.data(), bvh.size());
-    file.writeArray(bvh.data(), bvh.size());
-    file.align(4);
+    Build::CollisionMesh::write(file, verticesFloat, indices);
   }
 }
 
@@ -216,4 +147,18 @@ namespace Build
     convert(gltfPath.c_str(), f, baseScale, meshes);
     return f;
   }
+
+  bool buildCollision(
+    const fs::path &outPath,
+    const std::string &gltfPath,
+    float baseScale,
+    const std::unordered_set<std::string> &meshes
+  )
+  {
+    Utils::BinaryFile f{};
+    if(!f.openStream(outPath))return false;
+    convert(gltfPath.c_str(), f, baseScale, meshes);
+    f.closeStream();
+    return true;
+  }
 }
\ No newline at end of file
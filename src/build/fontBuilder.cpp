@@ -29,7 +29,7 @@ bool Build::buildFontAssets(Project::Project &project, SceneCtx &sceneCtx)
       sceneCtx.autoLoadFontUUIDs[fontId] = font.getUUID();
     }
 
-    if(!assetBuildNeeded(font, outPath))continue;
+    if(!assetBuildNeeded(sceneCtx, font, outPath, "mkfont"))continue;
 
     int compr = (int)font.conf.compression - 1;
     if(compr < 0)compr = 1; // @TODO: pull default compression level
@@ -46,9 +46,12 @@ bool Build::buildFontAssets(Project::Project &project, SceneCtx &sceneCtx)
     if(!charsetFile.empty())cmd += " --charset \"" + charsetFile.string() + "\"";
     cmd += " \"" + font.path + "\"";
 
-    bool res = sceneCtx.toolchain.runCmdSyncLogged(cmd);
-    fs::remove(charsetFile);
-    if(!res)return false;
+    sceneCtx.jobs.add("mkfont: " + font.name, [&sceneCtx, cmd, charsetFile, outPath]() {
+      bool res = sceneCtx.toolchain.runCmdSyncLogged(cmd, true);
+      fs::remove(charsetFile);
+      if(res)sceneCtx.buildCache.store(outPath);
+      return res;
+    });
   }
   return true;
 }
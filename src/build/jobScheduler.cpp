@@ -0,0 +1,144 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "jobScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "../utils/logger.h"
+
+namespace
+{
+  thread_local bool isWorkerThread{false};
+
+  std::string formatMs(uint64_t timeUs) {
+    char buff[32];
+    snprintf(buff, sizeof(buff), "%.1fms", timeUs / 1000.0);
+    return buff;
+  }
+}
+
+Build::JobScheduler::JobScheduler(uint32_t threadCount)
+  : threadCount{threadCount}
+{
+  if(this->threadCount == 0) {
+    this->threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+}
+
+uint32_t Build::JobScheduler::getThreadBudget()
+{
+  if(isWorkerThread)return 1;
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+uint32_t Build::JobScheduler::add(const std::string &name, JobFunc func, std::initializer_list<uint32_t> deps)
+{
+  uint32_t id = jobs.size();
+  auto &job = jobs.emplace_back(name, std::move(func));
+
+  for(auto dep : deps) {
+    if(dep == NO_JOB)continue;
+    if(dep >= id) {
+      throw std::runtime_error("JobScheduler: job '" + name + "' depends on unknown job");
+    }
+    jobs[dep].dependents.push_back(id);
+    ++job.pendingDeps;
+  }
+  return id;
+}
+
+void Build::JobScheduler::onFinish(FinishFunc func) {
+  finishFuncs.push_back(std::move(func));
+}
+
+bool Build::JobScheduler::run()
+{
+  typedef std::chrono::steady_clock Clock;
+
+  std::mutex mtx{};
+  std::condition_variable cv{};
+  std::deque<uint32_t> ready{};
+  uint32_t remaining = jobs.size();
+  bool failed = false;
+
+  // FIFO, so jobs without dependencies start in the order they were added
+  for(uint32_t i=0; i<jobs.size(); ++i) {
+    if(jobs[i].pendingDeps == 0)ready.push_back(i);
+  }
+
+  auto worker = [&]()
+  {
+    isWorkerThread = true;
+    std::unique_lock lock{mtx};
+    for(;;)
+    {
+      cv.wait(lock, [&]{ return failed || remaining == 0 || !ready.empty(); });
+      if(failed || remaining == 0)return;
+
+      uint32_t id = ready.front();
+      ready.pop_front();
+      auto &job = jobs[id];
+
+      lock.unlock();
+      auto timeStart = Clock::now();
+      bool success = false;
+      try {
+        success = job.func();
+      } catch(const std::exception &e) {
+        Utils::Logger::log("Job '" + job.name + "' failed: " + e.what(), Utils::Logger::LEVEL_ERROR);
+      }
+      job.timeUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - timeStart).count();
+      lock.lock();
+
+      --remaining;
+      if(success) {
+        Utils::Logger::log("Job done (" + formatMs(job.timeUs) + "): " + job.name);
+        for(auto dep : job.dependents) {
+          if(--jobs[dep].pendingDeps == 0)ready.push_back(dep);
+        }
+      } else {
+        Utils::Logger::log("Job failed: " + job.name, Utils::Logger::LEVEL_ERROR);
+        failed = true;
+      }
+      cv.notify_all();
+    }
+  };
+
+  auto timeStart = Clock::now();
+  uint32_t workerCount = std::min(threadCount, (uint32_t)jobs.size());
+  if(workerCount > 0)
+  {
+    std::vector<std::thread> threads{};
+    threads.reserve(workerCount);
+    for(uint32_t i=0; i<workerCount; ++i) {
+      threads.emplace_back(worker);
+    }
+    for(auto &t : threads)t.join();
+
+    auto timeTotal = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - timeStart).count();
+    uint64_t timeJobs = 0;
+    for(auto &job : jobs)timeJobs += job.timeUs;
+
+    Utils::Logger::log(
+      "Jobs: " + std::to_string(jobs.size()) + " in " + formatMs(timeTotal)
+      + " (" + formatMs(timeJobs) + " total, " + std::to_string(workerCount) + " threads)"
+    );
+  }
+
+  jobs.clear();
+  auto funcs = std::move(finishFuncs);
+  finishFuncs.clear();
+
+  if(failed)return false;
+  for(auto &func : funcs)func();
+  return true;
+}
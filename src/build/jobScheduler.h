@@ -0,0 +1,81 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace Build
+{
+  /**
+   * Runs independent build steps (asset conversions, external tools) on a worker pool.
+   * A job may depend on previously added jobs, and will only start once all of them succeeded.
+   *
+   * Jobs must only touch their own output, anything that needs a stable order
+   * (e.g. 'SceneCtx::files') has to be done when adding the job or in an 'onFinish' callback.
+   */
+  class JobScheduler
+  {
+    public:
+      typedef std::function<bool()> JobFunc;
+      typedef std::function<void()> FinishFunc;
+
+      constexpr static uint32_t NO_JOB = 0xFFFF'FFFF;
+
+    private:
+      struct Job
+      {
+        std::string name{};
+        JobFunc func{};
+        std::vector<uint32_t> dependents{};
+        uint32_t pendingDeps{0};
+        uint64_t timeUs{0};
+      };
+
+      std::vector<Job> jobs{};
+      std::vector<FinishFunc> finishFuncs{};
+      uint32_t threadCount{0};
+
+    public:
+      /**
+       * @param threadCount worker count, 0 to use all hardware threads
+       */
+      explicit JobScheduler(uint32_t threadCount = 0);
+
+      /**
+       * Queues a job, nothing is executed until 'run()' is called.
+       * @param name name used in the log and timing report
+       * @param func job, returns false on failure
+       * @param deps IDs of jobs that must finish first, 'NO_JOB' entries are ignored
+       * @return ID of the new job
+       */
+      uint32_t add(const std::string &name, JobFunc func, std::initializer_list<uint32_t> deps = {});
+
+      /**
+       * Callback executed on the calling thread after all jobs succeeded.
+       * Callbacks run in the order they were added.
+       */
+      void onFinish(FinishFunc func);
+
+      /**
+       * Runs all queued jobs and waits for them to finish.
+       * After a failure no new jobs are started, already running ones are awaited.
+       * @return true if all jobs succeeded
+       */
+      bool run();
+
+      /**
+       * Threads a build step may use for its own parallel work.
+       * Inside a job this is 1, since the workers already keep every core busy with one job each.
+       * Outside of a job (e.g. from the CLI or tests) all hardware threads are available.
+       */
+      static uint32_t getThreadBudget();
+
+      [[nodiscard]] uint32_t getJobCount() const { return jobs.size(); }
+      [[nodiscard]] uint32_t getThreadCount() const { return threadCount; }
+  };
+}
@@ -31,7 +31,7 @@ bool Build::buildNodeGraphAssets(Project::Project &project, SceneCtx &sceneCtx)
     sceneCtx.files.push_back(Utils::FS::toUnixPath(asset.outPath));
     sceneCtx.graphFunctions.push_back(asset.getUUID());
 
-    if(!assetBuildNeeded(asset, outPath) && fs::exists(sourceOutPath))continue;
+    if(!assetBuildNeeded(sceneCtx, asset, outPath, "graph") && fs::exists(sourceOutPath))continue;
 
     auto json = Utils::FS::loadTextFile(asset.path);
     Project::Graph::Graph graph{};
@@ -46,6 +46,7 @@ bool Build::buildNodeGraphAssets(Project::Project &project, SceneCtx &sceneCtx)
     binFile.writeToFile(outPath);
 
     Utils::FS::saveTextFile(sourceOutPath, sourceCode);
+    sceneCtx.buildCache.store(outPath);
   }
   return true;
 }
\ No newline at end of file
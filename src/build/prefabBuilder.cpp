@@ -25,7 +25,8 @@ bool Build::buildPrefabAssets(Project::Project &project, SceneCtx &sceneCtx)
     fs::create_directories(outPath.parent_path());
 
     sceneCtx.files.push_back(Utils::FS::toUnixPath(asset.outPath));
-    if(!assetBuildNeeded(asset, outPath))continue;
+    // object data references assets by index, so any change to the asset table needs a rebuild
+    if(!assetBuildNeeded(sceneCtx, asset, outPath, "prefab\n" + sceneCtx.assetFileMap))continue;
 
     //printf("Prefab: %s -> %s\n", asset.path.c_str(), outPath.string().c_str());
 
@@ -33,6 +34,7 @@ bool Build::buildPrefabAssets(Project::Project &project, SceneCtx &sceneCtx)
     writeObject(sceneCtx, asset.prefab->obj, true);
     sceneCtx.fileObj.writeToFile(outPath);
     sceneCtx.fileObj = {};
+    sceneCtx.buildCache.store(outPath);
   }
   return true;
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "../utils/proc.h"
 #include "../utils/string.h"
 #include "../utils/textureFormats.h"
+#include "tools/assetCompress.h"
 
 namespace fs = std::filesystem;
 using AT = Project::FileType;
@@ -106,6 +107,7 @@ bool Build::buildProject(const std::string &configPath)
   SceneCtx sceneCtx{};
   sceneCtx.toolchain.scan();
   sceneCtx.project = &project;
+  sceneCtx.buildCache.load(path);
 
   // Global project config
   sceneCtx.files.push_back("filesystem/p64/conf");
@@ -179,6 +181,14 @@ bool Build::buildProject(const std::string &configPath)
     }
   }
 
+  // builders only queue up conversions, run them all at once here
+  bool jobsSuccess = sceneCtx.jobs.run();
+  sceneCtx.buildCache.save();
+  if(!jobsSuccess) {
+    Utils::Logger::log("Asset build failed!", Utils::Logger::LEVEL_ERROR);
+    return false;
+  }
+
   auto assetTableCode = Utils::replaceAll(
     Utils::FS::loadTextFile("data/scripts/assetTable.h"),
     "{{ASSET_MAP}}", sceneCtx.assetFileMap
@@ -263,8 +273,17 @@ bool Build::cleanProject(const Project::Project &project, const CleanArgs &args)
   if(args.assets) {
     fs::remove_all(projPath / "filesystem");
   }
-  if(args.code) {
-    fs::remove_all(projPath / "build");
+  if(args.code)
+  {
+    // the asset cache is content-based and stays valid, only drop it on a full clean
+    auto buildPath = projPath / "build";
+    if(args.assets || !fs::exists(buildPath)) {
+      fs::remove_all(buildPath);
+    } else {
+      for(auto &entry : fs::directory_iterator{buildPath}) {
+        if(entry.path().filename() != ".p64cache")fs::remove_all(entry.path());
+      }
+    }
   }
   if(args.engine) {
     fs::remove_all(projPath / "engine" / "build");
@@ -274,14 +293,26 @@ bool Build::cleanProject(const Project::Project &project, const CleanArgs &args)
 }
 
 
-bool Build::assetBuildNeeded(const Project::AssetManagerEntry &asset, const fs::path &outPath)
+bool Build::assetBuildNeeded(SceneCtx &sceneCtx, const Project::AssetManagerEntry &asset, const fs::path &outPath, const std::string &toolArgs)
 {
-  auto ageSrc = Utils::FS::getFileAge(asset.path);
-  auto ageDst = Utils::FS::getFileAge(outPath);
-  if(ageSrc < ageDst) {
-    //Utils::Logger::log("Skipping Asset (up to date): " + asset.outPath);
+  auto settings = asset.conf.serialize() + "\n"
+    + sceneCtx.toolchain.getState().installedLibdragonCommit + "\n"
+    + toolArgs;
+
+  return sceneCtx.buildCache.check(outPath, asset.path, settings);
+}
+
+bool Build::compressAsset(SceneCtx &sceneCtx, const fs::path &path, int level)
+{
+  if(AssetCompress::isNative()) {
+    if(AssetCompress::compressFile(path, level))return true;
+    Utils::Logger::log("Failed to compress asset: " + path.string(), Utils::Logger::LEVEL_ERROR);
     return false;
   }
-  Utils::Logger::log("Building Asset: " + asset.path);
-  return true;
+
+  fs::path mkAsset = fs::path{sceneCtx.project->conf.pathN64Inst} / "bin" / "mkasset";
+  std::string cmd = mkAsset.string() + " -c " + std::to_string(level);
+  cmd += " -o \"" + path.parent_path().string() + "\"";
+  cmd += " \"" + path.string() + "\"";
+  return sceneCtx.toolchain.runCmdSyncLogged(cmd, true);
 }
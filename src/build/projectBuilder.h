@@ -12,7 +12,18 @@ namespace Build
   typedef bool(*BuildFunc)(Project::Project &project, SceneCtx &sceneCtx);
 
   // helper
-  bool assetBuildNeeded(const Project::AssetManagerEntry &asset, const fs::path &outPath);
+  /**
+   * Checks the build cache if an asset needs to be (re)built, restoring cached outputs if possible.
+   * If true is returned, 'sceneCtx.buildCache.store(outPath)' must be called once the build succeeded.
+   * @param toolArgs tool and arguments used to convert the asset, part of the cache key
+   */
+  bool assetBuildNeeded(SceneCtx &sceneCtx, const Project::AssetManagerEntry &asset, const fs::path &outPath, const std::string &toolArgs = {});
+
+  /**
+   * Compresses an asset in-place, same as 'mkasset -c <level>'.
+   * Runs in-process if possible, otherwise falls back to calling mkasset.
+   */
+  bool compressAsset(SceneCtx &sceneCtx, const fs::path &path, int level);
 
   // Asset builds
   void buildScene(Project::Project &project, const Project::SceneEntry &scene, SceneCtx &ctx);
@@ -47,4 +58,6 @@ namespace Build
   );
 
   Utils::BinaryFile buildCollision(const std::string &gltfPath, float baseScale, const std::unordered_set<std::string> &meshes = {});
+  // same as above, but streams the result directly into a file
+  bool buildCollision(const fs::path &outPath, const std::string &gltfPath, float baseScale, const std::unordered_set<std::string> &meshes = {});
 }
@@ -39,17 +39,6 @@ uint32_t Build::writeObject(Build::SceneCtx &ctx, Project::Object &obj, bool sav
   if(obj.enabled)objFlags |= P64::ObjectFlags::ACTIVE;
   if(!obj.children.empty())objFlags |= P64::ObjectFlags::HAS_CHILDREN;
 
-  ctx.fileObj.write<uint16_t>(objFlags); // @TODO type
-  ctx.fileObj.write<uint16_t>(obj.id);
-  ctx.fileObj.write<uint16_t>(obj.parent ? obj.parent->id : 0);
-  ctx.fileObj.write<uint16_t>(0); // padding
-  ctx.fileObj.write(srcObj->pos.resolve(obj.propOverrides));
-  ctx.fileObj.write(srcObj->scale.resolve(obj.propOverrides));
-
-  auto &rot = srcObj->rot.resolve(obj.propOverrides);
-  uint32_t quatQuant = T3D::Quantizer::quatTo32Bit({rot.x, rot.y, rot.z, rot.w});
-  ctx.fileObj.write(quatQuant);
-
   // DATA
   auto saveComp = [&ctx, &obj](Project::Component::Entry &comp) {
     auto compPos = ctx.fileObj.getPos();
@@ -95,6 +84,17 @@ uint32_t Build::writeObject(Build::SceneCtx &ctx, Project::Object &obj, bool sav
     }
   );
 
+  ctx.fileObj.write<uint16_t>(objFlags); // @TODO type
+  ctx.fileObj.write<uint16_t>(obj.id);
+  ctx.fileObj.write<uint16_t>(obj.parent ? obj.parent->id : 0);
+  ctx.fileObj.write<uint16_t>(compList.size());
+  ctx.fileObj.write(srcObj->pos.resolve(obj.propOverrides));
+  ctx.fileObj.write(srcObj->scale.resolve(obj.propOverrides));
+
+  auto &rot = srcObj->rot.resolve(obj.propOverrides);
+  uint32_t quatQuant = T3D::Quantizer::quatTo32Bit({rot.x, rot.y, rot.z, rot.w});
+  ctx.fileObj.write(quatQuant);
+
   for(auto &comp : compList) {
     saveComp(*comp);
   }
@@ -5,6 +5,8 @@
 #pragma once
 #include <vector>
 
+#include "buildCache.h"
+#include "jobScheduler.h"
 #include "stringTable.h"
 #include "../utils/binaryFile.h"
 #include "../utils/toolchain.h"
@@ -24,6 +26,8 @@ namespace Build
   struct SceneCtx
   {
     Utils::Toolchain toolchain{};
+    JobScheduler jobs{};
+    BuildCache buildCache{};
     Project::Project *project{};
     Project::Scene *scene{};
     std::vector<std::string> files{};
@@ -4,6 +4,7 @@
 */
 #include "projectBuilder.h"
 #include "../utils/string.h"
+#include <algorithm>
 #include <filesystem>
 
 #include "../utils/binaryFile.h"
@@ -14,6 +15,29 @@
 
 namespace fs = std::filesystem;
 
+namespace
+{
+  // search for all files containing *.sdata belonging to a model
+  std::vector<fs::path> findStreamingFiles(const fs::path &t3dmPath, const fs::path &t3dmDir)
+  {
+    std::vector<fs::path> res{};
+    auto fileName = t3dmPath.stem().string();
+    for (const auto &entry : fs::directory_iterator{t3dmDir}) {
+      if (entry.is_regular_file()) {
+        auto path = entry.path();
+        auto name = entry.path().filename();
+
+        if (path.extension() == ".sdata" && name.string().starts_with(fileName)) {
+          res.push_back(path);
+        }
+      }
+    }
+    // directory order is not guaranteed
+    std::sort(res.begin(), res.end());
+    return res;
+  }
+}
+
 bool Build::buildT3DCollision(
   Project::Project &project, SceneCtx &sceneCtx,
   const std::unordered_set<std::string> &meshes,
@@ -40,32 +64,35 @@ bool Build::buildT3DCollision(
   };
   entry.conf.uuid = newUUID;
 
-  printf("Building T3DM Collision: %s\n", outPath.string().c_str());
-  //printf(" asset: %d | %d\n", sceneCtx.files.size(), sceneCtx.assetUUIDToIdx.size());
-
-  auto collData = Build::buildCollision(model->path, model->conf.baseScale, meshes);
-  collData.writeToFile(outPath.string());
-
-  fs::path mkAsset = fs::path{project.conf.pathN64Inst} / "bin" / "mkasset";
-  std::string cmd = mkAsset.string() + " -c 1";;
-  cmd += " -o \"" + outPath.parent_path().string() + "\"";
-  cmd += " \"" + outPath.string() + "\"";
-
-  if(!sceneCtx.toolchain.runCmdSyncLogged(cmd)) {
-    return false;
-  }
+  // the same collision file is shared by all instances using this mesh selection
+  std::vector<std::string> meshesSorted{meshes.begin(), meshes.end()};
+  std::sort(meshesSorted.begin(), meshesSorted.end());
+  auto toolArgs = "collision\n" + std::to_string(model->conf.baseScale) + "\n" + Utils::join(meshesSorted, "\n");
 
   sceneCtx.addAsset(entry);
+  if(!assetBuildNeeded(sceneCtx, entry, outPath, toolArgs))return true;
+
+  sceneCtx.jobs.add("T3DM Collision: " + model->name, [&sceneCtx, model, meshes, outPath]()
+  {
+    printf("Building T3DM Collision: %s\n", outPath.string().c_str());
+    if(!Build::buildCollision(outPath, model->path, model->conf.baseScale, meshes))return false;
+    if(!compressAsset(sceneCtx, outPath, 1))return false;
+    sceneCtx.buildCache.store(outPath);
+    return true;
+  });
 
   return true;
 }
 
 bool Build::buildT3DMAssets(Project::Project &project, SceneCtx &sceneCtx)
 {
-  fs::path mkAsset = fs::path{project.conf.pathN64Inst} / "bin" / "mkasset";
   auto &models = sceneCtx.project->getAssets().getTypeEntries(Project::FileType::MODEL_3D);
   auto projectPath = fs::path{project.getPath()};
 
+  // the glTF parser works on global state (e.g. 'T3DM::config'),
+  // so models are parsed one after another while everything else runs in parallel
+  uint32_t lastParseJob = JobScheduler::NO_JOB;
+
   for (auto &model : models)
   {
     auto t3dmPath = projectPath / model.outPath;
@@ -73,58 +100,56 @@ bool Build::buildT3DMAssets(Project::Project &project, SceneCtx &sceneCtx)
 
     sceneCtx.files.push_back(Utils::FS::toUnixPath(model.outPath));
 
-    if(assetBuildNeeded(model, t3dmPath)) {
+    if(assetBuildNeeded(sceneCtx, model, t3dmPath, "t3dm")) {
       fs::create_directories(t3dmDir);
 
-      T3DM::config = {
-        .globalScale = (float)model.conf.baseScale,
-        .animSampleRate = 60,
-        //.ignoreMaterials = args.checkArg("--ignore-materials"),
-        //.ignoreTransforms = args.checkArg("--ignore-transforms"),
-        .createBVH = model.conf.gltfBVH,
-        .verbose = false,
-        .assetPath = "assets/",
-        .assetPathFull = fs::absolute(project.getPath() + "/assets").string(),
-      };
-
-      auto t3dm = T3DM::parseGLTF(model.path.c_str());
-
-      std::vector<T3DM::CustomChunk> customChunks{};
-
-      if(model.conf.gltfCollision.value) {
-        customChunks.emplace_back('0', buildCollision(model.path, T3DM::config.globalScale).getData());
-      }
+      lastParseJob = sceneCtx.jobs.add("T3DM: " + model.name, [&project, &model, t3dmPath, projectPath]()
+      {
+        // the editor may be parsing models in the background at the same time
+        std::lock_guard lock{Project::AssetManager::getParserMutex()};
+        T3DM::config = {
+          .globalScale = (float)model.conf.baseScale,
+          .animSampleRate = 60,
+          //.ignoreMaterials = args.checkArg("--ignore-materials"),
+          //.ignoreTransforms = args.checkArg("--ignore-transforms"),
+          .createBVH = model.conf.gltfBVH,
+          .verbose = false,
+          .assetPath = "assets/",
+          .assetPathFull = fs::absolute(project.getPath() + "/assets").string(),
+        };
+
+        auto t3dm = T3DM::parseGLTF(model.path.c_str());
+
+        std::vector<T3DM::CustomChunk> customChunks{};
+
+        if(model.conf.gltfCollision.value) {
+          customChunks.emplace_back('0', buildCollision(model.path, T3DM::config.globalScale).getData());
+        }
 
-      T3DM::writeT3DM(t3dm, t3dmPath.string().c_str(), projectPath, customChunks);
+        T3DM::writeT3DM(t3dm, t3dmPath.string().c_str(), projectPath, customChunks);
+        return true;
+      }, {lastParseJob});
 
       int compr = (int)model.conf.compression - 1;
       if(compr < 0)compr = 1; // @TODO: pull default compression level
 
-      std::string cmd = mkAsset.string() + " -c " + std::to_string(compr);
-      cmd += " -o \"" + t3dmDir.string() + "\"";
-      cmd += " \"" + t3dmPath.string() + "\"";
-
-      if(!sceneCtx.toolchain.runCmdSyncLogged(cmd)) {
-        return false;
-      }
+      sceneCtx.jobs.add("Compress: " + model.name, [&sceneCtx, compr, t3dmPath, t3dmDir]()
+      {
+        if(!compressAsset(sceneCtx, t3dmPath, compr))return false;
+        sceneCtx.buildCache.store(t3dmPath, findStreamingFiles(t3dmPath, t3dmDir));
+        return true;
+      }, {lastParseJob});
     }
 
-    // search for all files containing *.sdata
-    for (const auto &entry : fs::directory_iterator{t3dmDir}) {
-      if (entry.is_regular_file()) {
-        auto path = entry.path();
-        auto name = entry.path().filename();
-
-        if (path.extension() == ".sdata") {
-          auto fileName = t3dmPath.stem().string();
-          if (name.string().starts_with(fileName)) {
-            // path relative to project
-            auto relPath = fs::relative(path, projectPath).string();
-            sceneCtx.files.push_back(Utils::FS::toUnixPath(relPath));
-          }
-        }
+    // streaming data only exists once the model is converted
+    sceneCtx.jobs.onFinish([&sceneCtx, t3dmPath, t3dmDir, projectPath]()
+    {
+      for (const auto &path : findStreamingFiles(t3dmPath, t3dmDir)) {
+        // path relative to project
+        auto relPath = fs::relative(path, projectPath).string();
+        sceneCtx.files.push_back(Utils::FS::toUnixPath(relPath));
       }
-    }
+    });
   }
   return true;
 }
\ No newline at end of file
@@ -36,14 +36,20 @@ bool Build::buildTextureAssets(Project::Project &project, SceneCtx &sceneCtx)
     auto assetDir = assetPath.parent_path();
     fs::create_directories(assetDir);
 
-    if(!assetBuildNeeded(image, assetPath.string()))continue;
+    bool isBCI = image.conf.format == (int)Utils::TexFormat::BCI_256;
+    auto toolArgs = isBCI ? ("bci" + std::to_string(BCI::ENCODER_VERSION)) : std::string{"mksprite"};
+    if(!assetBuildNeeded(sceneCtx, image, assetPath, toolArgs))continue;
 
     int compr = (int)image.conf.compression - 1;
     if(compr < 0)compr = 1; // @TODO: pull default compression level
 
-    if(image.conf.format == (int)Utils::TexFormat::BCI_256)
+    if(isBCI)
     {
-      BCI::convertPNG(image.path, assetPath.string());
+      sceneCtx.jobs.add("BCI: " + image.name, [&sceneCtx, &image, assetPath]() {
+        if(!BCI::convertPNG(image.path, assetPath.string()))return false;
+        sceneCtx.buildCache.store(assetPath);
+        return true;
+      });
     } else {
       std::string cmd = mkSprite.string() + " -c " + std::to_string(compr);
       if (image.conf.format != 0) {
@@ -52,9 +58,11 @@ bool Build::buildTextureAssets(Project::Project &project, SceneCtx &sceneCtx)
       cmd += " -o \"" + assetDir.string() + "\"";
       cmd += " \"" + image.path + "\"";
 
-      if(!sceneCtx.toolchain.runCmdSyncLogged(cmd)) {
-        return false;
-      }
+      sceneCtx.jobs.add("mksprite: " + image.name, [&sceneCtx, cmd, assetPath]() {
+        if(!sceneCtx.toolchain.runCmdSyncLogged(cmd, true))return false;
+        sceneCtx.buildCache.store(assetPath);
+        return true;
+      });
     }
   }
   return true;
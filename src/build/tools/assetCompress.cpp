@@ -0,0 +1,57 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "assetCompress.h"
+#include <mutex>
+
+#ifdef P64_NATIVE_ASSETCOMP
+  extern "C" {
+    #include "tools/common/assetcomp.h"
+  }
+#endif
+
+namespace
+{
+  /**
+   * The compressors come from CLI tools ('mkasset') which never needed to be reentrant.
+   * LZ4 (1) and aPLib (2) keep all their state in the call, so they can run on all build workers at once.
+   * Shrinkler (3) is not known to be safe and is serialized.
+   * 'tests/assetcomp' compresses concurrently with every level marked as reentrant and compares against
+   * single-threaded output, so a compressor update breaking this gets caught.
+   */
+  constexpr bool LEVEL_REENTRANT[Build::AssetCompress::LEVEL_MAX + 1] = {true, true, true, false};
+  std::mutex mtxLevel[Build::AssetCompress::LEVEL_MAX + 1]{};
+}
+
+bool Build::AssetCompress::isNative()
+{
+  #ifdef P64_NATIVE_ASSETCOMP
+    return true;
+  #else
+    return false;
+  #endif
+}
+
+bool Build::AssetCompress::isReentrant(int level)
+{
+  return level >= 0 && level <= LEVEL_MAX && LEVEL_REENTRANT[level];
+}
+
+bool Build::AssetCompress::compressFile(const fs::path &path, int level, int winSize)
+{
+  if(level < 0 || level > LEVEL_MAX)return false;
+  if(level == 0)return fs::exists(path);
+
+  #ifdef P64_NATIVE_ASSETCOMP
+    // same as mkasset, which reads the whole input before writing to the (same) output file
+    auto pathStr = path.string();
+    if(LEVEL_REENTRANT[level]) {
+      return asset_compress(pathStr.c_str(), pathStr.c_str(), level, winSize);
+    }
+    std::lock_guard lock{mtxLevel[level]};
+    return asset_compress(pathStr.c_str(), pathStr.c_str(), level, winSize);
+  #else
+    return false;
+  #endif
+}
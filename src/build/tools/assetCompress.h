@@ -0,0 +1,36 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace Build::AssetCompress
+{
+  constexpr int LEVEL_MAX = 3;
+
+  /**
+   * True if libdragon's asset compressor is compiled into the editor.
+   * Otherwise callers have to fall back to running 'mkasset'.
+   */
+  bool isNative();
+
+  /**
+   * True if files with this level can be compressed from multiple threads at once.
+   * 'compressFile' handles the locking itself, this is only informational (and used by tests).
+   */
+  bool isReentrant(int level);
+
+  /**
+   * Compresses a file in-place into libdragon's asset container ("DCA"),
+   * using the same code as 'mkasset -c <level>' ('tests/assetcomp' verifies the output is identical).
+   *
+   * @param path file to compress
+   * @param level compression level (0-3), 0 leaves the file as is
+   * @param winSize window size in bytes, 0 for the default of the level
+   * @return false on error, or if no native compressor is available
+   */
+  bool compressFile(const fs::path &path, int level, int winSize = 0);
+}
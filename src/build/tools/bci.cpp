@@ -3,29 +3,37 @@
 * @license MIT
 */
 #include "bci.h"
-#include <filesystem>
-#include <vector>
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
-#include <limits>
-#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
 #include "lodepng.h"
-
-using namespace std;
+#include "../../utils/logger.h"
+#include "../jobScheduler.h"
 
 namespace
 {
+  // 4 lanes of int32, maps to SSE2 on x86-64 and NEON on ARM64 (GCC/Clang vector extension)
+  typedef int32_t VecI32 __attribute__((vector_size(16)));
+
+  constexpr int LANES = 4;
+  constexpr int PIXELS = 16;
+  constexpr int VEC_COUNT = PIXELS / LANES;
+  constexpr int PALETTE_SIZE = 4;
+  constexpr int MAX_ITERATIONS = 100;
+  constexpr uint32_t BLOCK_BYTES = 4*2 + 8; // palette (4x RGBA5551) + indices
+
+  constexpr VecI32 splat(int32_t val) {
+    return VecI32{val, val, val, val};
+  }
+
   struct Color {
-    int r, g, b;
-    Color operator+(const Color& other) const {
-      return {r + other.r, g + other.g, b + other.b};
-    }
-    Color operator/(int val) const {
-      return {r / val, g / val, b / val};
-    }
-    double distance(const Color& other) const {
-      return sqrt(pow(r - other.r, 2) + pow(g - other.g, 2) + pow(b - other.b, 2));
-    }
+    int32_t r, g, b;
+
     bool operator==(const Color&other) const {
       return r == other.r && g == other.g && b == other.b;
     }
@@ -34,167 +42,252 @@ namespace
        |     ((g << 3) & 0b00000'11111'00000'0)
        |     ((b >> 2) & 0b00000'00000'11111'0);
     }
+    // color as seen on hardware after the RGBA5551 conversion
+    Color quantized() const {
+      return {(r & 0xF8) | (r >> 5), (g & 0xF8) | (g >> 5), (b & 0xF8) | (b >> 5)};
+    }
   };
 
-  using Block = array<Color, 16>;  // 4x4 block of pixels
-  using Palette = array<Color, 4>; // 4-color palette
-  using Indices = array<int, 16>;  // Indices for each pixel in the block
+  // 4x4 block of pixels, stored per channel to process 4 pixels at once
+  struct Block {
+    VecI32 r[VEC_COUNT];
+    VecI32 g[VEC_COUNT];
+    VecI32 b[VEC_COUNT];
 
-  // Initialize K-means with random colors from the block
-  void initialize_palette(const Block& block, Palette& palette) {
-    for (int i = 0; i < 4; ++i) {
-      palette[i] = block[rand() % 16];
+    Color get(int i) const {
+      return {r[i / LANES][i % LANES], g[i / LANES][i % LANES], b[i / LANES][i % LANES]};
     }
+  };
+
+  using Palette = std::array<Color, PALETTE_SIZE>;
+  using Indices = std::array<int32_t, PIXELS>;
+
+  // Squared distance of 4 pixels to a color
+  VecI32 distSq(const Block& block, int v, const Color& c) {
+    VecI32 dr = block.r[v] - splat(c.r);
+    VecI32 dg = block.g[v] - splat(c.g);
+    VecI32 db = block.b[v] - splat(c.b);
+    return dr*dr + dg*dg + db*db;
   }
 
-  // Assign each pixel to the nearest palette color
-  Indices assign_clusters(const Block& block, const Palette& palette) {
-    Indices assignments;
-    for (int i = 0; i < 16; ++i) {
-      double min_dist = numeric_limits<double>::max();
-      int best_cluster = 0;
-      for (int j = 0; j < 4; ++j) {
-        double dist = block[i].distance(palette[j]);
-        if (dist < min_dist) {
-          min_dist = dist;
-          best_cluster = j;
-        }
+  // Deterministic seed: spread the palette along the main axis of the block.
+  // The axis is approximated by the bounding box, with each channel flipped if it
+  // correlates negatively with the channel of the largest range.
+  void initPalette(const Block& block, Palette& palette) {
+    Color cMin = block.get(0);
+    Color cMax = cMin;
+    Color sum{0, 0, 0};
+    for (int i = 0; i < PIXELS; ++i) {
+      auto c = block.get(i);
+      cMin = {std::min(cMin.r, c.r), std::min(cMin.g, c.g), std::min(cMin.b, c.b)};
+      cMax = {std::max(cMax.r, c.r), std::max(cMax.g, c.g), std::max(cMax.b, c.b)};
+      sum = {sum.r + c.r, sum.g + c.g, sum.b + c.b};
+    }
+
+    std::array<int32_t Color::*, 3> channels{&Color::r, &Color::g, &Color::b};
+    auto mainCh = channels[0];
+    for (auto ch : channels) {
+      if (cMax.*ch - cMin.*ch > cMax.*mainCh - cMin.*mainCh)mainCh = ch;
+    }
+
+    Color lo = cMin;
+    Color hi = cMax;
+    for (auto ch : channels) {
+      if (ch == mainCh)continue;
+      int64_t cov = 0;
+      for (int i = 0; i < PIXELS; ++i) {
+        auto c = block.get(i);
+        cov += (int64_t)(c.*ch * PIXELS - sum.*ch) * (c.*mainCh * PIXELS - sum.*mainCh);
       }
-      assignments[i] = best_cluster;
+      if (cov < 0)std::swap(lo.*ch, hi.*ch);
+    }
+
+    for (int i = 0; i < PALETTE_SIZE; ++i) {
+      palette[i] = {
+        lo.r + (hi.r - lo.r) * i / (PALETTE_SIZE-1),
+        lo.g + (hi.g - lo.g) * i / (PALETTE_SIZE-1),
+        lo.b + (hi.b - lo.b) * i / (PALETTE_SIZE-1),
+      };
+    }
+  }
+
+  // Assign each pixel to the nearest palette color, ties go to the lower index
+  void assignClusters(const Block& block, const Palette& palette, Indices& indices) {
+    for (int v = 0; v < VEC_COUNT; ++v) {
+      VecI32 bestDist = distSq(block, v, palette[0]);
+      VecI32 bestIdx = splat(0);
+      for (int j = 1; j < PALETTE_SIZE; ++j) {
+        VecI32 dist = distSq(block, v, palette[j]);
+        VecI32 mask = dist < bestDist; // all bits set if closer
+        bestDist = (dist & mask) | (bestDist & ~mask);
+        bestIdx = (splat(j) & mask) | (bestIdx & ~mask);
+      }
+      memcpy(&indices[v * LANES], &bestIdx, sizeof(bestIdx));
     }
-    return assignments;
   }
 
   // Update palette colors based on assignments
-  void update_palette(const Block& block, Palette& palette, const Indices& assignments) {
-    array<Color, 4> new_colors = {};
-    array<int, 4> counts = {};
+  void updatePalette(const Block& block, Palette& palette, const Indices& indices) {
+    std::array<Color, PALETTE_SIZE> sums{};
+    std::array<int32_t, PALETTE_SIZE> counts{};
 
-    for (int i = 0; i < 16; ++i) {
-      int cluster = assignments[i];
-      new_colors[cluster] = new_colors[cluster] + block[i];
-      counts[cluster]++;
+    for (int i = 0; i < PIXELS; ++i) {
+      auto c = block.get(i);
+      auto &s = sums[indices[i]];
+      s = {s.r + c.r, s.g + c.g, s.b + c.b};
+      counts[indices[i]]++;
     }
 
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < PALETTE_SIZE; ++i) {
       if (counts[i] > 0) {
-        palette[i] = new_colors[i] / counts[i];
+        palette[i] = {sums[i].r / counts[i], sums[i].g / counts[i], sums[i].b / counts[i]};
       }
     }
   }
 
   // K-means clustering to generate a 4-color palette and indices
-  pair<Palette, Indices> kmeansPalette(const Block& block, int max_iters = 100) {
-    Palette palette;
-    initialize_palette(block, palette);
-    Indices assignments;
+  void kmeansPalette(const Block& block, Palette& palette, Indices& indices) {
+    initPalette(block, palette);
 
-    for (int iter = 0; iter < max_iters; ++iter) {
-      assignments = assign_clusters(block, palette);
-      Palette new_palette = palette;
-      update_palette(block, new_palette, assignments);
+    for (int iter = 0; iter < MAX_ITERATIONS; ++iter) {
+      assignClusters(block, palette, indices);
+      Palette newPalette = palette;
+      updatePalette(block, newPalette, indices);
 
-      if (palette == new_palette) break; // Converged
-      palette = new_palette;
+      if (palette == newPalette) break; // Converged
+      palette = newPalette;
     }
-
-    return {palette, assignments};
   }
-}
 
-bool Build::BCI::convertPNG(const std::string &pathInPNG, const std::string &pathOutBCI)
-{
-  vector<unsigned char> image;
-  unsigned width, height;
+  // returns the squared error (sum over all channels) of the encoded block
+  uint64_t encodeBlock(const Block& block, uint8_t* out)
+  {
+    Palette palette;
+    Indices indices;
+    kmeansPalette(block, palette, indices);
 
-  auto *pFile = fopen(pathOutBCI.c_str(), "wb");
+    // Note: the first index must be 0b00 or 0b01 due to runtime opt.
+    // If that is not the case, swap the colors and indices
+    if(indices[15] != 0) {
+      auto replA = indices[15];
+      std::swap(palette[replA], palette[0]);
 
-  auto writeU16 = [pFile](uint16_t val) {
-    uint8_t high = (val >> 8) & 0xFF;
-    uint8_t low = val & 0xFF;
-    fwrite(&high, 1, 1, pFile);
-    fwrite(&low, 1, 1, pFile);
-  };
-  auto writeU8 = [pFile](uint8_t val) {
-    fwrite(&val, 1, 1, pFile);
-  };
-  auto writeU32 = [pFile](uint32_t val) {
-    uint8_t b0 = (val >> 24) & 0xFF;
-    uint8_t b1 = (val >> 16) & 0xFF;
-    uint8_t b2 = (val >> 8) & 0xFF;
-    uint8_t b3 = val & 0xFF;
-    fwrite(&b0, 1, 1, pFile);
-    fwrite(&b1, 1, 1, pFile);
-    fwrite(&b2, 1, 1, pFile);
-    fwrite(&b3, 1, 1, pFile);
-  };
-  auto writeU64 = [pFile](uint64_t val) {
-    uint8_t b0 = (val >> 56) & 0xFF;
-    uint8_t b1 = (val >> 48) & 0xFF;
-    uint8_t b2 = (val >> 40) & 0xFF;
-    uint8_t b3 = (val >> 32) & 0xFF;
-    uint8_t b4 = (val >> 24) & 0xFF;
-    uint8_t b5 = (val >> 16) & 0xFF;
-    uint8_t b6 = (val >> 8) & 0xFF;
-    uint8_t b7 = val & 0xFF;
-    fwrite(&b0, 1, 1, pFile);
-    fwrite(&b1, 1, 1, pFile);
-    fwrite(&b2, 1, 1, pFile);
-    fwrite(&b3, 1, 1, pFile);
-    fwrite(&b4, 1, 1, pFile);
-    fwrite(&b5, 1, 1, pFile);
-    fwrite(&b6, 1, 1, pFile);
-    fwrite(&b7, 1, 1, pFile);
-  };
+      for(uint32_t i=0; i<PIXELS; ++i) {
+        if(indices[i] == replA)indices[i] = 0;
+        else if(indices[i] == 0)indices[i] = replA;
+      }
+    }
 
-  unsigned error = lodepng::decode(image, width, height, pathInPNG);
-  if (error) {
-    cerr << "PNG loading error: " << lodepng_error_text(error) << endl;
-    return false;
+    for(int i=0; i<PALETTE_SIZE; ++i) {
+      uint16_t col = palette[i].toRGBA555();
+      *out++ = col >> 8;
+      *out++ = col & 0xFF;
+    }
+
+    uint64_t packedIndex = 0;
+    for(int i=0; i<PIXELS; ++i) {
+      packedIndex <<= 2;
+      packedIndex |= indices[15-i];
+    }
+    packedIndex <<= 33;
+    for(int i=7; i>=0; --i) {
+      *out++ = (packedIndex >> (i*8)) & 0xFF;
+    }
+
+    uint64_t err = 0;
+    for(int i=0; i<PIXELS; ++i) {
+      auto c = block.get(i);
+      auto p = palette[indices[i]].quantized();
+      err += (c.r - p.r) * (c.r - p.r) + (c.g - p.g) * (c.g - p.g) + (c.b - p.b) * (c.b - p.b);
+    }
+    return err;
   }
+}
+
+std::vector<uint8_t> Build::BCI::encode(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t threadCount, double &mse)
+{
+  uint32_t blocksX = (width + 3) / 4;
+  uint32_t blocksY = (height + 3) / 4;
+  std::vector<uint8_t> output(blocksX * blocksY * BLOCK_BYTES);
+  std::vector<uint64_t> rowErrors(blocksY);
 
-  for (unsigned y = 0; y < height; y += 4) {
-    for (unsigned x = 0; x < width; x += 4) {
+  auto encodeRow = [&](uint32_t by)
+  {
+    uint8_t* out = output.data() + by * blocksX * BLOCK_BYTES;
+    uint64_t err = 0;
+    for (uint32_t bx = 0; bx < blocksX; ++bx) {
       Block block;
-      for (int i = 0; i < 16; ++i) {
-        unsigned px = x + (i % 4);
-        unsigned py = y + (i / 4);
-        if (px >= width || py >= height) continue;
+      for (int i = 0; i < PIXELS; ++i) {
+        // repeat the edge for partial blocks
+        unsigned px = std::min(bx*4 + (i % 4), width - 1);
+        unsigned py = std::min(by*4 + (i / 4), height - 1);
         unsigned index = 4 * (py * width + px);
-        block[i] = {image[index], image[index + 1], image[index + 2]};
+        block.r[i / LANES][i % LANES] = rgba[index];
+        block.g[i / LANES][i % LANES] = rgba[index + 1];
+        block.b[i / LANES][i % LANES] = rgba[index + 2];
       }
+      err += encodeBlock(block, out);
+      out += BLOCK_BYTES;
+    }
+    rowErrors[by] = err;
+  };
 
-      auto [palette, indices] = kmeansPalette(block);
-
-      // Note: the first index must be 0b00 or 0b01 due to runtime opt.
-      // If that is not the case, swap the colors and indices
-      if(indices[15] != 0) {
-        auto replA = indices[15];
+  // rows are independent and write to their own part of the output, so the result is deterministic
+  threadCount = std::clamp(threadCount, 1u, std::max(blocksY, 1u));
+  if(threadCount == 1) {
+    for(uint32_t by = 0; by < blocksY; ++by)encodeRow(by);
+  } else {
+    std::atomic_uint32_t nextRow{0};
+    std::vector<std::thread> threads{};
+    for(uint32_t t=0; t<threadCount; ++t) {
+      threads.emplace_back([&]() {
+        for(uint32_t by = nextRow++; by < blocksY; by = nextRow++) {
+          encodeRow(by);
+        }
+      });
+    }
+    for(auto &t : threads)t.join();
+  }
 
-        auto tmp = palette[replA];
-        palette[replA] = palette[0];
-        palette[0] = tmp;
+  uint64_t errSum = 0;
+  for(auto err : rowErrors)errSum += err;
+  mse = output.empty() ? 0.0 : (double)errSum / (blocksX * blocksY * PIXELS * 3);
+  return output;
+}
 
-        for(uint32_t i=0; i<16; ++i) {
-          if(indices[i] == replA)indices[i] = 0;
-          else if(indices[i] == 0)indices[i] = replA;
-        }
-      }
+double Build::BCI::getPSNR(double mse)
+{
+  if(mse <= 0.0)return INFINITY;
+  return 10.0 * log10(255.0 * 255.0 / mse);
+}
 
-      writeU16(palette[0].toRGBA555());
-      writeU16(palette[1].toRGBA555());
-      writeU16(palette[2].toRGBA555());
-      writeU16(palette[3].toRGBA555());
+bool Build::BCI::convertPNG(const std::string &pathInPNG, const std::string &pathOutBCI)
+{
+  std::vector<unsigned char> image;
+  unsigned width, height;
 
-      uint64_t packedIndex = 0;
-      for(int i=0; i<16; ++i) {
-        packedIndex <<= 2;
-        packedIndex |= indices[15-i];
-      }
-      writeU64(packedIndex << 33);
-    }
+  unsigned error = lodepng::decode(image, width, height, pathInPNG);
+  if (error) {
+    Utils::Logger::log("BCI: PNG loading error: " + std::string{lodepng_error_text(error)}, Utils::Logger::LEVEL_ERROR);
+    return false;
   }
 
+  // called from build jobs, which already run one texture per core
+  double mse = 0.0;
+  auto output = encode(image.data(), width, height, JobScheduler::getThreadBudget(), mse);
+
+  auto *pFile = fopen(pathOutBCI.c_str(), "wb");
+  if(!pFile) {
+    Utils::Logger::log("BCI: failed to open output file: " + pathOutBCI, Utils::Logger::LEVEL_ERROR);
+    return false;
+  }
+  fwrite(output.data(), 1, output.size(), pFile);
   fclose(pFile);
+
+  char psnrStr[32] = "inf";
+  if(mse > 0.0)snprintf(psnrStr, sizeof(psnrStr), "%.2f", getPSNR(mse));
+
+  Utils::Logger::log("BCI: " + pathInPNG + " (" + std::to_string(width) + "x" + std::to_string(height)
+    + ", PSNR: " + psnrStr + "dB)");
   return true;
 }
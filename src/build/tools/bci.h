@@ -3,9 +3,28 @@
 * @license MIT
 */
 #pragma once
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Build::BCI
 {
+  // bump when the encoder output changes, invalidates cached textures
+  constexpr int ENCODER_VERSION = 2;
+
+  /**
+   * Encodes RGBA8 pixels into BCI blocks, alpha is ignored.
+   * Rows of blocks are split across 'threadCount' threads, the output does not depend on it.
+   *
+   * @param mse mean squared error per channel of the result (as seen on hardware)
+   * @return encoded blocks, as written to the '.bci' file
+   */
+  std::vector<uint8_t> encode(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t threadCount, double &mse);
+
+  double getPSNR(double mse);
+
+  /**
+   * Encodes a PNG into a '.bci' file, threads are taken from 'JobScheduler::getThreadBudget'.
+   */
   bool convertPNG(const std::string &pathInPNG, const std::string &pathOutBCI);
 }
@@ -0,0 +1,269 @@
+/**
+* @copyright 2025 - Max Bebök
+* @license MIT
+*/
+#include "collisionMesh.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "glm/geometric.hpp"
+#include "../../utils/logger.h"
+#include "../../project/assets/collision.h"
+
+namespace
+{
+  // max. bits of sub-unit precision for vertices, the actual amount depends on the mesh size
+  constexpr int VERT_MAX_FRAC_BITS = 8;
+
+  // Triangles per chunk, BVH leaves store their data offset in 12 bits (signed).
+  // Chunks exceeding it, or whose BVH offsets still don't fit, are split further.
+  constexpr uint32_t MAX_CHUNK_TRIS = 0x800;
+  static_assert(MAX_CHUNK_TRIS * 3 <= 0x10000, "chunk vertices must be addressable with 16-bit indices");
+
+  // size of the container header and of one entry in the chunk table, see 'Coll::MeshChunks'
+  constexpr uint32_t CHUNK_HEADER_SIZE = 16;
+  constexpr uint32_t CHUNK_ENTRY_SIZE = 16;
+
+  /**
+   * Part of a collision mesh, written as a standalone 'Coll::Mesh' with its own BVH.
+   */
+  struct CollChunk
+  {
+    std::vector<uint16_t> indices{};
+    std::vector<uint16_t> normals{};
+    std::vector<uint32_t> vertMap{}; // chunk-local -> global vertex index
+    std::vector<int16_t> bvh{};
+  };
+
+  /**
+   * Encodes a normalized vector into 16-bit (2x int8) octahedral coordinates.
+   * Mirrors the decoding in the runtime 'Coll::Mesh::getNormal'.
+   */
+  uint16_t encodeNormalOct(const glm::vec3 &n)
+  {
+    float sum = fabsf(n[0]) + fabsf(n[1]) + fabsf(n[2]);
+    float x = n[0] / sum;
+    float y = n[1] / sum;
+    if(n[2] < 0.0f) {
+      float oldX = x;
+      x = (1.0f - fabsf(y)) * (oldX >= 0.0f ? 1.0f : -1.0f);
+      y = (1.0f - fabsf(oldX)) * (y >= 0.0f ? 1.0f : -1.0f);
+    }
+    auto qx = (int8_t)std::lround(std::clamp(x, -1.0f, 1.0f) * 127.0f);
+    auto qy = (int8_t)std::lround(std::clamp(y, -1.0f, 1.0f) * 127.0f);
+    return (uint16_t)((uint8_t)qx | ((uint8_t)qy << 8));
+  }
+
+  /**
+   * Builds a chunk from the given triangles, recursively splitting it at the median
+   * of the triangle centers along the longest axis until every part fits the runtime format.
+   */
+  void buildChunks(
+    std::vector<uint32_t> &tris,
+    const std::vector<glm::vec3> &verticesFloat,
+    const std::vector<uint32_t> &indices,
+    const std::vector<uint16_t> &normals,
+    std::vector<CollChunk> &chunks
+  )
+  {
+    if(tris.size() <= MAX_CHUNK_TRIS)
+    {
+      CollChunk chunk{};
+      std::vector<glm::i16vec3> vertices{};
+      std::unordered_map<uint32_t, uint16_t> vertRemap{};
+
+      for(auto t : tris) {
+        for(int i=0; i<3; ++i) {
+          uint32_t idx = indices[t*3 + i];
+          auto it = vertRemap.find(idx);
+          if(it == vertRemap.end()) {
+            it = vertRemap.emplace(idx, (uint16_t)chunk.vertMap.size()).first;
+            chunk.vertMap.push_back(idx);
+            auto &v = verticesFloat[idx];
+            vertices.push_back({(int16_t)v[0], (int16_t)v[1], (int16_t)v[2]});
+          }
+          chunk.indices.push_back(it->second);
+        }
+        chunk.normals.push_back(normals[t]);
+      }
+
+      try {
+        chunk.bvh = Project::Assets::Collision::createBVH(vertices, chunk.indices);
+        chunks.push_back(std::move(chunk));
+        return;
+      } catch(const std::runtime_error &) {
+        if(tris.size() < 2)throw;
+      }
+    }
+
+    auto getCenter = [&](uint32_t t) {
+      auto &a = verticesFloat[indices[t*3]];
+      auto &b = verticesFloat[indices[t*3+1]];
+      auto &c = verticesFloat[indices[t*3+2]];
+      return glm::vec3{
+        (a[0] + b[0] + c[0]) * (1.0f / 3.0f),
+        (a[1] + b[1] + c[1]) * (1.0f / 3.0f),
+        (a[2] + b[2] + c[2]) * (1.0f / 3.0f),
+      };
+    };
+
+    glm::vec3 min = getCenter(tris[0]);
+    glm::vec3 max = min;
+    for(auto t : tris) {
+      auto c = getCenter(t);
+      for(int i=0; i<3; ++i) {
+        min[i] = std::min(min[i], c[i]);
+        max[i] = std::max(max[i], c[i]);
+      }
+    }
+
+    int axis = 0;
+    for(int i=1; i<3; ++i) {
+      if((max[i] - min[i]) > (max[axis] - min[axis]))axis = i;
+    }
+
+    auto mid = tris.begin() + (tris.size() / 2);
+    std::nth_element(tris.begin(), mid, tris.end(), [&](uint32_t a, uint32_t b) {
+      return getCenter(a)[axis] < getCenter(b)[axis];
+    });
+
+    std::vector<uint32_t> trisA{tris.begin(), mid};
+    std::vector<uint32_t> trisB{mid, tris.end()};
+    buildChunks(trisA, verticesFloat, indices, normals, chunks);
+    buildChunks(trisB, verticesFloat, indices, normals, chunks);
+  }
+}
+
+void Build::CollisionMesh::write(
+  Utils::BinaryFile &file,
+  const std::vector<glm::vec3> &verticesFloat,
+  const std::vector<uint32_t> &indices
+) {
+  std::vector<uint16_t> normals{};
+
+  // generate normals
+  for(int v=0; v<indices.size(); v+=3) {
+    glm::vec3 edge1 = verticesFloat[indices[v+1]] - verticesFloat[indices[v]];
+    glm::vec3 edge2 = verticesFloat[indices[v+2]] - verticesFloat[indices[v]];
+    glm::vec3 edge3 = verticesFloat[indices[v+2]] - verticesFloat[indices[v]];
+
+    if(glm::length(edge1) < 0.01f || glm::length(edge2) < 0.01f || glm::length(edge3) < 0.01f) {
+      printf("Degenerate triangle:\nA: %.4f %.4f %.4f\nB: %.4f %.4f %.4f\nC: %.4f %.4f %.4f\n",
+        verticesFloat[indices[v]][0], verticesFloat[indices[v]][1], verticesFloat[indices[v]][2],
+        verticesFloat[indices[v+1]][0], verticesFloat[indices[v+1]][1], verticesFloat[indices[v+1]][2],
+        verticesFloat[indices[v+2]][0], verticesFloat[indices[v+2]][1], verticesFloat[indices[v+2]][2]
+      );
+      printf("Indices: %u %u %u\n", indices[v], indices[v+1], indices[v+2]);
+      throw std::runtime_error("Degenerate triangle!");
+    }
+
+    glm::vec3 normal = glm::cross(edge1, edge2);
+    normal = normal * (1.0f / glm::length(normal));
+    normals.push_back(encodeNormalOct(normal));
+  }
+
+  assert(indices.size() % 3 == 0);
+
+  // vertices are stored as fixed-point, use as many fractional bits as the mesh size allows
+  float maxAbs = 0.0f;
+  for(auto &v : verticesFloat) {
+    for(int i=0; i<3; ++i)maxAbs = std::max(maxAbs, fabsf(v[i]));
+  }
+  if(maxAbs > 32767.0f) {
+    throw std::runtime_error("Collision mesh too large, exceeds 16-bit range!");
+  }
+  int fracBits = 0;
+  while(fracBits < VERT_MAX_FRAC_BITS && maxAbs * (float)(2 << fracBits) <= 32767.0f) {
+    ++fracBits;
+  }
+  float quantScale = (float)(1 << fracBits);
+
+  // meshes exceeding the limits of a single BVH (16-bit indices, 12-bit offsets) are split into chunks
+  std::vector<CollChunk> chunks{};
+  std::vector<uint32_t> tris(indices.size() / 3);
+  for(uint32_t t=0; t<tris.size(); ++t)tris[t] = t;
+  if(!tris.empty())buildChunks(tris, verticesFloat, indices, normals, chunks);
+
+  // Container: chunk-count, bounds of the whole mesh, then a table of chunk bounds + offsets.
+  // Each chunk is a 'Coll::Mesh' in the same format as before.
+  auto fileStart = file.getPos();
+  glm::i16vec3 aabbMin{0x7FFF, 0x7FFF, 0x7FFF};
+  glm::i16vec3 aabbMax{-0x8000, -0x8000, -0x8000};
+  for(auto &chunk : chunks) {
+    // root node of the BVH, after node- and data-count
+    for(int i=0; i<3; ++i) {
+      aabbMin[i] = std::min(aabbMin[i], chunk.bvh[2+i]);
+      aabbMax[i] = std::max(aabbMax[i], chunk.bvh[5+i]);
+    }
+  }
+  if(chunks.empty())aabbMin = aabbMax = {0, 0, 0};
+
+  file.write<uint32_t>(chunks.size());
+  for(int i=0; i<3; ++i)file.write<int16_t>(aabbMin[i]);
+  for(int i=0; i<3; ++i)file.write<int16_t>(aabbMax[i]);
+
+  auto tablePos = file.getPos();
+  for(auto &chunk : chunks) {
+    file.writeArray(&chunk.bvh[2], 6);
+    file.write<uint32_t>(0); // offset, patched below
+  }
+  assert(file.getPos() - fileStart == CHUNK_HEADER_SIZE + chunks.size() * CHUNK_ENTRY_SIZE);
+
+  uint32_t sizeOld = 0;
+  for(uint32_t c=0; c<chunks.size(); ++c)
+  {
+    auto &chunk = chunks[c];
+    auto chunkPos = file.getPos();
+    file.posPush(tablePos + c * CHUNK_ENTRY_SIZE + 12);
+    file.write<uint32_t>(chunkPos - fileStart);
+    file.posPop();
+
+    file.reserve(file.getPos() + 6*4
+      + (chunk.indices.size() * sizeof(uint16_t) + 3)
+      + (chunk.normals.size() * sizeof(uint16_t) + 3)
+      + (chunk.vertMap.size() * sizeof(int16_t) * 3 + 3)
+      + (chunk.bvh.size() * sizeof(int16_t) + 3)
+    );
+
+    file.write<uint32_t>(chunk.indices.size() / 3);
+    file.write<uint32_t>(chunk.vertMap.size());
+    file.write<float>(1.0f / quantScale); // vertex scale
+    file.write<uint32_t>(0); // vertex pointer
+    file.write<uint32_t>(0); // normals pointer
+    file.write<uint32_t>(0); // BVH pointer
+
+    file.writeArray(chunk.indices.data(), chunk.indices.size());
+    file.align(4);
+
+    file.writeArray(chunk.normals.data(), chunk.normals.size());
+    file.align(4);
+
+    for(auto idx : chunk.vertMap) {
+      for(int i=0; i<3; ++i) {
+        file.write<int16_t>((int16_t)std::lround(verticesFloat[idx][i] * quantScale));
+      }
+    }
+    file.align(4);
+
+    file.writeArray(chunk.bvh.data(), chunk.bvh.size());
+    file.align(4);
+
+    // size before the compact format: float vertices, 3x16-bit normals, BVH written twice
+    sizeOld += 6*4
+      + ((chunk.indices.size() * sizeof(uint16_t) + 3) & ~3)
+      + ((chunk.normals.size() * sizeof(int16_t) * 3 + 3) & ~3)
+      + chunk.vertMap.size() * sizeof(float) * 3
+      + ((chunk.bvh.size() * sizeof(int16_t) * 2 + 3) & ~3);
+  }
+
+  Utils::Logger::log("Collision: " + std::to_string(indices.size() / 3) + " tris, "
+    + std::to_string(verticesFloat.size()) + " verts, "
+    + std::to_string(chunks.size()) + " chunk(s), "
+    + std::to_string(file.getPos() - fileStart) + " bytes (previous format: "
+    + std::to_string(sizeOld) + " bytes), vertex precision: 1/" + std::to_string(1 << fracBits)
+  );
+}
@@ -0,0 +1,22 @@
+/**
+* @copyright 2025 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "glm/vec3.hpp"
+#include "../../utils/binaryFile.h"
+
+namespace Build::CollisionMesh
+{
+  /**
+   * Writes triangles in the runtime format (see 'Coll::MeshChunks').
+   * Generates normals, splits meshes exceeding the limits of a single BVH into chunks and builds a BVH for each.
+   * Used by 'Build::buildCollision' once the glTF is parsed, and by the host collision tests ('tests/coll').
+   *
+   * Throws on degenerate triangles, or if the mesh exceeds the 16-bit vertex range.
+   */
+  void write(Utils::BinaryFile &file, const std::vector<glm::vec3> &vertices, const std::vector<uint32_t> &indices);
+}
@@ -318,6 +318,20 @@ void Editor::Scene::draw()
     Utils::byteSize(UndoRedo::getHistory().getMemoryUsage()).c_str(),
     fpsRingBuffer.average()
   );
+  if (ImGui::IsItemHovered()) {
+    ImGui::SetTooltip("History memory: %s\nWith full snapshots: %s",
+      Utils::byteSize(UndoRedo::getHistory().getMemoryUsage()).c_str(),
+      Utils::byteSize(UndoRedo::getHistory().getSnapshotMemoryUsage()).c_str()
+    );
+  }
+
+  auto &assets = ctx.project->getAssets();
+  if (assets.isLoading()) {
+    ImGui::SameLine();
+    ImGui::TextColored({1.0f,1.0f,1.0f,0.4f}, "| Loading assets");
+    ImGui::SameLine();
+    ImGui::ProgressBar(assets.getLoadingProgress(), {120, ImGui::GetTextLineHeight()});
+  }
 
   perfColor = {1.0f,1.0f,1.0f,0.4f};
   std::string txtInfo = "v" PYRITE_VERSION;
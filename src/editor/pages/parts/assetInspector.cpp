@@ -119,6 +119,15 @@ void Editor::AssetInspector::draw() {
       ImGui::Text("Triangles: %d", triCount);
       ImGui::Text("Bones: %d", static_cast<int>(asset->t3dmData.skeletons.size()));
       ImGui::Text("Animations: %d", static_cast<int>(asset->t3dmData.animations.size()));
+
+      if (asset->mesh3D) {
+        const auto &stats = asset->mesh3D->getStats();
+        ImGui::Separator();
+        ImGui::Text("GPU Memory: %.2f KB", stats.getGPUSize() / 1024.0f);
+        ImGui::Text("Vertices: %d (%d before welding)", stats.vertCount, stats.vertCountRaw);
+        ImGui::Text("Indices: %d (%d draws)", stats.indexCount, stats.rangeCount);
+        ImGui::Text("ACMR: %.3f", stats.acmr);
+      }
     }
   }
 }
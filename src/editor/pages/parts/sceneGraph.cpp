@@ -150,9 +150,15 @@ namespace
       int clicked = 0;
       clicked |= ImGui::IconToggle(obj.selectable, ICON_MDI_CURSOR_DEFAULT, ICON_MDI_CURSOR_DEFAULT_OUTLINE, iconSize);
       ImGui::SameLine(0, spacing);
-      clicked |= ImGui::IconToggle(obj.enabled, ICON_MDI_CHECKBOX_MARKED, ICON_MDI_CHECKBOX_BLANK_OUTLINE, iconSize);
+      if(ImGui::IconToggle(obj.enabled, ICON_MDI_CHECKBOX_MARKED, ICON_MDI_CHECKBOX_BLANK_OUTLINE, iconSize)) {
+        clicked = 1;
+        scene.changes.markStructure(); // hides/shows the whole sub-tree
+      }
 
-      if(clicked)nodeIsClicked = false;
+      if(clicked) {
+        nodeIsClicked = false;
+        scene.markObjectChanged(obj);
+      }
 
       ImGui::PopID();
 
@@ -192,6 +198,7 @@ namespace
         if (obj.parent) {
           if (!obj.isPrefabInstance() && ImGui::MenuItem(ICON_MDI_PACKAGE_VARIANT_CLOSED_PLUS " To Prefab")) {
             scene.createPrefabFromObject(obj.uuid);
+            scene.markObjectChanged(obj);
           }
 
           if (ImGui::MenuItem(ICON_MDI_TRASH_CAN " Delete"))deleteObj = &obj;
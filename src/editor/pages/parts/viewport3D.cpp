@@ -14,6 +14,7 @@
 #include "../../../renderer/uniforms.h"
 #include "../../../utils/meshGen.h"
 #include "../../../utils/colors.h"
+#include "../../../utils/frustum.h"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtx/matrix_decompose.hpp"
 #include "SDL3/SDL_gpu.h"
@@ -133,7 +134,41 @@ namespace
     }
   }
 
+  /**
+   * Calls 'callback' for each component of the object, resolving prefab instances.
+   */
+  template<typename F>
+  void forEachComponent(Project::Object& obj, F &&callback)
+  {
+    auto srcObj = &obj;
+    if(obj.isPrefabInstance()) {
+      auto prefab = ctx.project->getAssets().getPrefabByUUID(obj.uuidPrefab.value);
+      if(prefab)srcObj = &prefab->obj;
+    }
+    for(auto &comp : srcObj->components) {
+      callback(comp);
+    }
+  }
+
+  Utils::AABB getObjectBounds(Project::Object &obj, bool &alwaysVisible)
+  {
+    auto srcObj = &obj;
+    if(obj.isPrefabInstance()) {
+      auto prefab = ctx.project->getAssets().getPrefabByUUID(obj.uuidPrefab.value);
+      if(prefab)srcObj = &prefab->obj;
+    }
+
+    for(auto &comp : srcObj->components) {
+      auto &def = Project::Component::TABLE[comp.id];
+      if((def.funcDraw3D || def.funcDrawPost3D) && !def.funcGetAABB) {
+        alwaysVisible = true;
+      }
+    }
+    return srcObj->getLocalAABB();
+  }
+
   void applyDeltaToChildren(
+    Project::Scene &scene,
     Project::Object &obj,
     const std::unordered_map<uint64_t, glm::vec3> &relPosMap,
     const glm::mat4 &mat
@@ -146,11 +181,13 @@ namespace
       auto it = relPosMap.find(child->uuid);
       if(it == relPosMap.end())continue;
       child->pos.resolve(child->propOverrides) = mat * glm::vec4(it->second, 1.0f);
+      scene.markObjectChanged(*child);
     }
   }
 }
 
 Editor::Viewport3D::Viewport3D()
+  : sceneIndex{getObjectBounds}
 {
   if(spritesRefCount == 0) {
     sprites = std::make_shared<Renderer::Texture>(ctx.gpu, "data/img/icons/sprites.png");
@@ -219,62 +256,99 @@ void Editor::Viewport3D::onRenderPass(SDL_GPUCommandBuffer* cmdBuff, Renderer::S
   camera.apply(uniGlobal);
   uniGlobal.screenSize = glm::vec2{(float)fb.getWidth(), (float)fb.getHeight()};
   SDL_PushGPUVertexUniformData(cmdBuff, 0, &uniGlobal, sizeof(uniGlobal));
-  auto &rootObj = scene->getRootObject();
 
-  bool hadDraw = false;
-  iterateObjects(rootObj, [&](Project::Object &obj, Project::Component::Entry *comp) {
-    if(!comp)
-    {
-      if(!hadDraw) {
-        glm::u8vec4 spriteCol{0xFF, 0xFF, 0xFF, 0xFF};
-        if (ctx.isObjectSelected(obj.uuid)) {
-          spriteCol = Utils::Colors::kSelectionTint;
-        }
-        Utils::Mesh::addSprite(*getSprites(), obj.pos.resolve(obj.propOverrides), obj.uuid, 2, spriteCol);
+  auto timeStart = SDL_GetTicksNS();
+
+  // only objects inside the view are drawn, the scene-index is kept up to date incrementally
+  auto assetRevision = ctx.project->getAssets().getRevision();
+  if(assetRevision != lastAssetRevision) {
+    sceneIndex.invalidateBounds();
+    lastAssetRevision = assetRevision;
+  }
+  sceneIndex.sync(scene->getRootObject(), scene->changes);
+  Utils::Frustum frustum = Utils::Frustum::fromMatrix(uniGlobal.projMat * uniGlobal.cameraMat);
+  if(!useCulling) {
+    frustum = {}; // all planes zero, everything passes
+  }
+  sceneIndex.query(frustum, visibleObjects, true);
+
+  auto &renderQueue = renderScene.getRenderQueue();
+  renderQueue.resetStats();
+
+  for(auto obj : visibleObjects)
+  {
+    bool hadDraw = false;
+    forEachComponent(*obj, [&](Project::Component::Entry &comp) {
+      auto &def = Project::Component::TABLE[comp.id];
+
+      // @TODO: use flag in component
+      if(!showCollMesh && comp.id == 4)return;
+      if(!showCollObj && comp.id == 5)return;
+
+      if(def.funcDraw3D) {
+        def.funcDraw3D(*obj, comp, *this, cmdBuff, renderPass3D);
+        hadDraw = true;
+      }
+    });
+
+    if(!hadDraw) {
+      glm::u8vec4 spriteCol{0xFF, 0xFF, 0xFF, 0xFF};
+      if (ctx.isObjectSelected(obj->uuid)) {
+        spriteCol = Utils::Colors::kSelectionTint;
       }
-      hadDraw = false;
-      return;
+      Utils::Mesh::addSprite(*getSprites(), obj->pos.resolve(obj->propOverrides), obj->uuid, 2, spriteCol);
     }
-    auto &def = Project::Component::TABLE[comp->id];
+  }
+  renderQueue.flush(renderPass3D, cmdBuff, renderScene);
 
-    // @TODO: use flag in component
-    if(!showCollMesh && comp->id == 4)return;
-    if(!showCollObj && comp->id == 5)return;
+  // post-draws (e.g. collision overlays) must end up on top of the regular ones
+  for(auto obj : visibleObjects)
+  {
+    forEachComponent(*obj, [&](Project::Component::Entry &comp) {
+      auto &def = Project::Component::TABLE[comp.id];
 
-    if(def.funcDraw3D) {
-      def.funcDraw3D(obj, *comp, *this, cmdBuff, renderPass3D);
-      hadDraw = true;
-    }
-  });
+      // @TODO: use flag in component
+      if(!showCollMesh && comp.id == 4)return;
+      if(!showCollObj && comp.id == 5)return;
 
-  iterateObjects(rootObj, [&](Project::Object &obj, Project::Component::Entry *comp) {
-    if(!comp)return;
-    auto &def = Project::Component::TABLE[comp->id];
+      if(def.funcDrawPost3D) {
+        def.funcDrawPost3D(*obj, comp, *this, cmdBuff, renderPass3D);
+      }
+    });
+  }
+  renderQueue.flush(renderPass3D, cmdBuff, renderScene);
+  statsQueue = renderQueue.getStats();
 
-    // @TODO: use flag in component
-    if(!showCollMesh && comp->id == 4)return;
-    if(!showCollObj && comp->id == 5)return;
+  float timeMs = (float)(SDL_GetTicksNS() - timeStart) / 1'000'000.0f;
+  statsDrawTime = statsDrawTime * 0.95f + timeMs * 0.05f;
 
-    if(def.funcDrawPost3D) {
-      def.funcDrawPost3D(obj, *comp, *this, cmdBuff, renderPass3D);
-    }
-  });
+  SDL_EndGPURenderPass(renderPass3D);
 
-  meshLines->recreate(renderScene);
-  meshSprites->recreate(renderScene);
+  // lines and sprites are only known now, upload them and continue in a second pass
+  auto &ringBuffer = renderScene.getRingBuffer();
+  meshLines->recreateDynamic(ringBuffer);
+  meshSprites->recreateDynamic(ringBuffer);
 
-  renderScene.getPipeline("lines").bind(renderPass3D);
+  SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(cmdBuff);
+  ringBuffer.upload(*copyPass);
+  SDL_EndGPUCopyPass(copyPass);
+
+  SDL_GPURenderPass* renderPassOverlay = SDL_BeginGPURenderPass(
+    cmdBuff, fb.getTargetInfoLoad(), fb.getTargetInfoCount(), &fb.getDepthTargetInfoLoad()
+  );
+
+  renderScene.getPipeline("lines").bind(renderPassOverlay);
   if (showGrid) {
-    objGrid.draw(renderPass3D, cmdBuff);
+    objGrid.draw(renderPassOverlay, cmdBuff);
   }
-  objLines.draw(renderPass3D, cmdBuff);
+  objLines.draw(renderPassOverlay, cmdBuff);
 
-  renderScene.getPipeline("sprites").bind(renderPass3D);
+  renderScene.getPipeline("sprites").bind(renderPassOverlay);
 
-  sprites->bind(renderPass3D);
-  objSprites.draw(renderPass3D, cmdBuff);
+  sprites->bind(renderPassOverlay);
+  objSprites.draw(renderPassOverlay, cmdBuff);
 
-  SDL_EndGPURenderPass(renderPass3D);
+  SDL_EndGPURenderPass(renderPassOverlay);
 }
 
 void Editor::Viewport3D::onCopyPass(SDL_GPUCommandBuffer* cmdBuff, SDL_GPUCopyPass *copyPass) {
@@ -282,11 +356,34 @@ void Editor::Viewport3D::onCopyPass(SDL_GPUCommandBuffer* cmdBuff, SDL_GPUCopyPa
 }
 
 void Editor::Viewport3D::onPostRender(Renderer::Scene &renderScene) {
-  if (pickedObjID.isRequested()) {
-    pickedObjID.setResult(fb.readObjectID(mousePosClick.x, mousePosClick.y));
+  if (pickedObjIDs.isRequested() && !pickSubmitted) {
+    pickSubmitted = fb.requestObjectIDs(
+      (uint32_t)pickPos.x, (uint32_t)pickPos.y,
+      (uint32_t)pickSize.x, (uint32_t)pickSize.y,
+      pickRequestId
+    );
+  }
+
+  uint32_t requestId;
+  while (fb.pollObjectIDs(requestId, pickResult)) {
+    // results of requests replaced by a newer one are dropped
+    if (requestId == pickRequestId && pickedObjIDs.isRequested()) {
+      pickedObjIDs.setResult(pickResult);
+      pickSubmitted = false;
+    }
   }
 }
 
+void Editor::Viewport3D::requestPick(const glm::vec2 &pos, const glm::vec2 &size, bool isRect, bool additive) {
+  pickedObjIDs.request();
+  pickPos = glm::max(pos, glm::vec2{0.0f, 0.0f});
+  pickSize = size;
+  pickIsRect = isRect;
+  pickAdditive = additive;
+  pickSubmitted = false;
+  ++pickRequestId;
+}
+
 void Editor::Viewport3D::draw()
 {
   camera.update();
@@ -305,9 +402,20 @@ void Editor::Viewport3D::draw()
 
   fb.setClearColor(scene->conf.clearColor.value);
 
-  if(pickedObjID.hasResult())
+  if(pickedObjIDs.hasResult() && pickIsRect)
   {
-    uint32_t newUUID = pickedObjID.consume();
+    if (!pickAdditive) {
+      ctx.clearObjectSelection();
+    }
+    for(auto uuid : pickedObjIDs.consume()) {
+      auto pickedObj = scene->getObjectByUUID(uuid);
+      if(pickedObj && pickedObj->selectable)ctx.addObjectSelection(uuid);
+    }
+  }
+  else if(pickedObjIDs.hasResult())
+  {
+    auto ids = pickedObjIDs.consume();
+    uint32_t newUUID = ids.empty() ? 0 : ids[0];
     auto newObj = scene->getObjectByUUID(newUUID);
     if(newObj && !newObj->selectable) {
       newUUID = 0;
@@ -393,30 +501,11 @@ void Editor::Viewport3D::draw()
       rectMin = glm::clamp(rectMin, glm::vec2{0,0}, viewportSize);
       rectMax = glm::clamp(rectMax, glm::vec2{0,0}, viewportSize);
 
-      if (!additiveSelect) {
-        ctx.clearObjectSelection();
-      }
-
-      auto &rootObj = scene->getRootObject();
-      glm::vec4 viewport{0.0f, 0.0f, currSize.x, currSize.y};
-      iterateObjects(rootObj, [&](Project::Object &objIter, Project::Component::Entry *comp) {
-        if (comp) return;
-        if (!objIter.selectable) return;
-
-        glm::vec3 worldPos = objIter.pos.resolve(objIter.propOverrides);
-        glm::vec3 proj = glm::project(worldPos, uniGlobal.cameraMat, uniGlobal.projMat, viewport);
-        if (proj.z < 0.0f || proj.z > 1.0f) return;
-
-        glm::vec2 screenPos{proj.x, currSize.y - proj.y};
-        if (screenPos.x >= rectMin.x && screenPos.x <= rectMax.x
-            && screenPos.y >= rectMin.y && screenPos.y <= rectMax.y) {
-          ctx.addObjectSelection(objIter.uuid);
-        }
-      });
+      // select everything with at least one visible pixel inside the rectangle
+      glm::vec2 rectSize = glm::max(rectMax - rectMin, glm::vec2{1.0f, 1.0f});
+      requestPick(rectMin, rectSize, true, additiveSelect);
     } else {
-      pickedObjID.request();
-      mousePosClick = mousePos;
-      pickAdditive = additiveSelect;
+      requestPick(mousePos, {1.0f, 1.0f}, false, additiveSelect);
     }
     selectionPending = false;
     selectionDragging = false;
@@ -531,6 +620,20 @@ void Editor::Viewport3D::draw()
     showCollObj = !showCollObj;
   }
 
+  ImGui::SameLine();
+  ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 12);
+  if(ConnectedToggleButton(ICON_MDI_CUBE_SCAN, useCulling, true, true, ImVec2(32,24))) {
+    useCulling = !useCulling;
+  }
+  if(ImGui::IsItemHovered())ImGui::SetTooltip("Frustum Culling");
+
+  ImGui::SameLine();
+  ImGui::SetCursorPosX(ImGui::GetCursorPosX() - 4);
+  if(ConnectedToggleButton(ICON_MDI_SPEEDOMETER, showStats, true, true, ImVec2(32,24))) {
+    showStats = !showStats;
+  }
+  if(ImGui::IsItemHovered())ImGui::SetTooltip("Viewport Stats");
+
   ImGui::SetCursorPosY(currPos.y + BAR_HEIGHT);
 
   auto dragDelta = mousePos - mousePosStart;
@@ -581,6 +684,15 @@ void Editor::Viewport3D::draw()
 
   isMouseHover = ImGui::IsItemHovered();
 
+  if (showStats) {
+    char statsText[256];
+    snprintf(statsText, sizeof(statsText), "Objects: %u / %u (BVH depth %d) | Draw: %.2fms\nDraws: %u | Texture binds: %u | Mesh binds: %u | Uniforms: %u | Translucent: %u",
+      (uint32_t)visibleObjects.size(), sceneIndex.getObjectCount(), sceneIndex.getTreeHeight(), statsDrawTime,
+      statsQueue.draws, statsQueue.textureBinds, statsQueue.meshBinds, statsQueue.uniformPushes, statsQueue.translucent
+    );
+    ImGui::GetWindowDrawList()->AddText({currPos.x + 8, currPos.y + 8}, IM_COL32(0xFF, 0xFF, 0xFF, 0xFF), statsText);
+  }
+
   if (selectionDragging) {
     glm::vec2 rectMin = glm::min(selectionStart, selectionEnd);
     glm::vec2 rectMax = glm::max(selectionStart, selectionEnd);
@@ -653,6 +765,7 @@ void Editor::Viewport3D::draw()
         pos.y = std::round(pos.y / snap.y) * snap.y;
         pos.z = std::round(pos.z / snap.z) * snap.z;
         obj->pos.resolve(obj->propOverrides) = pos;
+        scene->changes.markObject(obj->uuid);
       }
 
       if(ImGuizmo::Manipulate(
@@ -665,6 +778,9 @@ void Editor::Viewport3D::draw()
         isSnap ? glm::value_ptr(snap) : nullptr
       )) {
         gizmoTransformActive = true;
+        for(auto *selObj : selectedObjects) {
+          scene->changes.markObject(selObj->uuid);
+        }
 
         auto ensureOverride = [](Project::Object *selObj, auto &prop) {
           if (selObj->propOverrides.find(prop.id) == selObj->propOverrides.end()) {
@@ -702,7 +818,7 @@ void Editor::Viewport3D::draw()
 
             if(!isOnlySelf)
             {
-              applyDeltaToChildren(*obj, relPosMap, gizmoMat);
+              applyDeltaToChildren(*scene, *obj, relPosMap, gizmoMat);
             }
           }
         } else {
@@ -764,7 +880,7 @@ void Editor::Viewport3D::draw()
               if(!isOnlySelf)
               {
                 auto newObjMat = glm::recompose(objScale, objRot, objPos, skew, persp);
-                applyDeltaToChildren(*selObj, relPosMap, newObjMat);
+                applyDeltaToChildren(*scene, *selObj, relPosMap, newObjMat);
               }
             }
           } else {
@@ -808,7 +924,7 @@ void Editor::Viewport3D::draw()
               );
 
               if(!isOnlySelf) {
-                applyDeltaToChildren(*selObj, relPosMap, newObjMat);
+                applyDeltaToChildren(*scene, *selObj, relPosMap, newObjMat);
               }
             }
           }
@@ -4,13 +4,16 @@
 */
 #pragma once
 #include <memory>
+#include <vector>
 
 #include "../../../renderer/camera.h"
 #include "../../../renderer/vertBuffer.h"
 #include "../../../renderer/framebuffer.h"
 #include "../../../renderer/mesh.h"
 #include "../../../renderer/object.h"
+#include "../../../renderer/renderQueue.h"
 #include "../../../utils/container.h"
+#include "../../sceneIndex.h"
 
 namespace Editor
 {
@@ -24,7 +27,14 @@ namespace Editor
 
       bool isMouseHover{false};
       bool isMouseDown{false};
-      Utils::RequestVal<uint32_t> pickedObjID{};
+      // object-IDs under the cursor or selection-rectangle, read back from the GPU a few frames later
+      Utils::RequestVal<std::vector<uint32_t>> pickedObjIDs{};
+      std::vector<uint32_t> pickResult{};
+      glm::vec2 pickPos{};
+      glm::vec2 pickSize{};
+      uint32_t pickRequestId{0};
+      bool pickSubmitted{false};
+      bool pickIsRect{false};
       bool pickAdditive{false};
       bool selectionPending{false};
       bool selectionDragging{false};
@@ -32,7 +42,6 @@ namespace Editor
       float vpOffsetY{};
       glm::vec2 mousePos{};
       glm::vec2 mousePosStart{};
-      glm::vec2 mousePosClick{};
       glm::vec2 selectionStart{};
       glm::vec2 selectionEnd{};
 
@@ -48,6 +57,14 @@ namespace Editor
       bool showGrid{true};
       bool showCollMesh{false};
       bool showCollObj{true};
+      bool showStats{false};
+      bool useCulling{true};
+
+      SceneIndex sceneIndex;
+      uint32_t lastAssetRevision{0};
+      std::vector<Project::Object*> visibleObjects{};
+      float statsDrawTime{}; // CPU time to collect and draw objects in ms, smoothed
+      Renderer::RenderQueue::Stats statsQueue{};
 
       int gizmoOp{0};
       bool gizmoTransformActive{false};
@@ -55,6 +72,7 @@ namespace Editor
       void onRenderPass(SDL_GPUCommandBuffer* cmdBuff, Renderer::Scene& renderScene);
       void onCopyPass(SDL_GPUCommandBuffer* cmdBuff, SDL_GPUCopyPass *copyPass);
       void onPostRender(Renderer::Scene& renderScene);
+      void requestPick(const glm::vec2 &pos, const glm::vec2 &size, bool isRect, bool additive);
 
     public:
       Viewport3D();
@@ -0,0 +1,157 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "sceneIndex.h"
+
+#include <algorithm>
+
+#include "../project/scene/object.h"
+#include "../project/scene/sceneChanges.h"
+
+namespace
+{
+  // margin added to the bounds in the BVH, objects moving less than that don't change the tree
+  constexpr float BVH_MARGIN = 4.0f;
+}
+
+Editor::SceneIndex::SceneIndex(BoundsFunc getBounds)
+  : getBounds{getBounds}, bvh{BVH_MARGIN}
+{
+}
+
+void Editor::SceneIndex::updateEntry(Entry &entry)
+{
+  auto &obj = *entry.obj;
+  bool wasAlwaysVisible = entry.alwaysVisible;
+  entry.alwaysVisible = false;
+  entry.aabb = getBounds(obj, entry.alwaysVisible);
+  if(entry.alwaysVisible && !wasAlwaysVisible)alwaysVisibleUUIDs.push_back(entry.uuid);
+  if(!entry.alwaysVisible && wasAlwaysVisible)std::erase(alwaysVisibleUUIDs, entry.uuid);
+  entry.aabb.transform(
+    obj.pos.resolve(obj.propOverrides),
+    obj.rot.resolve(obj.propOverrides),
+    obj.scale.resolve(obj.propOverrides)
+  );
+
+  if(entry.proxy == Utils::DynamicBVH::NULL_NODE) {
+    entry.proxy = bvh.insert(entry.aabb, entryByUUID[entry.uuid]);
+  } else {
+    bvh.move(entry.proxy, entry.aabb);
+  }
+}
+
+void Editor::SceneIndex::removeEntry(uint32_t idx)
+{
+  bvh.remove(entries[idx].proxy);
+  entryByUUID.erase(entries[idx].uuid);
+  if(entries[idx].alwaysVisible)std::erase(alwaysVisibleUUIDs, entries[idx].uuid);
+
+  uint32_t lastIdx = entries.size() - 1;
+  if(idx != lastIdx) {
+    entries[idx] = entries[lastIdx];
+    entryByUUID[entries[idx].uuid] = idx;
+    bvh.setUserData(entries[idx].proxy, idx);
+  }
+  entries.pop_back();
+}
+
+void Editor::SceneIndex::addObjects(Project::Object &obj, uint32_t &order)
+{
+  for(auto &child : obj.children)
+  {
+    if(!child->enabled)continue;
+
+    uint32_t idx;
+    auto it = entryByUUID.find(child->uuid);
+    if(it == entryByUUID.end()) {
+      idx = entries.size();
+      entryByUUID[child->uuid] = idx;
+      auto &entry = entries.emplace_back();
+      entry.obj = child.get();
+      entry.uuid = child->uuid;
+      updateEntry(entry);
+    } else {
+      idx = it->second;
+      entries[idx].obj = child.get(); // undo can re-create objects with the same UUID
+    }
+
+    entries[idx].order = order++;
+    entries[idx].lastSync = syncCount;
+
+    addObjects(*child, order);
+  }
+}
+
+void Editor::SceneIndex::rebuild(Project::Object &root)
+{
+  ++syncCount;
+  uint32_t order = 0;
+  addObjects(root, order);
+
+  // objects no longer reached are deleted or disabled
+  for(uint32_t i=entries.size(); i-- > 0;) {
+    if(entries[i].lastSync != syncCount)removeEntry(i);
+  }
+}
+
+void Editor::SceneIndex::sync(Project::Object &root, const Project::SceneChanges &changes)
+{
+  bool structureChanged = changes.getStructureRevision() != lastStructureRevision;
+  if(&root != lastRoot) {
+    bvh.clear();
+    entries.clear();
+    entryByUUID.clear();
+    alwaysVisibleUUIDs.clear();
+    lastRoot = &root;
+    lastObjectCount = changes.getObjectCount(); // everything gets added with fresh bounds
+    structureChanged = true;
+  }
+
+  // rebuilding first drops removed objects, which may still be in the log
+  if(structureChanged) {
+    rebuild(root);
+    lastStructureRevision = changes.getStructureRevision();
+  }
+
+  bool complete = changes.forEachObject(lastObjectCount, [this](uint32_t uuid) {
+    auto it = entryByUUID.find(uuid);
+    if(it != entryByUUID.end())updateEntry(entries[it->second]);
+  });
+  if(!complete)invalidateBounds();
+  lastObjectCount = changes.getObjectCount();
+}
+
+void Editor::SceneIndex::invalidateBounds()
+{
+  for(auto &entry : entries) {
+    updateEntry(entry);
+  }
+}
+
+void Editor::SceneIndex::query(const Utils::Frustum &frustum, std::vector<Project::Object*> &out, bool withAlwaysVisible)
+{
+  results.clear();
+  bvh.query(
+    [&](const Utils::AABB &aabb) { return frustum.vsAABB(aabb); },
+    [&](uint32_t idx, const Utils::AABB&) {
+      const auto &entry = entries[idx];
+      if(withAlwaysVisible && entry.alwaysVisible)return;
+      if(frustum.vsAABB(entry.aabb))results.push_back(idx);
+    }
+  );
+
+  if(withAlwaysVisible) {
+    for(auto uuid : alwaysVisibleUUIDs) {
+      results.push_back(entryByUUID[uuid]);
+    }
+  }
+
+  std::sort(results.begin(), results.end(), [&](uint32_t a, uint32_t b) {
+    return entries[a].order < entries[b].order;
+  });
+
+  out.clear();
+  out.reserve(results.size());
+  for(auto idx : results)out.push_back(entries[idx].obj);
+}
@@ -0,0 +1,93 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../utils/aabb.h"
+#include "../utils/dynamicBVH.h"
+#include "../utils/frustum.h"
+
+namespace Project {
+  class Object;
+  class SceneChanges;
+}
+
+namespace Editor
+{
+  /**
+   * Spatial index of all enabled objects in a scene, used by the viewport for culling.
+   *
+   * It is fed by the scene's change log ('Project::SceneChanges') instead of looking at the objects themselves:
+   * only objects marked as changed get their bounds re-calculated, and the object tree is only walked again
+   * after its structure changed (objects added, removed, moved or (un-)hidden).
+   * Without edits, 'sync' does no work per object.
+   * Bounds that change without an edit of the object (e.g. a model finished loading) need 'invalidateBounds'.
+   *
+   * Objects with a 3D-draw but no bounds (e.g. lights, cameras) are reported as always visible.
+   */
+  class SceneIndex
+  {
+    public:
+      /**
+       * Returns the bounds of an object in its local space,
+       * and sets 'alwaysVisible' if parts of it are drawn without having bounds.
+       */
+      using BoundsFunc = Utils::AABB(*)(Project::Object &obj, bool &alwaysVisible);
+
+    private:
+      struct Entry
+      {
+        Project::Object *obj{};
+        uint32_t uuid{};
+        int proxy{Utils::DynamicBVH::NULL_NODE};
+        uint32_t order{}; // position in the object tree, results are sorted by it
+        uint32_t lastSync{};
+        bool alwaysVisible{false};
+        Utils::AABB aabb{};
+      };
+
+      BoundsFunc getBounds;
+      Utils::DynamicBVH bvh{};
+      std::vector<Entry> entries{};
+      std::unordered_map<uint32_t, uint32_t> entryByUUID{};
+      std::vector<uint32_t> alwaysVisibleUUIDs{};
+      std::vector<uint32_t> results{};
+
+      const Project::Object *lastRoot{nullptr};
+      uint32_t lastStructureRevision{0};
+      uint64_t lastObjectCount{0};
+      uint32_t syncCount{0};
+
+      void rebuild(Project::Object &root);
+      void addObjects(Project::Object &obj, uint32_t &order);
+      void updateEntry(Entry &entry);
+      void removeEntry(uint32_t idx);
+
+    public:
+      explicit SceneIndex(BoundsFunc getBounds);
+
+      /**
+       * Applies all changes logged since the last call, has to be called before each 'query'.
+       * @param root root object of the scene, a different root resets the index
+       */
+      void sync(Project::Object &root, const Project::SceneChanges &changes);
+
+      /**
+       * Re-calculates the bounds of all objects, e.g. after models were loaded or changed.
+       */
+      void invalidateBounds();
+
+      /**
+       * Collects all objects whose bounds intersect the frustum, in the same order as the object tree.
+       * @param withAlwaysVisible include objects without bounds regardless of the frustum
+       */
+      void query(const Utils::Frustum &frustum, std::vector<Project::Object*> &out, bool withAlwaysVisible);
+
+      [[nodiscard]] uint32_t getObjectCount() const { return entries.size(); }
+      [[nodiscard]] int getTreeHeight() const { return bvh.getHeight(); }
+  };
+}
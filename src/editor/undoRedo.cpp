@@ -4,43 +4,275 @@
 */
 #include "undoRedo.h"
 #include "../context.h"
+#include "../utils/logger.h"
+
+#include <algorithm>
 
 namespace
 {
   Editor::UndoRedo::History globalHistory;
+
+  /**
+   * Walks the scene graph depth-first, calls 'cb(obj, parentUUID, prevSiblingUUID)' for each object.
+   */
+  template<typename F>
+  void forEachObject(Project::Object &parent, uint32_t parentUUID, F &cb)
+  {
+    uint32_t prevSibling = 0;
+    for(auto &child : parent.children) {
+      cb(*child, parentUUID, prevSibling);
+      forEachObject(*child, child->uuid, cb);
+      prevSibling = child->uuid;
+    }
+  }
+
+  void detachObject(Project::Object &obj)
+  {
+    if(!obj.parent)return;
+    std::erase_if(obj.parent->children, [&obj](const std::shared_ptr<Project::Object> &ref) {
+      return ref.get() == &obj;
+    });
+    obj.parent = nullptr;
+  }
 }
 
 namespace Editor::UndoRedo
 {
+  void History::captureState(Project::Scene &scene)
+  {
+    stateObjects.clear();
+    stateObjects.reserve(scene.objectsMap.size());
+    stateConf = scene.conf.serialize().dump();
+    stateSize = stateConf.size();
+
+    auto cb = [this](Project::Object &obj, uint32_t parent, uint32_t prevSibling) {
+      auto &state = stateObjects[obj.uuid];
+      state = {parent, prevSibling, obj.revision, obj.serialize(false).dump()};
+      stateSize += state.data.size();
+    };
+    forEachObject(scene.getRootObject(), 0, cb);
+  }
+
+  bool History::diffState(Project::Scene &scene, Entry &entry)
+  {
+    std::unordered_set<uint32_t> visited{};
+    visited.reserve(stateObjects.size());
+
+    auto cb = [&](Project::Object &obj, uint32_t parent, uint32_t prevSibling)
+    {
+      visited.insert(obj.uuid);
+
+      auto it = stateObjects.find(obj.uuid);
+      if(it == stateObjects.end()) {
+        ObjectState state{parent, prevSibling, obj.revision, obj.serialize(false).dump()};
+        stateSize += state.data.size();
+        entry.changes.push_back({obj.uuid, std::nullopt, state});
+        stateObjects.emplace(obj.uuid, std::move(state));
+        return;
+      }
+
+      // moving an object also changes the 'prevSibling' of its old and new neighbours
+      bool moved = it->second.parent != parent || it->second.prevSibling != prevSibling;
+      bool edited = it->second.revision != obj.revision;
+      if(!moved && !edited && !dirtyObjects.contains(obj.uuid))return;
+
+      ObjectState state{parent, prevSibling, obj.revision, obj.serialize(false).dump()};
+      if(it->second == state) {
+        it->second.revision = obj.revision;
+        return;
+      }
+
+      stateSize = stateSize - it->second.data.size() + state.data.size();
+      entry.changes.push_back({obj.uuid, std::move(it->second), state});
+      it->second = std::move(state);
+    };
+    forEachObject(scene.getRootObject(), 0, cb);
+    dirtyObjects.clear();
+
+    for(auto it = stateObjects.begin(); it != stateObjects.end();) {
+      if(visited.contains(it->first)) {
+        ++it;
+        continue;
+      }
+      stateSize -= it->second.data.size();
+      entry.changes.push_back({it->first, std::move(it->second), std::nullopt});
+      it = stateObjects.erase(it);
+    }
+
+    auto conf = scene.conf.serialize().dump();
+    if(conf != stateConf) {
+      stateSize = stateSize - stateConf.size() + conf.size();
+      entry.confBefore = std::move(stateConf);
+      entry.confAfter = conf;
+      stateConf = std::move(conf);
+    }
+
+    return !entry.changes.empty() || !entry.confAfter.empty();
+  }
+
+  bool History::verifyState(Project::Scene &scene, Entry &entry)
+  {
+    bool missed = false;
+    auto cb = [&](Project::Object &obj, uint32_t parent, uint32_t prevSibling)
+    {
+      auto it = stateObjects.find(obj.uuid);
+      if(it == stateObjects.end())return; // can't happen, 'diffState' adds all new objects
+
+      ObjectState state{parent, prevSibling, obj.revision, obj.serialize(false).dump()};
+      if(it->second == state)return;
+
+      // still record it, the state must never change without an entry (undo would revert it silently)
+      Utils::Logger::log("Undo: change of object '" + obj.name + "' was not tracked, use 'Scene::markObjectChanged'",
+        Utils::Logger::LEVEL_WARN);
+      stateSize = stateSize - it->second.data.size() + state.data.size();
+      entry.changes.push_back({obj.uuid, std::move(it->second), state});
+      it->second = std::move(state);
+      missed = true;
+    };
+    forEachObject(scene.getRootObject(), 0, cb);
+    return missed;
+  }
+
+  void History::applyChanges(Project::Scene &scene, const Entry &entry, bool forward)
+  {
+    struct Placement {
+      std::shared_ptr<Project::Object> obj;
+      const ObjectState *state;
+      bool placed;
+    };
+    std::vector<Placement> placements{};
+    std::unordered_map<uint32_t, uint32_t> placementIdx{};
+    // children of a removed object may get detached after it, keep it alive until then
+    std::vector<std::shared_ptr<Project::Object>> removed{};
+
+    // first create, update or remove objects, re-attaching them to the graph happens after that
+    for(auto &change : entry.changes)
+    {
+      auto &target = forward ? change.after : change.before;
+      auto &source = forward ? change.before : change.after;
+      auto obj = scene.getObjectByUUID(change.uuid);
+
+      auto itCache = stateObjects.find(change.uuid);
+      if(itCache != stateObjects.end())stateSize -= itCache->second.data.size();
+
+      if(!target) {
+        if(obj) {
+          detachObject(*obj);
+          scene.objectsMap.erase(change.uuid);
+          removed.push_back(std::move(obj));
+        }
+        if(itCache != stateObjects.end())stateObjects.erase(itCache);
+        continue;
+      }
+
+      bool isNew = !obj;
+      if(isNew) {
+        obj = std::make_shared<Project::Object>();
+        scene.objectsMap[change.uuid] = obj;
+      }
+
+      if(isNew || !source || source->data != target->data) {
+        bool wasEnabled = obj->enabled;
+        auto doc = nlohmann::json::parse(target->data, nullptr, false);
+        obj->components.clear();
+        obj->deserialize(nullptr, doc);
+        scene.markObjectChanged(*obj);
+        if(obj->enabled != wasEnabled)scene.changes.markStructure();
+      }
+
+      if(isNew || !source || source->parent != target->parent || source->prevSibling != target->prevSibling) {
+        detachObject(*obj);
+        placementIdx[change.uuid] = placements.size();
+        placements.push_back({obj, &*target, false});
+      }
+
+      auto &state = stateObjects[change.uuid];
+      state = *target;
+      state.revision = obj->revision;
+      stateSize += target->data.size();
+    }
+
+    // an object can only be inserted once its previous sibling is in place
+    auto place = [&](uint32_t idx, auto &placeRef) -> void
+    {
+      auto &p = placements[idx];
+      if(p.placed)return;
+      p.placed = true;
+
+      auto prevIt = placementIdx.find(p.state->prevSibling);
+      if(prevIt != placementIdx.end())placeRef(prevIt->second, placeRef);
+
+      auto parent = &scene.getRootObject();
+      if(p.state->parent != 0) {
+        auto parentObj = scene.getObjectByUUID(p.state->parent);
+        if(parentObj)parent = parentObj.get();
+      }
+
+      auto &siblings = parent->children;
+      auto pos = siblings.begin();
+      if(p.state->prevSibling != 0) {
+        pos = std::find_if(siblings.begin(), siblings.end(), [&p](const std::shared_ptr<Project::Object> &ref) {
+          return ref->uuid == p.state->prevSibling;
+        });
+        if(pos != siblings.end())++pos;
+      }
+      siblings.insert(pos, p.obj);
+      p.obj->parent = parent;
+    };
+
+    for(uint32_t i=0; i<placements.size(); ++i) {
+      place(i, place);
+    }
+    if(!placements.empty() || !removed.empty())scene.changes.markStructure();
+
+    auto &conf = forward ? entry.confAfter : entry.confBefore;
+    if(!conf.empty()) {
+      auto doc = nlohmann::json::parse(conf, nullptr, false);
+      scene.conf.deserialize(doc);
+      stateSize = stateSize - stateConf.size() + conf.size();
+      stateConf = conf;
+    }
+  }
+
+  void History::trimUndoStack()
+  {
+    if (undoStack.size() <= maxHistorySize)return;
+    undoStack.erase(undoStack.begin(), undoStack.end() - maxHistorySize);
+
+    // the oldest entry can't be undone, so the changes leading up to it are not needed anymore
+    auto &base = undoStack.front();
+    base->changes = {};
+    base->confBefore = {};
+    base->confAfter = {};
+  }
+
   bool History::undo()
   {
-    if (!canUndo()) return false;
+    if (!canUndo() || !snapshotScene) return false;
 
     auto cmd = std::move(undoStack.back());
     undoStack.pop_back();
     const auto &prevCmd = undoStack.back();
 
-    if (!snapshotScene) return false;
-    snapshotScene->deserialize(prevCmd->state);
+    applyChanges(*snapshotScene, *cmd, false);
 
     uint32_t primarySel = prevCmd->selection.empty() ? 0 : prevCmd->selection.back();
     ctx.setObjectSelectionList(prevCmd->selection, primarySel);
     ctx.sanitizeObjectSelection(snapshotScene);
 
     redoStack.push_back(std::move(cmd));
-    
+
     return true;
   }
-  
+
   bool History::redo()
   {
-    if (!canRedo()) return false;
+    if (!canRedo() || !snapshotScene) return false;
 
     auto cmd = std::move(redoStack.back());
     redoStack.pop_back();
 
-    if (!snapshotScene) return false;
-    snapshotScene->deserialize(cmd->state);
+    applyChanges(*snapshotScene, *cmd, true);
 
     uint32_t primarySel = cmd->selection.empty() ? 0 : cmd->selection.back();
     ctx.setObjectSelectionList(cmd->selection, primarySel);
@@ -50,15 +282,19 @@ namespace Editor::UndoRedo
 
     return true;
   }
-  
+
   void History::clear()
   {
     undoStack.clear();
     redoStack.clear();
     nextChangedReason.clear();
-    savedState.reset();
+    savedRevision.reset();
     snapshotScene = nullptr;
     snapshotSelUUIDs.clear();
+    stateObjects.clear();
+    dirtyObjects.clear();
+    stateConf.clear();
+    stateSize = 0;
   }
 
   void History::begin() {
@@ -67,18 +303,21 @@ namespace Editor::UndoRedo
 
     if (undoStack.empty()) {
       // If this is the first change, we need to save the initial state of the scene
-      std::string initialState = scene->serialize(true);
-      if (!savedState.has_value()) {
-        savedState = initialState;
+      captureState(*scene);
+
+      auto entry = std::make_unique<Entry>();
+      entry->description = "Initial State";
+      entry->selection = ctx.selObjectUUIDs;
+      entry->revision = nextRevision++;
+      if (!savedRevision.has_value()) {
+        savedRevision = entry->revision;
       }
-      auto ids = ctx.selObjectUUIDs;
-      undoStack.push_back(std::make_unique<Entry>(
-        std::move(initialState), "Initial State", ids
-      ));
+      undoStack.push_back(std::move(entry));
     }
 
     snapshotScene = scene;
     snapshotSelUUIDs = ctx.selObjectUUIDs;
+    dirtyObjects.insert(snapshotSelUUIDs.begin(), snapshotSelUUIDs.end());
   }
 
   void History::end() {
@@ -86,50 +325,48 @@ namespace Editor::UndoRedo
 
     auto scene = snapshotScene;
     snapshotScene = nullptr;
-    if (!scene) {
+    if (!scene || undoStack.empty()) {
       nextChangedReason.clear();
       return;
     }
 
-    if (!undoStack.empty()) {
-      undoStack.back()->selection = snapshotSelUUIDs;
-    }
-
-    auto ids = ctx.selObjectUUIDs;
-
-    auto newEntry = std::make_unique<Entry>(
-      scene->serialize(true),
-      nextChangedReason,
-      ids
-    );
+    undoStack.back()->selection = snapshotSelUUIDs;
 
+    auto newEntry = std::make_unique<Entry>();
+    newEntry->description = std::move(nextChangedReason);
+    newEntry->selection = ctx.selObjectUUIDs;
     nextChangedReason.clear();
 
-    if (!undoStack.empty()) {
-      // check against last state to avoid pushing duplicate states
-      if (undoStack.back()->state == newEntry->state
-          && undoStack.back()->selection == newEntry->selection) {
-        return;
-      }
+    // avoid pushing duplicate states
+    dirtyObjects.insert(newEntry->selection.begin(), newEntry->selection.end());
+    bool changed = diffState(*scene, *newEntry);
+    #ifndef NDEBUG
+      if(verifyState(*scene, *newEntry))changed = true;
+    #endif
+    if (!changed && undoStack.back()->selection == newEntry->selection) {
+      return;
+    }
+
+    // edits that never went through the scene (e.g. property widgets) are only known from here on
+    for(auto &change : newEntry->changes) {
+      if(change.after)scene->changes.markObject(change.uuid);
     }
 
     redoStack.clear();
 
+    newEntry->revision = nextRevision++;
     undoStack.push_back(std::move(newEntry));
-
-    if (undoStack.size() > maxHistorySize) {
-      undoStack.erase(undoStack.begin(), undoStack.end() - maxHistorySize);
-    }
+    trimUndoStack();
   }
 
   void History::markSaved()
   {
     if (undoStack.empty()) {
-      savedState.reset();
+      savedRevision.reset();
       return;
     }
 
-    savedState = undoStack.back()->state;
+    savedRevision = undoStack.back()->revision;
   }
 
   bool History::isDirty() const
@@ -138,11 +375,11 @@ namespace Editor::UndoRedo
       return false;
     }
 
-    if (!savedState.has_value()) {
+    if (!savedRevision.has_value()) {
       return false;
     }
 
-    return undoStack.back()->state != *savedState;
+    return undoStack.back()->revision != *savedRevision;
   }
 
   std::string History::getUndoDescription() const
@@ -150,7 +387,7 @@ namespace Editor::UndoRedo
     if (undoStack.empty()) return "";
     return undoStack.back()->description;
   }
-  
+
   std::string History::getRedoDescription() const
   {
     if (redoStack.empty()) return "";
@@ -166,18 +403,19 @@ namespace Editor::UndoRedo
       return;
     }
 
-    if (undoStack.size() > maxHistorySize) {
-      undoStack.erase(undoStack.begin(), undoStack.end() - maxHistorySize);
-    }
+    trimUndoStack();
 
     if (redoStack.size() > maxHistorySize) {
       redoStack.erase(redoStack.begin(), redoStack.end() - maxHistorySize);
     }
   }
-  
+
   uint64_t History::getMemoryUsage()
   {
-    uint64_t total = 0;
+    uint64_t total = stateConf.capacity();
+    for(auto &[uuid, state] : stateObjects) {
+      total += state.getMemoryUsage();
+    }
     for(auto &entry : redoStack) {
       total += entry->getMemoryUsage();
     }
@@ -7,6 +7,8 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Project
@@ -16,20 +18,70 @@ namespace Project
 
 namespace Editor::UndoRedo
 {
+  /**
+   * State of a single object, without its children.
+   * The position in the graph is stored as parent + previous sibling,
+   * so inserting or removing an object only changes its direct neighbour.
+   */
+  struct ObjectState
+  {
+    uint32_t parent{0}; // 0 = scene root
+    uint32_t prevSibling{0}; // 0 = first child
+    uint32_t revision{0}; // 'Object::revision' at the time 'data' was serialized, not part of the state itself
+    std::string data{};
+
+    bool operator==(const ObjectState &other) const {
+      return parent == other.parent && prevSibling == other.prevSibling && data == other.data;
+    }
+
+    uint64_t getMemoryUsage() const {
+      return sizeof(ObjectState) + data.capacity();
+    }
+  };
+
+  struct ObjectChange
+  {
+    uint32_t uuid{0};
+    std::optional<ObjectState> before{}; // empty if the object was added
+    std::optional<ObjectState> after{}; // empty if the object was removed
+
+    uint64_t getMemoryUsage() const {
+      return sizeof(ObjectChange)
+        + (before ? before->data.capacity() : 0)
+        + (after ? after->data.capacity() : 0);
+    }
+  };
+
+  /**
+   * A single history step, stores only what changed compared to the previous entry.
+   */
   struct Entry
   {
-    std::string state{};
     std::string description{};
     std::vector<uint32_t> selection{};
+    std::vector<ObjectChange> changes{};
+    std::string confBefore{}; // both empty if the scene settings did not change
+    std::string confAfter{};
+    uint64_t revision{0};
 
     uint64_t getMemoryUsage() const {
-      return state.capacity() + description.capacity()
-      + sizeof(Entry) + selection.capacity() * sizeof(uint32_t);
+      uint64_t res = sizeof(Entry) + description.capacity()
+        + confBefore.capacity() + confAfter.capacity()
+        + selection.capacity() * sizeof(uint32_t);
+      for(auto &change : changes)res += change.getMemoryUsage();
+      return res;
     }
   };
 
   /**
    * Manages undo/redo history.
+   * Instead of full scene snapshots, each entry stores a per-object diff.
+   * The last known state of each object is cached, changes are detected against it.
+   *
+   * To find changes, the graph structure (parent/sibling) of all objects is compared, which is cheap.
+   * Objects are only serialized if they are new, moved in the graph, changed their 'Object::revision',
+   * or were selected since the last entry (property widgets only know their value, but always edit the selection).
+   * Debug builds also serialize everything, changes that were missed get added to the entry and reported.
    */
   class History
   {
@@ -40,21 +92,34 @@ namespace Editor::UndoRedo
       Project::Scene* snapshotScene{nullptr};
       std::vector<uint32_t> snapshotSelUUIDs{};
       std::string nextChangedReason{};
-      std::optional<std::string> savedState{};
-      
+      std::optional<uint64_t> savedRevision{};
+      uint64_t nextRevision{0};
+
+      // state of the scene as of the latest entry in the undo-stack
+      std::unordered_map<uint32_t, ObjectState> stateObjects{};
+      std::unordered_set<uint32_t> dirtyObjects{}; // selected since the last entry
+      std::string stateConf{};
+      uint64_t stateSize{0};
+
+      void captureState(Project::Scene &scene);
+      bool diffState(Project::Scene &scene, Entry &entry);
+      bool verifyState(Project::Scene &scene, Entry &entry);
+      void applyChanges(Project::Scene &scene, const Entry &entry, bool forward);
+      void trimUndoStack();
+
     public:
       /**
        * Undo the last command.
        * @return true if undo was performed
        */
       bool undo();
-      
+
       /**
        * Redo the last undone command.
        * @return true if redo was performed
        */
       bool redo();
-      
+
       /**
        * Clear all history.
        */
@@ -77,22 +142,22 @@ namespace Editor::UndoRedo
        * Check if undo is available.
        */
       [[nodiscard]] bool canUndo() const { return undoStack.size() > 1; }
-      
+
       /**
        * Check if redo is available.
        */
       [[nodiscard]] bool canRedo() const { return !redoStack.empty(); }
-      
+
       /**
        * Get description of the command that would be undone.
        */
       [[nodiscard]] std::string getUndoDescription() const;
-      
+
       /**
        * Get description of the command that would be redone.
        */
       [[nodiscard]] std::string getRedoDescription() const;
-      
+
       /**
        * Set maximum history size.
        */
@@ -102,6 +167,13 @@ namespace Editor::UndoRedo
        * Returns currently used memory in bytes.
        */
       uint64_t getMemoryUsage();
+
+      /**
+       * Returns the memory that storing a full scene snapshot per entry would need.
+       */
+      uint64_t getSnapshotMemoryUsage() const {
+        return stateSize * (undoStack.size() + redoStack.size());
+      }
   };
 
   /**
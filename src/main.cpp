@@ -356,6 +356,7 @@ int main(int argc, char** argv)
       Utils::FilePicker::poll();
       if (ctx.project) {
         ctx.project->getAssets().pollWatch();
+        ctx.project->getAssets().updateLoading();
       }
 
       updateWindowTitle();
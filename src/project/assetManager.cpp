@@ -4,10 +4,11 @@
 */
 #include "assetManager.h"
 #include "../context.h"
+#include <algorithm>
 #include <filesystem>
 #include <format>
-#include <chrono>
-#include <unordered_set>
+
+#include <SDL3/SDL_init.h>
 
 #include "SHA256.h"
 #include "../utils/codeParser.h"
@@ -25,6 +26,24 @@ namespace fs = std::filesystem;
 
 namespace
 {
+  // max. time per frame spent on applying background loads
+  constexpr uint64_t LOAD_BUDGET_US = 4000;
+
+  struct ImageLoad
+  {
+    SDL_Surface *img{nullptr};
+
+    ~ImageLoad() {
+      if (img)SDL_DestroySurface(img);
+    }
+  };
+
+  struct ModelLoad
+  {
+    T3DM::T3DMData t3dmData{};
+    std::string error{};
+  };
+
   fs::path getCodePath(Project::Project *project) {
     auto res = fs::path{project->getPath()} / "src" / "user";
     if (!fs::exists(res)) {
@@ -49,6 +68,11 @@ namespace
     return pathAbs;
   }
 
+  // key for path lookups, so that different spellings of the same path match
+  std::string getPathKey(const std::string &path) {
+    return fs::path{path}.lexically_normal().string();
+  }
+
   std::string changeExt(const std::string &path, const std::string &newExt)
   {
     auto p = fs::path(path);
@@ -215,7 +239,13 @@ Project::AssetManager::AssetManager(Project* pr)
 }
 
 Project::AssetManager::~AssetManager() {
+  // running jobs reference this instance, wait for them before anything gets destroyed
+  loader.cancel();
+}
 
+std::mutex& Project::AssetManager::getParserMutex() {
+  static std::mutex mtx{};
+  return mtx;
 }
 
 void Project::AssetManager::reloadEntry(AssetManagerEntry &entry, const std::string &path)
@@ -225,39 +255,81 @@ void Project::AssetManager::reloadEntry(AssetManagerEntry &entry, const std::str
     case FileType::IMAGE:
     {
       bool isMono = Utils::isTexFormatMono(static_cast<Utils::TexFormat>(entry.conf.format));
-      entry.texture = std::make_shared<Renderer::Texture>(ctx.gpu, path, isMono);
+      if (!asyncLoading) {
+        entry.texture = std::make_shared<Renderer::Texture>(ctx.gpu, path, isMono);
+        break;
+      }
+
+      // keep showing the previous texture (or a placeholder) until the new one is uploaded
+      if (!entry.texture) {
+        entry.texture = getFallbackTexture();
+      }
+
+      auto load = std::make_shared<ImageLoad>();
+      loader.add([load, path, isMono] {
+        load->img = Renderer::Texture::loadImage(path, isMono);
+      }, [this, load, path] {
+        auto entry = getByPath(path);
+        if (!entry || entry->type != FileType::IMAGE)return;
+        if (!load->img) {
+          Utils::Logger::log("Failed to load image asset: " + path, Utils::Logger::LEVEL_ERROR);
+          return;
+        }
+        entry->texture = std::make_shared<Renderer::Texture>(ctx.gpu, load->img);
+      });
     } break;
 
     case FileType::PREFAB:
     {
       entry.prefab = std::make_shared<Prefab>();
       entry.prefab->deserialize(Utils::FS::loadTextFile(path));
+      ++revision;
     } break;
 
     case FileType::MODEL_3D:
     {
-      try{
-        T3DM::config = {
-          .globalScale = (float)entry.conf.baseScale,
-          .animSampleRate = 60,
-          //.ignoreMaterials = args.checkArg("--ignore-materials"),
-          //.ignoreTransforms = args.checkArg("--ignore-transforms"),
-          .createBVH = entry.conf.gltfBVH,
-          .verbose = false,
-          .assetPath = "assets/",
-          .assetPathFull = fs::absolute(project->getPath() + "/assets").string(),
-        };
-
-        entry.t3dmData = T3DM::parseGLTF(path.c_str());
-        if (!entry.t3dmData.models.empty()) {
-          if (!entry.mesh3D) {
-            entry.mesh3D = std::make_shared<Renderer::N64Mesh>();
-          }
-          entry.mesh3D->fromT3DM(entry.t3dmData, *this);
+      decltype(T3DM::config) config = {
+        .globalScale = (float)entry.conf.baseScale,
+        .animSampleRate = 60,
+        //.ignoreMaterials = args.checkArg("--ignore-materials"),
+        //.ignoreTransforms = args.checkArg("--ignore-transforms"),
+        .createBVH = entry.conf.gltfBVH,
+        .verbose = false,
+        .assetPath = "assets/",
+        .assetPathFull = fs::absolute(project->getPath() + "/assets").string(),
+      };
+
+      auto load = std::make_shared<ModelLoad>();
+      auto parse = [load, config, path] {
+        std::lock_guard lock{getParserMutex()};
+        try {
+          T3DM::config = config;
+          load->t3dmData = T3DM::parseGLTF(path.c_str());
+        } catch (std::exception &e) {
+          load->error = e.what();
         }
-      } catch (std::exception &e) {
-        Utils::Logger::log("Failed to load 3D model asset: " + entry.path + " - " + e.what(), Utils::Logger::LEVEL_ERROR);
+      };
+
+      auto finish = [this, load](AssetManagerEntry &entry) {
+        if (!load->error.empty()) {
+          Utils::Logger::log("Failed to load 3D model asset: " + entry.path + " - " + load->error, Utils::Logger::LEVEL_ERROR);
+          return;
+        }
+        entry.t3dmData = std::move(load->t3dmData);
+        applyModel(entry);
+      };
+
+      if (!asyncLoading) {
+        parse();
+        finish(entry);
+        break;
       }
+
+      // textures referenced by the model are queued before, so they are in place once this gets applied
+      loader.add(parse, [this, finish, path] {
+        auto entry = getByPath(path);
+        if (entry && entry->type == FileType::MODEL_3D)finish(*entry);
+      });
     }
     break;
 
@@ -265,22 +337,47 @@ void Project::AssetManager::reloadEntry(AssetManagerEntry &entry, const std::str
   }
 }
 
+void Project::AssetManager::applyModel(AssetManagerEntry &entry)
+{
+  if (entry.t3dmData.models.empty())return;
+  if (!entry.mesh3D) {
+    entry.mesh3D = std::make_shared<Renderer::N64Mesh>();
+  }
+  entry.mesh3D->fromT3DM(entry.t3dmData, *this);
+  ++revision;
+}
+
+void Project::AssetManager::updateLoading()
+{
+  loader.update(LOAD_BUDGET_US);
+}
+
 void Project::AssetManager::reload() {
+  // only the editor itself loads in the background, CLI and builds need all data right away
+  loader.cancel();
+  asyncLoading = ctx.window && SDL_IsMainThread();
+
   for (auto &e : entries)e.clear();
   entriesMap.clear();
-  watchFiles.clear();
-  watchInitialized = false;
+  entriesPathMap.clear();
+
+  auto assetPath = getAssetPath(project);
+  auto codePath = getCodePath(project);
 
-  auto assetPath = fs::path{project->getPath()} / "assets";
-  if (!fs::exists(assetPath)) {
-    fs::create_directory(assetPath);
+  // start watching before the scan, changes during it are applied on the next poll.
+  // like background loading this is editor-only, CLI runs and project copies on other threads never poll it.
+  if (!asyncLoading) {
+    watcher.stop();
+  } else if (watcher.isRunning()) {
+    watcher.discard();
+  } else {
+    watcher.start({assetPath, codePath});
   }
 
   // scan all files
   for (const auto &entry : fs::recursive_directory_iterator{assetPath}) {
     if (entry.is_regular_file()) {
       auto path = entry.path();
-      watchFiles[path.string()] = Utils::FS::getFileAge(path);
       AssetManagerEntry assetEntry{};
       if (!buildAssetEntry(project, path, assetEntry)) {
         continue;
@@ -303,22 +400,11 @@ void Project::AssetManager::reload() {
     }
   }
 
-  // now load models (after all textures are there now)
-  for (auto &typed : entries) {
-    for (auto &entry : typed) {
-      if (entry.type == FileType::MODEL_3D) {
-        reloadEntry(entry, entry.path);
-      }
-    }
-  }
-
-  auto codePath = getCodePath(project);
   for (const auto &entry : fs::recursive_directory_iterator{codePath}) {
     if (entry.is_regular_file()) {
       auto path = entry.path();
       if (path.extension().string() != ".cpp") continue;
 
-      watchFiles[path.string()] = Utils::FS::getFileAge(path);
       AssetManagerEntry codeEntry{};
       if (!buildCodeEntry(path, codeEntry)) {
         continue;
@@ -335,170 +421,72 @@ void Project::AssetManager::reload() {
     });
   }
 
-  for (auto &typed : entries)
-  {
-    int idx = 0;
-    for (auto &entry : typed)
-    {
-      entriesMap[entry.getUUID()] = {(int)entry.type, idx};
-      ++idx;
-    }
+  for (size_t typeIdx = 0; typeIdx < entries.size(); ++typeIdx) {
+    updateEntryIndices(static_cast<int>(typeIdx), 0);
+  }
+
+  // now load models (after all textures are there and can be looked up by path)
+  for (auto &entry : entries[(int)FileType::MODEL_3D]) {
+    reloadEntry(entry, entry.path);
   }
 }
 
 bool Project::AssetManager::pollWatch()
 {
-  using Clock = std::chrono::steady_clock;
-  // Check for changes every 2 seconds
-  constexpr auto kMinInterval = std::chrono::milliseconds(2000);
-
-  auto now = Clock::now();
-  if (watchInitialized && (now - watchLastCheck) < kMinInterval) {
+  auto events = watcher.poll();
+  if (events.empty()) {
     return false;
   }
-  watchInitialized = true;
-  watchLastCheck = now;
-
-  // Snapshot current files so we can diff against watchFiles
-  std::unordered_map<std::string, uint64_t> currentFiles{};
-  std::vector<std::string> addedAssets{};
-  std::vector<std::string> modifiedAssets{};
-  std::vector<std::string> addedCode{};
-  std::vector<std::string> modifiedCode{};
-  std::vector<std::string> removedPaths{};
-
-  // Detect added/modified asset files
-  auto assetPath = fs::path{project->getPath()} / "assets";
-  if (fs::exists(assetPath)) {
-    for (const auto &entry : fs::recursive_directory_iterator{assetPath}) {
-      if (!entry.is_regular_file()) continue;
-      auto path = entry.path();
-      auto pathStr = path.string();
-      uint64_t age = Utils::FS::getFileAge(path);
-
-      currentFiles[pathStr] = age;
-      auto it = watchFiles.find(pathStr);
-      if (it == watchFiles.end()) {
-        addedAssets.push_back(pathStr);
-      } else if (it->second != age) {
-        modifiedAssets.push_back(pathStr);
-      }
-    }
-  }
 
-  // Detect added/modified script files.
   auto codePath = getCodePath(project);
-  if (fs::exists(codePath)) {
-    for (const auto &entry : fs::recursive_directory_iterator{codePath}) {
-      if (!entry.is_regular_file()) continue;
-      auto path = entry.path();
-      if (path.extension().string() != ".cpp") continue;
-
-      auto pathStr = path.string();
-      uint64_t age = Utils::FS::getFileAge(path);
-
-      currentFiles[pathStr] = age;
-      auto it = watchFiles.find(pathStr);
-      if (it == watchFiles.end()) {
-        addedCode.push_back(pathStr);
-      } else if (it->second != age) {
-        modifiedCode.push_back(pathStr);
-      }
-    }
-  }
-
-  // Anything missing from the snapshot is treated as removed
-  for (const auto &pair : watchFiles) {
-    if (currentFiles.find(pair.first) == currentFiles.end()) {
-      removedPaths.push_back(pair.first);
-    }
-  }
-
-  // Bail out if nothing changed
-  bool changed = !addedAssets.empty() || !modifiedAssets.empty() ||
-                 !addedCode.empty() || !modifiedCode.empty() ||
-                 !removedPaths.empty();
-  if (!changed) {
-    return false;
-  }
-
-  // Track which entry lists we need to re-sort
-  std::unordered_set<int> touchedTypes{};
   std::vector<std::string> modelReloadPaths{};
 
-  // Remove an entry by absolute path across all lists
-  auto removeEntryByPath = [&](const std::string &pathStr) {
-    fs::path pathIn{pathStr};
-    for (size_t typeIdx = 0; typeIdx < entries.size(); ++typeIdx) {
-      auto &typed = entries[typeIdx];
-      for (size_t i = 0; i < typed.size(); ++i) {
-        if (fs::path{typed[i].path} == pathIn) {
-          typed.erase(typed.begin() + i);
-          touchedTypes.insert(static_cast<int>(typeIdx));
-          return true;
-        }
-      }
+  for (const auto &event : events)
+  {
+    if (event.type == Utils::FileWatcher::EventType::RESCAN) {
+      Utils::Logger::log("Asset changes got lost, reloading all assets", Utils::Logger::LEVEL_WARN);
+      reload();
+      return true;
     }
-    return false;
-  };
 
-  for (const auto &pathStr : removedPaths) {
-    removeEntryByPath(pathStr);
-  }
+    fs::path path{event.path};
+    auto relCodePath = path.lexically_relative(codePath);
+    bool isCode = !relCodePath.empty() && *relCodePath.begin() != "..";
+    if (isCode && path.extension().string() != ".cpp") {
+      continue;
+    }
 
-  // Rebuild a single asset entry and reload if needed
-  auto addOrUpdateAsset = [&](const std::string &pathStr) {
     AssetManagerEntry newEntry{};
-    if (!buildAssetEntry(project, fs::path{pathStr}, newEntry)) {
-      return;
+    bool valid = event.type == Utils::FileWatcher::EventType::CHANGED && fs::is_regular_file(path);
+    if (valid) {
+      valid = isCode ? buildCodeEntry(path, newEntry) : buildAssetEntry(project, path, newEntry);
     }
 
-    removeEntryByPath(pathStr);
-    entries[static_cast<int>(newEntry.type)].push_back(std::move(newEntry));
-    touchedTypes.insert(static_cast<int>(newEntry.type));
-
-    auto entry = getByPath(pathStr);
-    if (!entry) {
-      return;
+    // files that got removed or are no longer a valid asset
+    if (!valid) {
+      removeEntry(event.path);
+      continue;
     }
 
-    if (entry->type == FileType::MODEL_3D) {
-      modelReloadPaths.push_back(pathStr);
-      return;
+    // keep using the current data until the reload is done
+    auto oldEntry = getByPath(event.path);
+    if (oldEntry && oldEntry->type == newEntry.type) {
+      newEntry.texture = oldEntry->texture;
+      newEntry.mesh3D = oldEntry->mesh3D;
+      newEntry.t3dmData = std::move(oldEntry->t3dmData);
     }
 
-    if (entry->type == FileType::IMAGE || entry->type == FileType::PREFAB) {
-      reloadEntry(*entry, entry->path);
-      if (entry->type == FileType::PREFAB && entry->prefab) {
-        entry->conf.uuid = entry->prefab->uuid.value;
+    if (newEntry.type == FileType::IMAGE || newEntry.type == FileType::PREFAB) {
+      reloadEntry(newEntry, newEntry.path);
+      if (newEntry.type == FileType::PREFAB && newEntry.prefab) {
+        newEntry.conf.uuid = newEntry.prefab->uuid.value;
       }
     }
-  };
 
-  // Rebuild a single script entry
-  auto addOrUpdateCode = [&](const std::string &pathStr) {
-    AssetManagerEntry newEntry{};
-    if (!buildCodeEntry(fs::path{pathStr}, newEntry)) {
-      return;
+    if (newEntry.type == FileType::MODEL_3D) {
+      modelReloadPaths.push_back(newEntry.path);
     }
-
-    removeEntryByPath(pathStr);
-    entries[static_cast<int>(newEntry.type)].push_back(std::move(newEntry));
-    touchedTypes.insert(static_cast<int>(newEntry.type));
-  };
-
-  // Add or update all the assets and scripts that were found
-  for (const auto &pathStr : addedAssets) {
-    addOrUpdateAsset(pathStr);
-  }
-  for (const auto &pathStr : modifiedAssets) {
-    addOrUpdateAsset(pathStr);
-  }
-  for (const auto &pathStr : addedCode) {
-    addOrUpdateCode(pathStr);
-  }
-  for (const auto &pathStr : modifiedCode) {
-    addOrUpdateCode(pathStr);
+    setEntry(std::move(newEntry));
   }
 
   // Reload models after texture updates are applied
@@ -509,32 +497,72 @@ bool Project::AssetManager::pollWatch()
     }
   }
 
-  //sort by name
-  for (size_t typeIdx = 0; typeIdx < entries.size(); ++typeIdx) {
-    if (touchedTypes.find(static_cast<int>(typeIdx)) == touchedTypes.end()) {
-      continue;
+  return true;
+}
+
+Project::AssetManagerEntry* Project::AssetManager::setEntry(AssetManagerEntry &&entry)
+{
+  auto type = static_cast<int>(entry.type);
+  auto itPath = entriesPathMap.find(getPathKey(entry.path));
+
+  // same file, update in place to keep the sort order and indices
+  if (itPath != entriesPathMap.end() && itPath->second.first == type) {
+    auto &existing = entries[type][itPath->second.second];
+    if (existing.getUUID() != entry.getUUID()) {
+      entriesMap.erase(existing.getUUID());
+      entriesMap[entry.getUUID()] = itPath->second;
     }
-    auto &typed = entries[typeIdx];
-    std::sort(typed.begin(), typed.end(), [](const AssetManagerEntry &a, const AssetManagerEntry &b) {
-      return a.name < b.name;
-    });
+    existing = std::move(entry);
+    return &existing;
   }
 
-  // Rebuild UUID lookup after edits
-  entriesMap.clear();
-  for (auto &typed : entries) {
-    int idx = 0;
-    for (auto &entry : typed) {
-      entriesMap[entry.getUUID()] = {(int)entry.type, idx};
-      ++idx;
+  // e.g. a script that changed between object and global script
+  if (itPath != entriesPathMap.end()) {
+    removeEntry(entry.path);
+  }
+
+  auto &typed = entries[type];
+  auto pos = std::upper_bound(typed.begin(), typed.end(), entry.name,
+    [](const std::string &name, const AssetManagerEntry &e) {
+      return name < e.name;
     }
+  );
+  int idx = static_cast<int>(pos - typed.begin());
+  typed.insert(pos, std::move(entry));
+  updateEntryIndices(type, idx);
+  return &typed[idx];
+}
+
+bool Project::AssetManager::removeEntry(const std::string &path)
+{
+  auto itPath = entriesPathMap.find(getPathKey(path));
+  if (itPath == entriesPathMap.end()) {
+    return false;
   }
 
-  // Update watcher snapshot for next poll
-  watchFiles = std::move(currentFiles);
+  auto [type, idx] = itPath->second;
+  auto &typed = entries[type];
+
+  auto itUUID = entriesMap.find(typed[idx].getUUID());
+  if (itUUID != entriesMap.end() && itUUID->second == itPath->second) {
+    entriesMap.erase(itUUID);
+  }
+  entriesPathMap.erase(itPath);
+
+  typed.erase(typed.begin() + idx);
+  updateEntryIndices(type, idx);
   return true;
 }
 
+void Project::AssetManager::updateEntryIndices(int type, int startIdx)
+{
+  auto &typed = entries[type];
+  for (int idx = startIdx; idx < static_cast<int>(typed.size()); ++idx) {
+    entriesMap[typed[idx].getUUID()] = {type, idx};
+    entriesPathMap[getPathKey(typed[idx].path)] = {type, idx};
+  }
+}
+
 void Project::AssetManager::reloadAssetByUUID(uint64_t uuid) {
   auto asset = getEntryByUUID(uuid);
   if (!asset)return;
@@ -563,11 +591,9 @@ void Project::AssetManager::save()
 
       auto oldFile = Utils::FS::loadTextFile(pathMeta);
 
-      // if the meta-data changed, force a recompile of the asset by deleting the target
+      // meta-data is part of the build-cache key, so changes here trigger a rebuild on their own
       if (oldFile == json)continue;
-      Utils::Logger::log("Asset meta-data changed, forcing recompile: " + entry.outPath, Utils::Logger::LEVEL_INFO);
-      fs::remove(project->getPath() + "/" + entry.outPath);
-      Utils::FS::saveTextFile(pathMeta, entry.conf.serialize());
+      Utils::FS::saveTextFile(pathMeta, json);
     }
   }
 }
@@ -638,13 +664,9 @@ uint64_t Project::AssetManager::createNodeGraph(const std::string &name)
 
 Project::AssetManagerEntry *Project::AssetManager::getByPath(const std::string &path)
 {
-  fs::path pathIn{path};
-  for (auto &typed : entries) {
-    for (auto &entry : typed) {
-      if (fs::path{entry.path} == pathIn) {
-        return &entry;
-      }
-    }
+  auto it = entriesPathMap.find(getPathKey(path));
+  if (it == entriesPathMap.end()) {
+    return nullptr;
   }
-  return nullptr;
+  return &entries[it->second.first][it->second.second];
 }
\ No newline at end of file
@@ -3,14 +3,16 @@
 * @license MIT
 */
 #pragma once
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
-#include <chrono>
 
 #include "../renderer/n64Mesh.h"
 #include "../renderer/object.h"
+#include "../utils/asyncLoader.h"
 #include "../utils/codeParser.h"
+#include "../utils/fileWatcher.h"
 #include "../renderer/texture.h"
 #include "scene/prefab.h"
 #include "tiny3d/tools/gltf_importer/src/structs.h"
@@ -91,14 +93,24 @@ namespace Project
       Project *project;
       std::array<std::vector<AssetManagerEntry>, static_cast<size_t>(FileType::_SIZE)> entries{};
 
-      std::unordered_map<std::string, uint64_t> watchFiles{};
-      std::chrono::steady_clock::time_point watchLastCheck{};
-      bool watchInitialized{false};
+      Utils::FileWatcher watcher{};
+      // normalized path -> (type, index), kept in sync with 'entriesMap'
+      std::unordered_map<std::string, std::pair<int, int>> entriesPathMap{};
 
       std::string defaultScript{};
       std::shared_ptr<Renderer::Texture> fallbackTex{};
 
+      // textures and models are loaded in the background in the editor, see 'updateLoading()'
+      Utils::AsyncLoader loader{};
+      bool asyncLoading{false};
+      uint32_t revision{0};
+
       void reloadEntry(AssetManagerEntry &entry, const std::string &path);
+      void applyModel(AssetManagerEntry &entry);
+
+      AssetManagerEntry* setEntry(AssetManagerEntry &&entry);
+      bool removeEntry(const std::string &path);
+      void updateEntryIndices(int type, int startIdx);
     public:
       std::unordered_map<uint64_t, std::pair<int, int>> entriesMap{};
       //std::unordered_map<uint64_t, int> entriesMapScript{};
@@ -110,6 +122,26 @@ namespace Project
       void reloadAssetByUUID(uint64_t uuid);
       bool pollWatch();
 
+      /**
+       * Applies finished background loads (GPU uploads etc.), call once per frame.
+       */
+      void updateLoading();
+      [[nodiscard]] bool isLoading() { return loader.isBusy(); }
+
+      /**
+       * Bumped whenever a model or prefab got (re-)loaded, anything caching their bounds has to re-check.
+       */
+      [[nodiscard]] uint32_t getRevision() const { return revision; }
+      [[nodiscard]] float getLoadingProgress() const {
+        auto total = loader.getJobsTotal();
+        return total == 0 ? 1.0f : (float)loader.getJobsApplied() / (float)total;
+      }
+
+      /**
+       * The glTF parser works on global state, anything calling it must hold this lock.
+       */
+      static std::mutex& getParserMutex();
+
       [[nodiscard]] const auto& getEntries() const {
         return entries;
       }
@@ -10,6 +10,8 @@
 #include "bvh/v2/node.h"
 #include "bvh/v2/default_builder.h"
 
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 using Scalar  = double;
@@ -59,12 +61,15 @@ namespace
 
       int16_t packedVal = (int16_t)(indexDiff << 4);
       if((packedVal >> 4) != indexDiff) {
-        printf("Error: indexDiff %d (%d - %d) does not fit in 12 bits\n", indexDiff, dataOffset, nodeIndex);
-        throw;
+        throw std::runtime_error("BVH node offset " + std::to_string(indexDiff)
+          + " (" + std::to_string(dataOffset) + " - " + std::to_string(nodeIndex) + ") does not fit in 12 bits");
       }
-      //assert((packedVal >> 4) == indexDiff);
       out.push_back(packedVal);
     } else {
+      // the runtime reads the data offset as a signed 12-bit value too
+      if(dataOffset > 0x7FF) {
+        throw std::runtime_error("BVH data offset " + std::to_string(dataOffset) + " does not fit in 12 bits");
+      }
       out.push_back(node.index.value);
     }
   }
@@ -9,6 +9,11 @@
 
 namespace Project::Assets::Collision
 {
+  /**
+   * Builds the BVH in the runtime format (see 'Coll::BVH').
+   * Throws if the tree does not fit into the 12-bit node/data offsets,
+   * which can happen for meshes with more than ~2000 triangles.
+   */
   std::vector<int16_t> createBVH(
     const std::vector<glm::i16vec3> &vertices,
     const std::vector<uint16_t> &indices
@@ -196,6 +196,11 @@ namespace Project::Component::AnimModel
   Utils::AABB getAABB(Object &obj, Entry &entry) {
     Data &data = *static_cast<Data*>(entry.data.get());
     Utils::AABB aabb = data.aabb;
+    if(aabb.min.x > aabb.max.x) {
+      // not drawn yet, the viewport still needs bounds to decide whether to draw it
+      auto asset = ctx.project->getAssets().getEntryByUUID(data.model.value);
+      if(asset && asset->mesh3D)aabb = asset->mesh3D->getAABB();
+    }
     aabb.min *= (float)0xFFFF;
     aabb.max *= (float)0xFFFF;
     return aabb;
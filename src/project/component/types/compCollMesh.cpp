@@ -25,6 +25,7 @@ namespace Project::Component::CollMesh
   struct Data
   {
     PROP_U64(modelUUID);
+    PROP_U32(maskWrite);
     Shared::MeshFilter filter{};
     Renderer::Object obj3D{};
     Utils::AABB aabb{};
@@ -39,6 +40,7 @@ namespace Project::Component::CollMesh
     Data &data = *static_cast<Data*>(entry.data.get());
     return Utils::JSON::Builder{}
       .set(data.modelUUID)
+      .set(data.maskWrite)
       .set(data.filter.meshFilter)
       .doc;
   }
@@ -46,6 +48,7 @@ namespace Project::Component::CollMesh
   std::shared_ptr<void> deserialize(nlohmann::json &doc) {
     auto data = std::make_shared<Data>();
     Utils::JSON::readProp(doc, data->modelUUID);
+    Utils::JSON::readProp(doc, data->maskWrite, 0xFFu);
     Utils::JSON::readProp(doc, data->filter.meshFilter);
     return data;
   }
@@ -95,6 +98,7 @@ namespace Project::Component::CollMesh
 
     ctx.fileObj.write<uint16_t>(id);
     ctx.fileObj.write<uint8_t>(flags);
+    ctx.fileObj.write<uint8_t>(data.maskWrite.resolve(obj.propOverrides));
   }
 
   void draw(Object &obj, Entry &entry)
@@ -134,6 +138,8 @@ namespace Project::Component::CollMesh
         data.modelUUID.value = selModel->getUUID();
       }
 
+      ImTable::addBitMask8("Mask Write", data.maskWrite.resolve(obj.propOverrides));
+
       ImTable::end();
 
       if(selModel && ImGui::CollapsingSubHeader("Mesh Filter", ImGuiTreeNodeFlags_DefaultOpen) && ImTable::start("Filter", &obj))
@@ -210,6 +216,11 @@ namespace Project::Component::CollMesh
   Utils::AABB getAABB(Object &obj, Entry &entry) {
     Data &data = *static_cast<Data*>(entry.data.get());
     Utils::AABB aabb = data.aabb;
+    if(aabb.min.x > aabb.max.x) {
+      // not drawn yet, the viewport still needs bounds to decide whether to draw it
+      auto asset = ctx.project->getAssets().getEntryByUUID(data.modelUUID.resolve(obj.propOverrides));
+      if(asset && asset->mesh3D)aabb = asset->mesh3D->getAABB();
+    }
     aabb.min *= (float)0xFFFF;
     aabb.max *= (float)0xFFFF;
     return aabb;
@@ -13,6 +13,7 @@ namespace Project::Graph::Node
   class ObjEvent : public Base
   {
     private:
+      int target{}; // 0: object, 1: children of object, 2: all objects
       uint16_t objectId{};
       uint16_t eventType{};
       std::string eventValue{};
@@ -44,8 +45,11 @@ namespace Project::Graph::Node
             }
           }
 
-          ImTable::add("Object");
-          ImGui::VectorComboBox("##", entries, objectId);
+          ImTable::addComboBox("Target", target, {"Object", "Children", "Broadcast"});
+          if(target != 2) {
+            ImTable::add("Object");
+            ImGui::VectorComboBox("##", entries, objectId);
+          }
           ImTable::add("Type", eventType);
           ImTable::add("Value", eventValue);
           ImTable::end();
@@ -53,12 +57,14 @@ namespace Project::Graph::Node
       }
 
       void serialize(nlohmann::json &j) override {
+        j["target"] = target;
         j["objectId"] = objectId;
         j["eventType"] = eventType;
         j["eventValue"] = eventValue;
       }
 
       void deserialize(nlohmann::json &j) override {
+        target = j.value("target", 0);
         objectId = j.value("objectId", 0);
         eventType = j.value("eventType", 0);
         eventValue = j.value("eventValue", "0");
@@ -73,13 +79,21 @@ namespace Project::Graph::Node
           eventValue = '"' + eventValue + "\"_hash";
         }
 
-        ctx.localConst("uint16_t", "t_objId", objectId)
-          .localConst("uint16_t", "t_eventType", eventType)
-          .localConst("uint32_t", "t_eventVal", eventValue)
+        ctx.localConst("uint16_t", "t_eventType", eventType)
+          .localConst("uint32_t", "t_eventVal", eventValue);
+
+        if(target == 2) {
+          ctx.line("inst->object->getScene().broadcastEvent(");
+        } else {
+          ctx.localConst("uint16_t", "t_objId", objectId)
+            .line(target == 1
+              ? "inst->object->getScene().sendEventToChildren("
+              : "inst->object->getScene().sendEvent("
+            )
+            .line("  t_objId == 0 ? inst->object->id : t_objId,");
+        }
 
-          .line("inst->object->getScene().sendEvent(")
-          .line("  t_objId == 0 ? inst->object->id : t_objId,")
-          .line("  inst->object->id,")
+        ctx.line("  inst->object->id,")
           .line("  t_eventType,")
           .line("  t_eventVal")
           .line(");");
@@ -14,7 +14,7 @@ using Builder = Utils::JSON::Builder;
 
 namespace
 {
-  nlohmann::json serializeObj(const Project::Object &obj)
+  nlohmann::json serializeObj(const Project::Object &obj, bool withChildren)
   {
     Builder builder{};
     builder.set("id", obj.id);
@@ -47,10 +47,11 @@ namespace
       comps.push_back(c);
     }
     builder.doc["components"] = comps;
+    if(!withChildren)return builder.doc;
 
     nlohmann::json children = nlohmann::json::array();
     for (const auto &child : obj.children) {
-      children.push_back(serializeObj(*child));
+      children.push_back(serializeObj(*child, true));
     }
     builder.set("children", children);
     return builder.doc;
@@ -80,8 +81,8 @@ void Project::Object::removeComponent(uint64_t uuid) {
   );
 }
 
-nlohmann::json Project::Object::serialize() const {
-  return serializeObj(*this);
+nlohmann::json Project::Object::serialize(bool withChildren) const {
+  return serializeObj(*this, withChildren);
 }
 
 void Project::Object::deserialize(Scene *scene, nlohmann::json &doc)
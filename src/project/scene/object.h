@@ -40,6 +40,9 @@ namespace Project
       bool selectable{true};
       bool isPrefabEdit{false};
 
+      // bumped by 'markChanged', used by the editor to find edited objects without comparing their data
+      uint32_t revision{0};
+
       std::unordered_map<uint64_t, GenericValue> propOverrides{};
 
       std::vector<std::shared_ptr<Object>> children{};
@@ -51,9 +54,16 @@ namespace Project
       void addComponent(int compID);
       void removeComponent(uint64_t uuid);
 
-      nlohmann::json serialize() const;
+      nlohmann::json serialize(bool withChildren = true) const;
       void deserialize(Scene *scene, nlohmann::json &doc);
 
+      /**
+       * Only bumps the revision, use 'Scene::markObjectChanged' when editing objects in a scene.
+       */
+      void markChanged() {
+        ++revision;
+      }
+
       bool isPrefabInstance() const {
         return uuidPrefab.value != 0;
       }
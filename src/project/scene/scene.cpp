@@ -54,6 +54,53 @@ nlohmann::json Project::SceneConf::serialize() const {
   return builder.doc;
 }
 
+void Project::SceneConf::deserialize(nlohmann::json &docConf)
+{
+  Utils::JSON::readProp(docConf, name, std::string{"New Scene"});
+  fbWidth = docConf.value("fbWidth", 320);
+  fbHeight = docConf.value("fbHeight", 240);
+  fbFormat = docConf.value("fbFormat", 0);
+  Utils::JSON::readProp(docConf, clearColor);
+  Utils::JSON::readProp(docConf, doClearColor);
+  Utils::JSON::readProp(docConf, doClearDepth);
+  Utils::JSON::readProp(docConf, renderPipeline);
+  Utils::JSON::readProp(docConf, frameLimit, 0);
+  Utils::JSON::readProp(docConf, filter, 0);
+  Utils::JSON::readProp(docConf, audioFreq, 32000);
+
+  auto readLayer = [](const nlohmann::json &dom) {
+    LayerConf layer{};
+    Utils::JSON::readProp(dom, layer.name);
+    Utils::JSON::readProp(dom, layer.depthCompare, true);
+    Utils::JSON::readProp(dom, layer.depthWrite, true);
+    Utils::JSON::readProp(dom, layer.blender);
+    Utils::JSON::readProp(dom, layer.fog, false);
+    Utils::JSON::readProp(dom, layer.fogColorMode, 0u);
+    Utils::JSON::readProp(dom, layer.fogColor);
+    Utils::JSON::readProp(dom, layer.fogMin, 0.0f);
+    Utils::JSON::readProp(dom, layer.fogMax, 0.0f);
+
+
+    return layer;
+  };
+
+  layers3D.clear();
+  layersPtx.clear();
+  layers2D.clear();
+  for(auto &item : docConf["layers3D"]) {
+    layers3D.push_back(readLayer(item));
+  }
+  for(auto &item : docConf["layersPtx"]) {
+    layersPtx.push_back(readLayer(item));
+  }
+  for(auto &item : docConf["layers2D"]) {
+    layers2D.push_back(readLayer(item));
+  }
+  if(layers3D.empty()) {
+    resetLayers();
+  }
+}
+
 Project::Scene::Scene(int id_, const std::string &projectPath)
   : id{id_}
 {
@@ -104,6 +151,7 @@ std::shared_ptr<Project::Object> Project::Scene::addObject(Object&parent, std::s
   };
 
   setChildUUIDs(obj, setChildUUIDs);
+  changes.markStructure();
   return obj;
 }
 
@@ -136,11 +184,13 @@ void Project::Scene::removeObject(Object &obj) {
     [&obj](const std::shared_ptr<Object> &ref) { return ref->uuid == obj.uuid; }
   );
   objectsMap.erase(obj.uuid);
+  changes.markStructure();
 }
 
 void Project::Scene::removeAllObjects() {
   objectsMap.clear();
   root.children.clear();
+  changes.markStructure();
 }
 
 bool Project::Scene::moveObject(uint32_t uuidObject, uint32_t uuidTarget, bool asChild)
@@ -188,6 +238,7 @@ bool Project::Scene::moveObject(uint32_t uuidObject, uint32_t uuidTarget, bool a
     }
   }
 
+  changes.markStructure();
   return true;
 }
 
@@ -228,36 +279,36 @@ std::string Project::Scene::serialize(bool minify) {
   return doc.dump(minify ? -1 : 2);
 }
 
-void Project::Scene::resetLayers()
+void Project::SceneConf::resetLayers()
 {
-  conf.layers3D.clear();
-  conf.layersPtx.clear();
-  conf.layers2D.clear();
+  layers3D.clear();
+  layersPtx.clear();
+  layers2D.clear();
 
   LayerConf layer{};
   layer.name.value = "3D Opaque";
   layer.depthCompare.value = true;
   layer.depthWrite.value = true;
   layer.blender.value = 0;
-  conf.layers3D.push_back(layer);
+  layers3D.push_back(layer);
 
   layer.name.value = "3D Transp.";
   layer.depthCompare.value = true;
   layer.depthWrite.value = false;
   layer.blender.value = RDPQ_BLENDER_MULTIPLY;
-  conf.layers3D.push_back(layer);
+  layers3D.push_back(layer);
 
   layer.name.value = "PTX Opaque";
   layer.depthCompare.value = true;
   layer.depthWrite.value = true;
   layer.blender.value = 0;
-  conf.layersPtx.push_back(layer);
+  layersPtx.push_back(layer);
 
   layer.name.value = "2D";
   layer.depthCompare.value = false;
   layer.depthWrite.value = false;
   layer.blender.value = 0;
-  conf.layers2D.push_back(layer);
+  layers2D.push_back(layer);
 }
 
 void Project::Scene::deserialize(const std::string &data)
@@ -267,52 +318,7 @@ void Project::Scene::deserialize(const std::string &data)
     nullptr, false);
   if (!doc.is_object())return;
 
-  auto &docConf = doc["conf"];
-  {
-    Utils::JSON::readProp(docConf, conf.name, std::string{"New Scene"});
-    conf.fbWidth = docConf.value("fbWidth", 320);
-    conf.fbHeight = docConf.value("fbHeight", 240);
-    conf.fbFormat = docConf.value("fbFormat", 0);
-    Utils::JSON::readProp(docConf, conf.clearColor);
-    Utils::JSON::readProp(docConf, conf.doClearColor);
-    Utils::JSON::readProp(docConf, conf.doClearDepth);
-    Utils::JSON::readProp(docConf, conf.renderPipeline);
-    Utils::JSON::readProp(docConf, conf.frameLimit, 0);
-    Utils::JSON::readProp(docConf, conf.filter, 0);
-    Utils::JSON::readProp(docConf, conf.audioFreq, 32000);
-
-    auto readLayer = [](const nlohmann::json &dom) {
-      LayerConf layer{};
-      Utils::JSON::readProp(dom, layer.name);
-      Utils::JSON::readProp(dom, layer.depthCompare, true);
-      Utils::JSON::readProp(dom, layer.depthWrite, true);
-      Utils::JSON::readProp(dom, layer.blender);
-      Utils::JSON::readProp(dom, layer.fog, false);
-      Utils::JSON::readProp(dom, layer.fogColorMode, 0u);
-      Utils::JSON::readProp(dom, layer.fogColor);
-      Utils::JSON::readProp(dom, layer.fogMin, 0.0f);
-      Utils::JSON::readProp(dom, layer.fogMax, 0.0f);
-
-
-      return layer;
-    };
-
-    conf.layers3D.clear();
-    conf.layersPtx.clear();
-    conf.layers2D.clear();
-    for(auto &item : docConf["layers3D"]) {
-      conf.layers3D.push_back(readLayer(item));
-    }
-    for(auto &item : docConf["layersPtx"]) {
-      conf.layersPtx.push_back(readLayer(item));
-    }
-    for(auto &item : docConf["layers2D"]) {
-      conf.layers2D.push_back(readLayer(item));
-    }
-    if(conf.layers3D.empty()) {
-      resetLayers();
-    }
-  }
+  conf.deserialize(doc["conf"]);
 
   removeAllObjects();
   if(!doc.contains("graph"))return;
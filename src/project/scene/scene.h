@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "object.h"
+#include "sceneChanges.h"
 
 namespace Project
 {
@@ -44,6 +45,9 @@ namespace Project
     std::vector<LayerConf> layers2D{};
 
     nlohmann::json serialize() const;
+    void deserialize(nlohmann::json &docConf);
+
+    void resetLayers();
   };
 
   class Scene
@@ -55,6 +59,7 @@ namespace Project
 
     public:
       SceneConf conf{};
+      SceneChanges changes{};
 
       Scene(int id_, const std::string &projectPath);
 
@@ -77,6 +82,15 @@ namespace Project
 
       bool moveObject(uint32_t uuidObject, uint32_t uuidTarget, bool asChild);
 
+      /**
+       * Has to be called after changing an object that is not selected (e.g. children moved along with their parent),
+       * selected objects are always checked for changes.
+       */
+      void markObjectChanged(Object &obj) {
+        obj.markChanged();
+        changes.markObject(obj.uuid);
+      }
+
       std::shared_ptr<Object> getObjectByUUID(uint32_t uuid) {
         if (objectsMap.contains(uuid)) {
           return objectsMap[uuid];
@@ -88,7 +102,7 @@ namespace Project
 
       std::string serialize(bool minify = false);
 
-      void resetLayers();
+      void resetLayers() { conf.resetLayers(); }
 
       void deserialize(const std::string &data);
 
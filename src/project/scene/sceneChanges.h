@@ -0,0 +1,60 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Project
+{
+  /**
+   * Log of edits in a scene, lets the editor update cached data (e.g. the viewport's spatial index)
+   * without walking all objects to find what changed.
+   *
+   * Edited objects are appended by UUID, readers remember the count they last saw and only look at newer ones.
+   * The log is capped, readers that fall too far behind get told so and have to refresh everything.
+   * Adding, removing, moving or (un-)hiding objects only bumps the structure revision.
+   */
+  class SceneChanges
+  {
+    private:
+      constexpr static uint32_t MAX_OBJECTS = 4096;
+      // shared by all scenes, so a reader switching to another scene always sees a different revision
+      static inline uint32_t nextStructureRevision{0};
+
+      std::vector<uint32_t> objects{};
+      uint64_t objectsDropped{0};
+      uint32_t structureRevision{0};
+
+    public:
+      void markObject(uint32_t uuid) {
+        if(objects.size() >= MAX_OBJECTS) {
+          objects.erase(objects.begin(), objects.begin() + MAX_OBJECTS / 2);
+          objectsDropped += MAX_OBJECTS / 2;
+        }
+        objects.push_back(uuid);
+      }
+
+      void markStructure() {
+        structureRevision = ++nextStructureRevision;
+      }
+
+      [[nodiscard]] uint64_t getObjectCount() const { return objectsDropped + objects.size(); }
+      [[nodiscard]] uint32_t getStructureRevision() const { return structureRevision; }
+
+      /**
+       * Calls 'cb(uuid)' for each object marked since the given count (see 'getObjectCount').
+       * The same object can show up multiple times.
+       * @return false if some of these changes were already dropped, nothing is called then
+       */
+      template<typename F>
+      bool forEachObject(uint64_t since, F &&cb) const {
+        if(since < objectsDropped)return false;
+        for(uint64_t i = since - objectsDropped; i < objects.size(); ++i) {
+          cb(objects[i]);
+        }
+        return true;
+      }
+  };
+}
@@ -5,6 +5,9 @@
 #include "framebuffer.h"
 #include "../context.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 Renderer::Framebuffer::Framebuffer()
 {
   texInfo.width = 0;
@@ -42,6 +45,13 @@ Renderer::Framebuffer::~Framebuffer() {
   if (transBufferRead) {
     SDL_ReleaseGPUTransferBuffer(ctx.gpu, transBufferRead);
   }
+  for (auto &read : readbacks) {
+    if (read.fence) {
+      SDL_WaitForGPUFences(ctx.gpu, true, &read.fence, 1);
+      SDL_ReleaseGPUFence(ctx.gpu, read.fence);
+    }
+    if (read.buffer)SDL_ReleaseGPUTransferBuffer(ctx.gpu, read.buffer);
+  }
   if(gpuTex)SDL_ReleaseGPUTexture(ctx.gpu, gpuTex);
   if(gpuTexObj)SDL_ReleaseGPUTexture(ctx.gpu, gpuTexObj);
   if(gpuTexDepth)SDL_ReleaseGPUTexture(ctx.gpu, gpuTexDepth);
@@ -79,6 +89,14 @@ void Renderer::Framebuffer::resize(uint32_t width, uint32_t height)
   targetInfo[0].texture = gpuTex;
   targetInfo[1].texture = gpuTexObj;
   depthTargetInfo.texture = gpuTexDepth;
+
+  targetInfoLoad = targetInfo;
+  depthTargetInfoLoad = depthTargetInfo;
+  for (auto &info : targetInfoLoad) {
+    info.load_op = SDL_GPU_LOADOP_LOAD;
+  }
+  depthTargetInfoLoad.load_op = SDL_GPU_LOADOP_LOAD;
+  depthTargetInfoLoad.stencil_load_op = SDL_GPU_LOADOP_LOAD;
 }
 
 void* Renderer::Framebuffer::startGenericRead(uint32_t x, uint32_t y) {
@@ -148,3 +166,93 @@ uint32_t Renderer::Framebuffer::readObjectID(uint32_t x, uint32_t y) {
   return res;
 }
 
+
+bool Renderer::Framebuffer::requestObjectIDs(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint32_t requestId)
+{
+  auto read = std::find_if(readbacks.begin(), readbacks.end(), [](const Readback &r) { return !r.inUse; });
+  if (read == readbacks.end())return false;
+
+  read->inUse = true;
+  read->requestId = requestId;
+  read->pixelCount = 0;
+
+  x = std::min(x, texInfo.width);
+  y = std::min(y, texInfo.height);
+  w = std::min(w, texInfo.width - x);
+  h = std::min(h, texInfo.height - y);
+  if (w == 0 || h == 0 || !gpuTexObj)return true; // reported as empty by the next poll
+
+  read->pixelCount = w * h;
+  uint32_t byteSize = read->pixelCount * sizeof(uint32_t);
+  if (byteSize > read->capacity) {
+    if (read->buffer)SDL_ReleaseGPUTransferBuffer(ctx.gpu, read->buffer);
+    read->capacity = std::max(byteSize, 256u);
+
+    SDL_GPUTransferBufferCreateInfo tbci{};
+    tbci.size = read->capacity;
+    tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+    read->buffer = SDL_CreateGPUTransferBuffer(ctx.gpu, &tbci);
+  }
+
+  SDL_GPUCommandBuffer* cmdBuff = SDL_AcquireGPUCommandBuffer(ctx.gpu);
+  SDL_GPUCopyPass *pass = SDL_BeginGPUCopyPass(cmdBuff);
+
+  SDL_GPUTextureRegion src{};
+  src.texture = gpuTexObj;
+  src.x = x;
+  src.y = y;
+  src.w = w;
+  src.h = h;
+  src.d = 1;
+
+  SDL_GPUTextureTransferInfo dst{};
+  dst.transfer_buffer = read->buffer;
+  dst.pixels_per_row = w;
+  dst.rows_per_layer = h;
+
+  SDL_DownloadFromGPUTexture(pass, &src, &dst);
+  SDL_EndGPUCopyPass(pass);
+
+  // submitted after the frame, so the queue order guarantees it sees the finished ID target
+  read->fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmdBuff);
+  return true;
+}
+
+bool Renderer::Framebuffer::pollObjectIDs(uint32_t &requestId, std::vector<uint32_t> &outIDs)
+{
+  for (auto &read : readbacks)
+  {
+    if (!read.inUse)continue;
+    if (read.fence) {
+      if (!SDL_QueryGPUFence(ctx.gpu, read.fence))continue;
+      SDL_ReleaseGPUFence(ctx.gpu, read.fence);
+      read.fence = nullptr;
+    }
+
+    requestId = read.requestId;
+    outIDs.clear();
+
+    if (read.pixelCount > 0)
+    {
+      auto data = static_cast<const uint32_t*>(SDL_MapGPUTransferBuffer(ctx.gpu, read.buffer, false));
+      // neighboring pixels mostly share the same ID, only look up the set on changes
+      std::unordered_set<uint32_t> ids{};
+      uint32_t lastID = data[0];
+      ids.insert(lastID);
+      for (uint32_t i=1; i<read.pixelCount; ++i) {
+        if (data[i] != lastID) {
+          lastID = data[i];
+          ids.insert(lastID);
+        }
+      }
+      SDL_UnmapGPUTransferBuffer(ctx.gpu, read.buffer);
+
+      outIDs.assign(ids.begin(), ids.end());
+      std::sort(outIDs.begin(), outIDs.end());
+    }
+
+    read.inUse = false;
+    return true;
+  }
+  return false;
+}
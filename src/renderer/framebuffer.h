@@ -3,6 +3,8 @@
 * @license MIT
 */
 #pragma once
+#include <array>
+#include <vector>
 #include <SDL3/SDL.h>
 
 #include "glm/vec4.hpp"
@@ -18,9 +20,24 @@ namespace Renderer
       SDL_GPUTexture* gpuTexDepth{nullptr};
       std::array<SDL_GPUColorTargetInfo, 2> targetInfo{};
       SDL_GPUDepthStencilTargetInfo depthTargetInfo{};
+      // same targets but keeping their content, for passes continuing a previous one
+      std::array<SDL_GPUColorTargetInfo, 2> targetInfoLoad{};
+      SDL_GPUDepthStencilTargetInfo depthTargetInfoLoad{};
 
       SDL_GPUTransferBuffer *transBufferRead{nullptr};
 
+      // in-flight async reads of the object-ID target
+      struct Readback
+      {
+        SDL_GPUTransferBuffer *buffer{nullptr};
+        SDL_GPUFence *fence{nullptr};
+        uint32_t capacity{0};
+        uint32_t pixelCount{0};
+        uint32_t requestId{0};
+        bool inUse{false};
+      };
+      std::array<Readback, 4> readbacks{};
+
       void* startGenericRead(uint32_t x, uint32_t y);
       void endGenericRead();
 
@@ -44,9 +61,27 @@ namespace Renderer
       [[nodiscard]] uint32_t getTargetInfoCount() const { return targetInfo.size(); }
 
       [[nodiscard]] const SDL_GPUDepthStencilTargetInfo& getDepthTargetInfo() const { return depthTargetInfo; }
+
+      [[nodiscard]] const SDL_GPUColorTargetInfo *getTargetInfoLoad() const { return targetInfoLoad.data(); }
+      [[nodiscard]] const SDL_GPUDepthStencilTargetInfo& getDepthTargetInfoLoad() const { return depthTargetInfoLoad; }
       [[nodiscard]] SDL_GPUTexture* getTexture() const { return gpuTex; }
 
       glm::u8vec4 readColor(uint32_t x, uint32_t y);
       uint32_t readObjectID(uint32_t x, uint32_t y);
+
+      /**
+       * Starts reading back all object-IDs in a rectangle, without waiting for the GPU.
+       * Must be called after the frame was submitted, the rectangle is clipped to the framebuffer.
+       * @return false if all read-back slots are in use, try again next frame
+       */
+      bool requestObjectIDs(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint32_t requestId);
+
+      /**
+       * Checks for a finished 'requestObjectIDs', usually one or two frames later.
+       * @param requestId set to the ID passed into 'requestObjectIDs'
+       * @param outIDs unique object-IDs found in the rectangle (including 0 for the background)
+       * @return true if a request finished
+       */
+      bool pollObjectIDs(uint32_t &requestId, std::vector<uint32_t> &outIDs);
   };
 }
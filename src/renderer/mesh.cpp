@@ -44,21 +44,54 @@ void Renderer::Mesh::recreate(Renderer::Scene &scene, bool clearData) {
   });
 }
 
-void Renderer::Mesh::draw(SDL_GPURenderPass* pass, uint32_t indexOffset, uint32_t indexCount) {
-  if (!dataReady || !vertBuff)return;
+void Renderer::Mesh::recreateDynamic(RingBuffer &ring) {
+  dynBuffer = nullptr;
+  dataReady = false;
+  if (indices.empty())return;
+
+  bool isLines = !vertLines.empty();
+  const void* vertData = isLines ? (const void*)vertLines.data() : (const void*)vertices.data();
+  uint32_t vertSize = isLines
+    ? vertLines.size() * sizeof(LineVertex)
+    : vertices.size() * sizeof(Vertex);
+
+  if (!ring.push(vertData, vertSize, dynVerts))return;
+  if (!ring.push(indices.data(), indices.size() * sizeof(uint16_t), dynIndices))return;
+
+  dynBuffer = ring.getBuffer();
+  dynIndexCount = indices.size();
+  dataReady = true;
+}
+
+void Renderer::Mesh::draw(SDL_GPURenderPass* pass, uint32_t indexOffset, uint32_t indexCount, int32_t vertexOffset) {
+  if (!bind(pass))return;
 
   if (indexCount == 0) {
-    indexCount = vertBuff->getIndexCount() - indexOffset;
+    indexCount = (dynBuffer ? dynIndexCount : vertBuff->getIndexCount()) - indexOffset;
   }
+  drawBound(pass, indexOffset, indexCount, vertexOffset);
+}
+
+bool Renderer::Mesh::bind(SDL_GPURenderPass* pass) {
+  if (!dataReady)return false;
 
   SDL_GPUBufferBinding bufferBindings[2];
-  vertBuff->addBindings(bufferBindings);
+  if (dynBuffer) {
+    bufferBindings[0] = {dynBuffer, dynVerts.offset};
+    bufferBindings[1] = {dynBuffer, dynIndices.offset};
+  } else {
+    if (!vertBuff)return false;
+    vertBuff->addBindings(bufferBindings);
+  }
 
   SDL_BindGPUVertexBuffers(pass, 0, bufferBindings, 1);
   SDL_BindGPUIndexBuffer(pass, &bufferBindings[1], SDL_GPU_INDEXELEMENTSIZE_16BIT);
+  return true;
+}
 
+void Renderer::Mesh::drawBound(SDL_GPURenderPass* pass, uint32_t indexOffset, uint32_t indexCount, int32_t vertexOffset) {
   //SDL_DrawGPUPrimitives(pass, vertices.size(), 1, 0, 0); // unindexed
-  SDL_DrawGPUIndexedPrimitives(pass, indexCount, 1, indexOffset, 0, 0);
+  SDL_DrawGPUIndexedPrimitives(pass, indexCount, 1, indexOffset, vertexOffset, 0);
 }
 
 Renderer::Mesh::Mesh() {
@@ -5,6 +5,7 @@
 #pragma once
 #include <SDL3/SDL.h>
 
+#include "ringBuffer.h"
 #include "vertBuffer.h"
 #include "vertex.h"
 #include "../utils/aabb.h"
@@ -21,6 +22,12 @@ namespace Renderer
       bool dataReady = false;
       Utils::AABB aabb{};
 
+      // set by 'recreateDynamic', only valid for the current frame
+      SDL_GPUBuffer *dynBuffer{nullptr};
+      RingBuffer::Alloc dynVerts{};
+      RingBuffer::Alloc dynIndices{};
+      uint32_t dynIndexCount{0};
+
     public:
       std::vector<Renderer::Vertex> vertices{};
       std::vector<Renderer::LineVertex> vertLines{};
@@ -28,7 +35,21 @@ namespace Renderer
 
       void recreate(Renderer::Scene &scene, bool clearData = true);
 
-      void draw(SDL_GPURenderPass* pass, uint32_t indexOffset = 0, uint32_t indexCount = 0);
+      /**
+       * Alternative to 'recreate' for meshes that change every frame.
+       * Data is placed in the ring-buffer instead of dedicated GPU buffers, and is not cleared afterward.
+       * The ring-buffer must be uploaded before drawing.
+       */
+      void recreateDynamic(RingBuffer &ring);
+
+      void draw(SDL_GPURenderPass* pass, uint32_t indexOffset = 0, uint32_t indexCount = 0, int32_t vertexOffset = 0);
+
+      /**
+       * Split version of 'draw', to issue multiple draws with the buffers only bound once.
+       * 'drawBound' must only be called if 'bind' returned true.
+       */
+      bool bind(SDL_GPURenderPass* pass);
+      void drawBound(SDL_GPURenderPass* pass, uint32_t indexOffset, uint32_t indexCount, int32_t vertexOffset = 0);
 
       const Utils::AABB& getAABB() const { return aabb; }
 
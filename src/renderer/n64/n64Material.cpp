@@ -11,6 +11,10 @@ namespace
 {
   constexpr uint64_t RDPQ_COMBINER_2PASS = (uint64_t)(1) << 63;
 
+  // other-modes (lower word), set together by libdragon if the blender uses the framebuffer color
+  constexpr uint32_t SOM_BLENDING    = 1 << 14;
+  constexpr uint32_t SOM_READ_ENABLE = 1 << 6;
+
   constexpr uint32_t getBits(uint64_t value, uint32_t start, uint32_t end) {
     return (value << (63 - end)) >> (63 - end + start);
   }
@@ -28,6 +32,26 @@ namespace
   }
 }
 
+bool Renderer::N64Material::isTranslucent(const UniformN64Material &mat, const glm::vec4 &colPrim, const glm::vec4 &colEnv)
+{
+  constexpr uint32_t SOM_BLEND_READ = SOM_BLENDING | SOM_READ_ENABLE;
+  if ((mat.otherModeL & SOM_BLEND_READ) == SOM_BLEND_READ)return true;
+
+  bool alphaClip = mat.lightDir[0].w > 0.0f;
+  if (alphaClip)return false;
+
+  auto isOne = [&](int32_t sel) {
+    return sel == CC_A_1
+      || (sel == CC_A_PRIM && colPrim.a >= 1.0f)
+      || (sel == CC_A_ENV && colEnv.a >= 1.0f);
+  };
+
+  // (A - B) * C + D of the last cycle, same for both cycles in 1-cycle mode
+  auto &cc = mat.cc1Alpha;
+  bool noDelta = cc[0] == cc[1] || cc[2] == CC_A_0;
+  return !(noDelta && isOne(cc[3]));
+}
+
 void Renderer::N64Material::convert(N64Mesh::MeshPart &part, const T3DM::Material &t3dMat)
 {
   auto &texA = t3dMat.texA;
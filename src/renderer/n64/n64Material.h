@@ -9,4 +9,11 @@
 namespace Renderer::N64Material
 {
   void convert(N64Mesh::MeshPart &part, const T3DM::Material &t3dMat);
+
+  /**
+   * True if the result depends on what was drawn before: either the blender reads the framebuffer,
+   * or the final combiner alpha can be below 1 (and is not alpha-clipped).
+   * Prim/Env colors are passed separately since draws can override the ones of the material.
+   */
+  bool isTranslucent(const UniformN64Material &mat, const glm::vec4 &colPrim, const glm::vec4 &colEnv);
 }
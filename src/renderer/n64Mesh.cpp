@@ -7,8 +7,10 @@
 #include "../project/assetManager.h"
 #include <filesystem>
 
+#include "renderQueue.h"
 #include "scene.h"
 #include "n64/n64Material.h"
+#include "tiny3d/tools/gltf_importer/src/lib/meshopt/meshoptimizer.h"
 
 namespace fs = std::filesystem;
 extern SDL_GPUSampler *texSamplerRepeat; // @TODO make sampler manager? is this even needed?
@@ -25,19 +27,22 @@ void Renderer::N64Mesh::fromT3DM(const T3DM::T3DMData &t3dmData, Project::AssetM
   mesh.vertices.clear();
   mesh.indices.clear();
   parts.clear();
+  stats = {};
 
   parts.resize(t3dmData.models.size());
   auto part = parts.begin();
 
-  uint16_t idx = 0;
+  std::vector<Vertex> vertsRaw{};
+  std::vector<uint32_t> remap{};
+  std::vector<uint32_t> indices{};
+  std::vector<int32_t> rangeIndex{};
+  float acmrSum = 0.0f;
+
   for (auto &model : t3dmData.models)
   {
     part->refTex0 = assetManager.getFallbackTexture();
     part->refTex1 = part->refTex0;
 
-    part->indicesOffset = mesh.indices.size();
-    part->indicesCount = model.triangles.size() * 3;
-
     N64Material::convert(*part, model.material);
 
     part->texBindings[0].texture = part->refTex0.lock()->getGPUTex();
@@ -60,36 +65,81 @@ void Renderer::N64Mesh::fromT3DM(const T3DM::T3DMData &t3dmData, Project::AssetM
       }
     }
 
-    //model.material.colorCombiner
+    vertsRaw.clear();
     for (auto &tri : model.triangles) {
-
       for (auto &vert : tri.vert) {
-
         uint8_t r = (vert.rgba >> 24) & 0xFF;
         uint8_t g = (vert.rgba >> 16) & 0xFF;
         uint8_t b = (vert.rgba >> 8) & 0xFF;
         uint8_t a = (vert.rgba >> 0) & 0xFF;
 
-        mesh.vertices.push_back({
+        vertsRaw.push_back({
           {vert.pos[0], vert.pos[1], vert.pos[2]},
           vert.norm,
           {r,g,b,a},
           glm::ivec2(vert.s, vert.t)
         });
-        /*printf("v: %d,%d,%d norm: %d uv: %d,%d col: %08X\n",
-          vert.pos[0], vert.pos[1], vert.pos[2],
-          vert.norm,
-          vert.s, vert.t,
-          vert.rgba
-        );*/
       }
-
-      mesh.indices.push_back(idx++);
-      mesh.indices.push_back(idx++);
-      mesh.indices.push_back(idx++);
     }
 
     ++part;
+    if (vertsRaw.empty())continue;
+    auto &currPart = *(part - 1);
+
+    // weld identical vertices (pos, normal, color, uv), 'Vertex' has no padding so a byte compare works
+    static_assert(sizeof(Vertex) == 16);
+    uint32_t indexCount = vertsRaw.size();
+    remap.resize(indexCount);
+    uint32_t vertCount = meshopt_generateVertexRemap(remap.data(), nullptr, indexCount, vertsRaw.data(), indexCount, sizeof(Vertex));
+
+    std::vector<Vertex> verts(vertCount);
+    meshopt_remapVertexBuffer(verts.data(), vertsRaw.data(), indexCount, sizeof(Vertex), remap.data());
+
+    indices.resize(indexCount);
+    meshopt_remapIndexBuffer(indices.data(), nullptr, indexCount, remap.data());
+    meshopt_optimizeVertexCache(indices.data(), indices.data(), indexCount, vertCount);
+    acmrSum += meshopt_analyzeVertexCache(indices.data(), indexCount, vertCount, 16, 0, 0).acmr * (float)(indexCount / 3);
+
+    // Emit vertices in the order they are first used (better fetch locality),
+    // starting a new range whenever the 16-bit index space of the current one is full.
+    rangeIndex.assign(vertCount, -1);
+    DrawRange *range = nullptr;
+    for (uint32_t i=0; i<indexCount; i+=3)
+    {
+      uint32_t newVerts = 0;
+      for (uint32_t j=0; j<3; ++j) {
+        if (rangeIndex[indices[i+j]] < 0)++newVerts;
+      }
+
+      if (!range || (mesh.vertices.size() - range->vertexOffset + newVerts) > 0x10000) {
+        range = &currPart.ranges.emplace_back();
+        range->indicesOffset = mesh.indices.size();
+        range->vertexOffset = mesh.vertices.size();
+        if (currPart.ranges.size() > 1)rangeIndex.assign(vertCount, -1);
+      }
+
+      for (uint32_t j=0; j<3; ++j) {
+        auto &localIdx = rangeIndex[indices[i+j]];
+        if (localIdx < 0) {
+          localIdx = mesh.vertices.size() - range->vertexOffset;
+          mesh.vertices.push_back(verts[indices[i+j]]);
+        }
+        mesh.indices.push_back(localIdx);
+      }
+      range->indicesCount += 3;
+    }
+
+    stats.vertCountRaw += indexCount;
+    stats.rangeCount += currPart.ranges.size();
+  }
+
+  stats.vertCount = mesh.vertices.size();
+  stats.indexCount = mesh.indices.size();
+  stats.acmr = stats.indexCount ? (acmrSum / (float)(stats.indexCount / 3)) : 0.0f;
+
+  aabb.reset();
+  for (const auto& v : mesh.vertices) {
+    aabb.addPoint(glm::vec3(v.pos) * (1.0f / 65536.0f));
   }
 }
 
@@ -99,23 +149,23 @@ void Renderer::N64Mesh::recreate(Renderer::Scene &sc) {
   loaded = true;
 }
 
-void Renderer::N64Mesh::draw(
-  SDL_GPURenderPass* pass, SDL_GPUCommandBuffer *cmdBuff, UniformsObject &uniforms,
+void Renderer::N64Mesh::addToQueue(
+  RenderQueue &queue, const UniformsObject &uniforms,
   const std::vector<uint32_t> &partsIndices,
   const UniformsOverrides& overrides
 )
 {
   if (!scene)return;
+  uint32_t objIdx = queue.addObject(uniforms.modelMat, uniforms.mat.flags, uniforms.objectID);
 
-  auto drawPart = [&](MeshPart &part)
+  auto addPart = [&](MeshPart &part)
   {
     if(part.refTex1.expired() || part.refTex0.expired()) {
       loaded = false;
       return;
     }
 
-    uint32_t flags = uniforms.mat.flags;
-
+    // colors not set by a material persist across draws, resolve them here as the queue may reorder draws
     if(part.material.flags & UniformN64Material::FLAG_SET_PRIM_COL) {
       lastPrim = part.material.colPrim;
     } else {
@@ -128,50 +178,19 @@ void Renderer::N64Mesh::draw(
       if(overrides.setEnv)lastEnv = overrides.colEnv;
     }
 
-    uniforms.mat = part.material;
-    uniforms.mat.colPrim = lastPrim;
-    uniforms.mat.colEnv = lastEnv;
-
-    uniforms.mat.flags |= flags;
-
-    // @TODO: move out
-    float clip = uniforms.mat.lightDir[0].w;
-    const auto &lights = scene->getLights();
-    int lightIdx = 0;
-    for (auto &light : lights) {
-      if (light.type == 0) {
-        uniforms.mat.ambientColor = light.color;
-      } else {
-        if (lightIdx < 2)
-        {
-          uniforms.mat.lightDir[lightIdx] = glm::vec4(light.dir, 0.0f);
-          uniforms.mat.lightColor[lightIdx] = light.color;
-          ++lightIdx;
-        }
-      }
-    }
-    uniforms.mat.lightDir[0].w = clip;
-
-    SDL_BindGPUFragmentSamplers(pass, 0, part.texBindings, 2);
-    SDL_BindGPUVertexSamplers(pass, 0, part.texBindings, 2); // needed?
-
-    SDL_PushGPUVertexUniformData(cmdBuff, 1, &uniforms, sizeof(uniforms));
-    SDL_PushGPUFragmentUniformData(cmdBuff, 0, &uniforms, sizeof(uniforms));
-
-    mesh.draw(pass, part.indicesOffset, part.indicesCount);
+    queue.add(mesh, part, objIdx, lastPrim, lastEnv);
   };
 
   if(partsIndices.empty())
   {
     for (auto &part : parts) {
-      drawPart(part);
+      addPart(part);
     }
   } else {
     for (auto idx : partsIndices) {
       if (idx < parts.size()) {
-        drawPart(parts[idx]);
+        addPart(parts[idx]);
       }
     }
   }
-  //mesh.draw(pass);
 }
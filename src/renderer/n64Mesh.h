@@ -12,13 +12,22 @@ namespace Project { class AssetManager; }
 
 namespace Renderer
 {
+  class RenderQueue;
+
   class N64Mesh
   {
     public:
-      struct MeshPart
+      // indices are 16-bit and relative to 'vertexOffset', big parts are split into multiple ranges
+      struct DrawRange
       {
         uint32_t indicesOffset{0};
         uint32_t indicesCount{0};
+        int32_t vertexOffset{0};
+      };
+
+      struct MeshPart
+      {
+        std::vector<DrawRange> ranges{};
         UniformN64Material material{};
 
         SDL_GPUTextureSamplerBinding texBindings[2]{};
@@ -26,10 +35,25 @@ namespace Renderer
         std::weak_ptr<Renderer::Texture> refTex0{};
         std::weak_ptr<Renderer::Texture> refTex1{};
       };
+      struct Stats
+      {
+        uint32_t vertCount{}; // after welding
+        uint32_t vertCountRaw{}; // 3 per triangle
+        uint32_t indexCount{};
+        uint32_t rangeCount{};
+        float acmr{}; // avg. vertex shader invocations per triangle, after cache optimization
+
+        [[nodiscard]] uint32_t getGPUSize() const {
+          return vertCount * sizeof(Vertex) + indexCount * sizeof(uint16_t);
+        }
+      };
+
     private:
 
       Mesh mesh{};
       std::vector<MeshPart> parts{};
+      Utils::AABB aabb{}; // known before the mesh is uploaded, unlike the one in 'mesh'
+      Stats stats{};
       bool loaded{false};
       Renderer::Scene *scene{};
 
@@ -37,13 +61,17 @@ namespace Renderer
       void fromT3DM(const T3DM::T3DMData &t3dmData, Project::AssetManager &assetManager);
 
       void recreate(Renderer::Scene &sc);
-      void draw(
-        SDL_GPURenderPass* pass, SDL_GPUCommandBuffer *cmdBuff, UniformsObject &uniforms,
+      /**
+       * Queues all parts (or only those in 'partsIndices' if not empty), drawn once the queue is flushed.
+       */
+      void addToQueue(
+        RenderQueue &queue, const UniformsObject &uniforms,
         const std::vector<uint32_t> &partsIndices,
         const UniformsOverrides& overrides = {}
       );
 
-      const Utils::AABB& getAABB() const { return mesh.getAABB(); }
+      const Utils::AABB& getAABB() const { return aabb; }
+      const Stats& getStats() const { return stats; }
       bool isLoaded() const { return loaded; }
   };
 }
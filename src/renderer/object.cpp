@@ -4,6 +4,8 @@
 */
 #include "object.h"
 #include "../context.h"
+#include "renderQueue.h"
+#include "scene.h"
 
 #include "glm/ext/matrix_transform.hpp"
 
@@ -27,6 +29,6 @@ void Renderer::Object::draw(
     mesh->draw(pass);
   }
   if(n64Mesh) {
-    n64Mesh->draw(pass, cmdBuff, uniform, parts, overrides);
+    n64Mesh->addToQueue(ctx.scene->getRenderQueue(), uniform, parts, overrides);
   }
 }
@@ -42,6 +42,9 @@ namespace Renderer
       void setPos(const glm::vec3& p) { pos = p; transformDirty = true; }
       void setScale(float s) { scale = s; transformDirty = true; }
 
+      /**
+       * Plain meshes are drawn directly, N64 meshes only get added to the scene's render-queue.
+       */
       void draw(
         SDL_GPURenderPass* pass,
         SDL_GPUCommandBuffer* cmdBuff,
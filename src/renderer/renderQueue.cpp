@@ -0,0 +1,131 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "renderQueue.h"
+
+#include <algorithm>
+
+#include "scene.h"
+#include "n64/n64Material.h"
+
+namespace
+{
+  constexpr uint64_t KEY_TRANSLUCENT = 1ull << 63;
+  constexpr uint32_t KEY_ID_MASK = 0x7FFF;
+
+  bool isSameBinding(const SDL_GPUTextureSamplerBinding &a, const SDL_GPUTextureSamplerBinding &b) {
+    return a.texture == b.texture && a.sampler == b.sampler;
+  }
+
+  uint64_t getSortId(std::unordered_map<const void*, uint32_t> &ids, const void* ptr) {
+    auto [it, _] = ids.try_emplace(ptr, ids.size());
+    return std::min(it->second, KEY_ID_MASK); // only affects sorting, not correctness
+  }
+}
+
+uint32_t Renderer::RenderQueue::addObject(const glm::mat4 &modelMat, uint32_t flags, uint32_t objectID)
+{
+  objects.push_back({modelMat, flags, objectID});
+  return objects.size() - 1;
+}
+
+void Renderer::RenderQueue::add(
+  Mesh &mesh, const N64Mesh::MeshPart &part, uint32_t objIdx,
+  const glm::vec4 &colPrim, const glm::vec4 &colEnv
+) {
+  // textures are the most expensive to switch, then vertex/index buffers, then uniforms
+  uint64_t key = KEY_TRANSLUCENT;
+  if(!N64Material::isTranslucent(part.material, colPrim, colEnv)) {
+    key = (getSortId(sortIds, part.texBindings[0].texture) << 45)
+        | (getSortId(sortIds, part.texBindings[1].texture) << 30)
+        | (getSortId(sortIds, &mesh) << 15)
+        |  getSortId(sortIds, &part);
+  }
+  items.push_back({key, &mesh, &part, objIdx, colPrim, colEnv});
+}
+
+void Renderer::RenderQueue::flush(SDL_GPURenderPass* pass, SDL_GPUCommandBuffer* cmdBuff, const Scene &scene)
+{
+  if(items.empty()) {
+    objects.clear();
+    sortIds.clear();
+    return;
+  }
+
+  // translucent items all share the same key, so they end up last and keep their submission order
+  std::stable_sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+    return a.sortKey < b.sortKey;
+  });
+
+  const auto &lights = scene.getLightState();
+
+  const SDL_GPUTextureSamplerBinding *lastTex{nullptr};
+  const Mesh *lastMesh{nullptr};
+  const N64Mesh::MeshPart *lastPart{nullptr};
+  uint32_t lastObjIdx{UINT32_MAX};
+  glm::vec4 lastPrim{};
+  glm::vec4 lastEnv{};
+  bool meshBound{false};
+
+  for(auto &item : items)
+  {
+    auto &part = *item.part;
+    auto &obj = objects[item.objIdx];
+
+    if(!lastTex || !isSameBinding(lastTex[0], part.texBindings[0]) || !isSameBinding(lastTex[1], part.texBindings[1])) {
+      SDL_BindGPUFragmentSamplers(pass, 0, part.texBindings, 2);
+      SDL_BindGPUVertexSamplers(pass, 0, part.texBindings, 2); // needed?
+      lastTex = part.texBindings;
+      ++stats.textureBinds;
+    }
+
+    if(item.mesh != lastMesh) {
+      meshBound = item.mesh->bind(pass);
+      lastMesh = item.mesh;
+      ++stats.meshBinds;
+    }
+    if(!meshBound)continue;
+
+    bool objChanged = item.objIdx != lastObjIdx;
+    if(objChanged || &part != lastPart || item.colPrim != lastPrim || item.colEnv != lastEnv)
+    {
+      if(objChanged) {
+        uniforms.modelMat = obj.modelMat;
+        uniforms.objectID = obj.objectID;
+      }
+
+      uniforms.mat = part.material;
+      uniforms.mat.colPrim = item.colPrim;
+      uniforms.mat.colEnv = item.colEnv;
+      uniforms.mat.flags |= obj.flags;
+
+      float clip = uniforms.mat.lightDir[0].w;
+      if(lights.hasAmbient)uniforms.mat.ambientColor = lights.ambientColor;
+      for(int i=0; i<lights.dirCount; ++i) {
+        uniforms.mat.lightDir[i] = lights.dir[i];
+        uniforms.mat.lightColor[i] = lights.color[i];
+      }
+      uniforms.mat.lightDir[0].w = clip;
+
+      SDL_PushGPUVertexUniformData(cmdBuff, 1, &uniforms, sizeof(uniforms));
+      SDL_PushGPUFragmentUniformData(cmdBuff, 0, &uniforms, sizeof(uniforms));
+      ++stats.uniformPushes;
+
+      lastObjIdx = item.objIdx;
+      lastPart = &part;
+      lastPrim = item.colPrim;
+      lastEnv = item.colEnv;
+    }
+
+    for(auto &range : part.ranges) {
+      item.mesh->drawBound(pass, range.indicesOffset, range.indicesCount, range.vertexOffset);
+      ++stats.draws;
+    }
+    if(item.sortKey & KEY_TRANSLUCENT)++stats.translucent;
+  }
+
+  items.clear();
+  objects.clear();
+  sortIds.clear();
+}
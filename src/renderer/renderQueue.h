@@ -0,0 +1,85 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <SDL3/SDL.h>
+
+#include "n64Mesh.h"
+#include "uniforms.h"
+
+namespace Renderer
+{
+  class Scene;
+
+  /**
+   * Collects all N64-mesh draws of a render-pass and submits them in one go.
+   *
+   * Opaque draws are sorted by textures, mesh and material, and state is only set if it differs from the previous draw.
+   * Translucent draws (see 'N64Material::isTranslucent') come after all opaque ones, in submission order.
+   * Any per-part state that depends on the draw order (prim/env colors carried over from previous parts)
+   * is resolved when adding, so the result matches drawing everything in submission order.
+   *
+   * Sort keys use the order in which textures/meshes were first seen instead of their addresses,
+   * so the draw order is the same on every run. Draws with identical keys keep their submission order.
+   */
+  class RenderQueue
+  {
+    public:
+      struct Stats
+      {
+        uint32_t draws{};
+        uint32_t textureBinds{};
+        uint32_t meshBinds{};
+        uint32_t uniformPushes{};
+        uint32_t translucent{};
+      };
+
+    private:
+      struct ObjectState
+      {
+        glm::mat4 modelMat{};
+        uint32_t flags{};
+        uint32_t objectID{};
+      };
+
+      struct Item
+      {
+        uint64_t sortKey{};
+        Mesh *mesh{};
+        const N64Mesh::MeshPart *part{};
+        uint32_t objIdx{};
+        glm::vec4 colPrim{};
+        glm::vec4 colEnv{};
+      };
+
+      std::vector<ObjectState> objects{};
+      std::vector<Item> items{};
+      std::unordered_map<const void*, uint32_t> sortIds{}; // first-seen order of textures, meshes and parts
+      UniformsObject uniforms{};
+      Stats stats{};
+
+    public:
+      /**
+       * Registers the per-object state used by all following 'add' calls for that object.
+       * @return index to pass into 'add'
+       */
+      uint32_t addObject(const glm::mat4 &modelMat, uint32_t flags, uint32_t objectID);
+
+      void add(Mesh &mesh, const N64Mesh::MeshPart &part, uint32_t objIdx, const glm::vec4 &colPrim, const glm::vec4 &colEnv);
+
+      /**
+       * Sorts and draws everything queued so far, then empties the queue.
+       * Expects the N64 pipeline to be bound already.
+       */
+      void flush(SDL_GPURenderPass* pass, SDL_GPUCommandBuffer* cmdBuff, const Scene &scene);
+
+      [[nodiscard]] bool isEmpty() const { return items.empty(); }
+
+      void resetStats() { stats = {}; }
+      [[nodiscard]] const Stats& getStats() const { return stats; }
+  };
+}
@@ -0,0 +1,141 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "ringBuffer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+Renderer::RingBuffer::RingBuffer(SDL_GPUDevice* device, uint32_t frameCapacity)
+  : gpuDevice{device}
+{
+  create(frameCapacity);
+}
+
+Renderer::RingBuffer::~RingBuffer()
+{
+  for (auto &fence : fences) {
+    if (fence) {
+      SDL_WaitForGPUFences(gpuDevice, true, &fence, 1);
+      SDL_ReleaseGPUFence(gpuDevice, fence);
+      fence = nullptr;
+    }
+  }
+  release();
+}
+
+void Renderer::RingBuffer::create(uint32_t capacity)
+{
+  frameCapacity = (capacity + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+  SDL_GPUBufferCreateInfo bufferInfo{
+    .usage = SDL_GPU_BUFFERUSAGE_VERTEX | SDL_GPU_BUFFERUSAGE_INDEX,
+    .size = frameCapacity * FRAME_COUNT
+  };
+  buffer = SDL_CreateGPUBuffer(gpuDevice, &bufferInfo);
+  assert(buffer != nullptr);
+
+  SDL_GPUTransferBufferCreateInfo transferInfo{
+    .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+    .size = frameCapacity * FRAME_COUNT
+  };
+  bufferTrans = SDL_CreateGPUTransferBuffer(gpuDevice, &transferInfo);
+  assert(bufferTrans != nullptr);
+}
+
+void Renderer::RingBuffer::release()
+{
+  if (mapped) {
+    SDL_UnmapGPUTransferBuffer(gpuDevice, bufferTrans);
+    mapped = nullptr;
+  }
+  SDL_ReleaseGPUBuffer(gpuDevice, buffer);
+  SDL_ReleaseGPUTransferBuffer(gpuDevice, bufferTrans);
+  buffer = nullptr;
+  bufferTrans = nullptr;
+}
+
+void Renderer::RingBuffer::beginFrame()
+{
+  if (mapped) {
+    SDL_UnmapGPUTransferBuffer(gpuDevice, bufferTrans);
+    mapped = nullptr;
+  }
+
+  if (requiredSize > frameCapacity) {
+    // segments of the old buffers may still be in use, only happens a few times while the size settles
+    SDL_WaitForGPUIdle(gpuDevice);
+    for (auto &fence : fences) {
+      if (fence)SDL_ReleaseGPUFence(gpuDevice, fence);
+      fence = nullptr;
+    }
+    release();
+    create(std::bit_ceil(requiredSize));
+  }
+
+  frameIdx = (frameIdx + 1) % FRAME_COUNT;
+  auto &fence = fences[frameIdx];
+  if (fence) {
+    SDL_WaitForGPUFences(gpuDevice, true, &fence, 1);
+    SDL_ReleaseGPUFence(gpuDevice, fence);
+    fence = nullptr;
+  }
+
+  used = 0;
+  uploaded = 0;
+  requiredSize = 0;
+}
+
+void Renderer::RingBuffer::endFrame(SDL_GPUFence* fence)
+{
+  assert(fences[frameIdx] == nullptr);
+  fences[frameIdx] = fence;
+}
+
+bool Renderer::RingBuffer::push(const void* data, uint32_t size, Alloc &out)
+{
+  uint32_t offset = (used + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  if (offset + size > frameCapacity) {
+    requiredSize = std::max(requiredSize, offset + size);
+    return false;
+  }
+
+  if (!mapped) {
+    // the segment is either not in use by the GPU (fenced), or only parts of it are pending a copy
+    mapped = (uint8_t*)SDL_MapGPUTransferBuffer(gpuDevice, bufferTrans, false);
+    assert(mapped != nullptr);
+  }
+
+  out.offset = frameIdx * frameCapacity + offset;
+  out.size = size;
+  SDL_memcpy(mapped + out.offset, data, size);
+
+  used = offset + size;
+  requiredSize = std::max(requiredSize, used);
+  return true;
+}
+
+void Renderer::RingBuffer::upload(SDL_GPUCopyPass &pass)
+{
+  if (mapped) {
+    SDL_UnmapGPUTransferBuffer(gpuDevice, bufferTrans);
+    mapped = nullptr;
+  }
+  if (uploaded == used)return;
+
+  uint32_t offset = frameIdx * frameCapacity + uploaded;
+
+  SDL_GPUTransferBufferLocation location{};
+  location.transfer_buffer = bufferTrans;
+  location.offset = offset;
+
+  SDL_GPUBufferRegion region{};
+  region.buffer = buffer;
+  region.offset = offset;
+  region.size = used - uploaded;
+
+  SDL_UploadToGPUBuffer(&pass, &location, &region, false);
+  uploaded = used;
+}
@@ -0,0 +1,79 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+
+#include "SDL3/SDL_gpu.h"
+
+namespace Renderer
+{
+  /**
+   * Allocator for geometry that is re-generated every frame (lines, sprites, debug shapes).
+   *
+   * Owns one GPU buffer (usable as vertex and index buffer) and one transfer buffer,
+   * both split into a segment per frame in flight.
+   * Data is written into the current segment of the transfer buffer, and copied over with 'upload'.
+   * Before a segment is re-used, the fence of the frame that last used it is waited on.
+   * Once large enough, no allocations happen at all.
+   */
+  class RingBuffer
+  {
+    public:
+      constexpr static uint32_t FRAME_COUNT = 3;
+      constexpr static uint32_t ALIGNMENT = 16;
+
+      struct Alloc
+      {
+        uint32_t offset{}; // in bytes, relative to the start of the GPU buffer
+        uint32_t size{};
+      };
+
+    private:
+      SDL_GPUDevice* gpuDevice{nullptr};
+      SDL_GPUBuffer* buffer{nullptr};
+      SDL_GPUTransferBuffer* bufferTrans{nullptr};
+      SDL_GPUFence* fences[FRAME_COUNT]{};
+
+      uint8_t* mapped{nullptr};
+      uint32_t frameCapacity{0};
+      uint32_t frameIdx{0};
+      uint32_t used{0};
+      uint32_t uploaded{0};
+      uint32_t requiredSize{0}; // largest size requested in a frame, used to grow the buffers
+
+      void create(uint32_t capacity);
+      void release();
+
+    public:
+      RingBuffer(SDL_GPUDevice* device, uint32_t frameCapacity);
+      ~RingBuffer();
+
+      /**
+       * Switches to the next segment, waiting for the GPU if it is still in use.
+       * If the last frames ran out of space, the buffers are re-created with a larger size here.
+       */
+      void beginFrame();
+
+      /**
+       * @param fence fence of the command-buffer that used this frame's data, ownership is taken over
+       */
+      void endFrame(SDL_GPUFence* fence);
+
+      /**
+       * Copies data into the current frame, only valid until the next 'beginFrame'.
+       * @return false if the frame is out of space, nothing is copied in that case
+       */
+      bool push(const void* data, uint32_t size, Alloc &out);
+
+      /**
+       * Records copies for everything pushed since the last upload.
+       */
+      void upload(SDL_GPUCopyPass& pass);
+
+      [[nodiscard]] SDL_GPUBuffer* getBuffer() const { return buffer; }
+      [[nodiscard]] uint32_t getFrameCapacity() const { return frameCapacity; }
+      [[nodiscard]] uint32_t getFrameUsage() const { return used; }
+  };
+}
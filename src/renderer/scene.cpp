@@ -10,6 +10,8 @@
 #include "../context.h"
 
 #include "framebuffer.h"
+#include "renderQueue.h"
+#include "ringBuffer.h"
 #include "shader.h"
 
 Renderer::Scene::Scene()
@@ -75,6 +77,9 @@ Renderer::Scene::Scene()
     {SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM, offsetof(Renderer::LineVertex, color)},
   }
 });
+
+  renderQueue = std::make_unique<RenderQueue>();
+  ringBuffer = std::make_unique<RingBuffer>(ctx.gpu, 1024 * 1024);
 }
 
 Renderer::Scene::~Scene() {
@@ -85,6 +90,21 @@ void Renderer::Scene::update()
 {
 }
 
+void Renderer::Scene::updateLightState()
+{
+  lightState = {};
+  for (auto &light : lights) {
+    if (light.type == 0) {
+      lightState.ambientColor = light.color;
+      lightState.hasAmbient = true;
+    } else if (lightState.dirCount < 2) {
+      lightState.dir[lightState.dirCount] = glm::vec4(light.dir, 0.0f);
+      lightState.color[lightState.dirCount] = light.color;
+      ++lightState.dirCount;
+    }
+  }
+}
+
 void Renderer::Scene::draw()
 {
   const auto drawData = ImGui::GetDrawData();
@@ -110,6 +130,7 @@ void Renderer::Scene::draw()
   targetInfo2D.cycle = false;
 
   ImGui_ImplSDLGPU3_PrepareDrawData(drawData, command_buffer);
+  ringBuffer->beginFrame();
 
   auto copyPass = SDL_BeginGPUCopyPass(command_buffer);
   for (const auto &passCb : copyPasses) {
@@ -123,6 +144,7 @@ void Renderer::Scene::draw()
 
   if (ctx.project)
   {
+    updateLightState();
     for (const auto &passCb : renderPasses) {
       passCb.second(command_buffer, *this);
     }
@@ -140,8 +162,8 @@ void Renderer::Scene::draw()
     ImGui::RenderPlatformWindowsDefault();
   }
 
-  // Submit the command buffer
-  SDL_SubmitGPUCommandBuffer(command_buffer);
+  // Submit the command buffer, the fence tells the ring-buffer when this frame's data can be overwritten
+  ringBuffer->endFrame(SDL_SubmitGPUCommandBufferAndAcquireFence(command_buffer));
 
   if (ctx.project)
   {
@@ -27,6 +27,19 @@ namespace Renderer
     int type{};
   };
 
+  // lights in the form the N64 material uniforms expect them
+  struct LightState
+  {
+    glm::vec4 ambientColor{};
+    glm::vec4 dir[2]{};
+    glm::vec4 color[2]{};
+    bool hasAmbient{false};
+    int dirCount{0};
+  };
+
+  class RenderQueue;
+  class RingBuffer;
+
   class Scene
   {
     private:
@@ -44,6 +57,12 @@ namespace Renderer
       std::unique_ptr<Pipeline> pipelineSprites{};
 
       std::vector<Light> lights{};
+      LightState lightState{};
+
+      std::unique_ptr<RenderQueue> renderQueue{};
+      std::unique_ptr<RingBuffer> ringBuffer{};
+
+      void updateLightState();
 
     public:
       Scene();
@@ -55,6 +74,12 @@ namespace Renderer
       void clearLights() { lights.clear(); }
       void addLight(const Light& light) { lights.push_back(light); }
       const std::vector<Light>& getLights() const { return lights; }
+      // resolved once per frame before any render-pass runs
+      const LightState& getLightState() const { return lightState; }
+
+      RenderQueue& getRenderQueue() { return *renderQueue; }
+      // for geometry changing every frame, see 'Mesh::recreateDynamic'
+      RingBuffer& getRingBuffer() { return *ringBuffer; }
 
       void addRenderPass(uint32_t id, const CbRenderPass& pass) { renderPasses[id] = pass; }
       void removeRenderPass(uint32_t id) { renderPasses.erase(id); }
@@ -11,11 +11,8 @@
 
 extern SDL_GPUSampler *texSamplerRepeat;
 
-Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bool isMono, int rasterWidth, int rasterHeight)
-  : gpuDevice(device)
+SDL_Surface* Renderer::Texture::loadImage(const std::string &imgPath, bool isMono, int rasterWidth, int rasterHeight)
 {
-  if(!gpuDevice)return; // CLI mode
-
   SDL_Surface *imgRaw;
   if (imgPath.ends_with(".svg") && rasterWidth > 0 && rasterHeight > 0) {
     auto imgStream = SDL_IOFromFile(imgPath.c_str(), "rb");
@@ -23,8 +20,11 @@ Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bo
   } else {
     imgRaw = IMG_Load(imgPath.c_str());
   }
+  if(!imgRaw)return nullptr;
 
   auto img = SDL_ConvertSurface(imgRaw, SDL_PIXELFORMAT_BGRA32);
+  SDL_DestroySurface(imgRaw);
+  if(!img)return nullptr;
 
   if(isMono)
   {
@@ -42,13 +42,34 @@ Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bo
     SDL_UnlockSurface(img);
   }
 
-  SDL_DestroySurface(imgRaw);
+  return img;
+}
+
+Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bool isMono, int rasterWidth, int rasterHeight)
+  : gpuDevice(device)
+{
+  if(!gpuDevice)return; // CLI mode
+
+  auto img = loadImage(imgPath, isMono, rasterWidth, rasterHeight);
+  if(!img)return;
+  upload(img);
+  SDL_DestroySurface(img);
+}
 
+Renderer::Texture::Texture(SDL_GPUDevice* device, SDL_Surface *img)
+  : gpuDevice(device)
+{
+  if(!gpuDevice || !img)return;
+  upload(img);
+}
+
+void Renderer::Texture::upload(SDL_Surface *img)
+{
   width = img->w;
   height = img->h;
   char* image_data = (char*)img->pixels;
 
-  //printf("Loaded %s: w/h: %dx%d, format: %s\n", imgPath.c_str(), width, height, SDL_GetPixelFormatName(img->format));
+  //printf("Loaded: w/h: %dx%d, format: %s\n", width, height, SDL_GetPixelFormatName(img->format));
 
   // Create texture
   SDL_GPUTextureCreateInfo texture_info = {};
@@ -61,22 +82,22 @@ Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bo
   texture_info.num_levels = 1;
   texture_info.sample_count = SDL_GPU_SAMPLECOUNT_1;
 
-  texture = SDL_CreateGPUTexture(device, &texture_info);
+  texture = SDL_CreateGPUTexture(gpuDevice, &texture_info);
 
   // Create transfer buffer
   // FIXME: A real engine would likely keep one around, see what the SDL_GPU backend is doing.
   SDL_GPUTransferBufferCreateInfo transferbuffer_info = {};
   transferbuffer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
   transferbuffer_info.size = width * height * 4;
-  SDL_GPUTransferBuffer* transferbuffer = SDL_CreateGPUTransferBuffer(device, &transferbuffer_info);
+  SDL_GPUTransferBuffer* transferbuffer = SDL_CreateGPUTransferBuffer(gpuDevice, &transferbuffer_info);
   assert(transferbuffer != nullptr);
 
   // Copy to transfer buffer
   uint32_t upload_pitch = width * 4;
-  void* texture_ptr = SDL_MapGPUTransferBuffer(device, transferbuffer, true);
+  void* texture_ptr = SDL_MapGPUTransferBuffer(gpuDevice, transferbuffer, true);
   for (int y = 0; y < height; y++)
-      memcpy((void*)((uintptr_t)texture_ptr + y * upload_pitch), image_data + y * upload_pitch, upload_pitch);
-  SDL_UnmapGPUTransferBuffer(device, transferbuffer);
+      memcpy((void*)((uintptr_t)texture_ptr + y * upload_pitch), image_data + y * img->pitch, upload_pitch);
+  SDL_UnmapGPUTransferBuffer(gpuDevice, transferbuffer);
 
   SDL_GPUTextureTransferInfo transfer_info = {};
   transfer_info.offset = 0;
@@ -90,15 +111,13 @@ Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bo
   texture_region.h = (Uint32)height;
   texture_region.d = 1;
 
-  SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(device);
+  SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(gpuDevice);
   SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd);
   SDL_UploadToGPUTexture(copy_pass, &transfer_info, &texture_region, false);
   SDL_EndGPUCopyPass(copy_pass);
   SDL_SubmitGPUCommandBuffer(cmd);
 
-  SDL_ReleaseGPUTransferBuffer(device, transferbuffer);
-
-  SDL_DestroySurface(img);
+  SDL_ReleaseGPUTransferBuffer(gpuDevice, transferbuffer);
 
   texBinding.texture = texture;
   texBinding.sampler = texSamplerRepeat;
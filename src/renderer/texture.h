@@ -5,6 +5,7 @@
 #pragma once
 #include <string>
 #include <SDL3/SDL_gpu.h>
+#include <SDL3/SDL_surface.h>
 
 #include "imgui.h"
 
@@ -21,8 +22,18 @@ namespace Renderer
       int width{0};
       int height{0};
 
+      void upload(SDL_Surface *img);
+
     public:
+      /**
+       * Loads and converts an image into a BGRA32 surface, returns nullptr on failure.
+       * Does not touch the GPU, so it can be used from any thread.
+       * The caller must free the result with 'SDL_DestroySurface'.
+       */
+      static SDL_Surface* loadImage(const std::string &imgPath, bool isMono = false, int rasterWidth = 0, int rasterHeight = 0);
+
       Texture(SDL_GPUDevice* device, const std::string &imgPath, bool isMono = false, int rasterWidth = 0, int rasterHeight = 0);
+      Texture(SDL_GPUDevice* device, SDL_Surface *img);
       ~Texture();
 
       [[nodiscard]] int getWidth() const { return width; };
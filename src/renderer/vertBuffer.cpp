@@ -22,6 +22,14 @@ void Renderer::VertBuffer::resize(uint32_t sizeVert, uint32_t sizeIndex) {
   assert(sizeVert != 0);
   assert(sizeIndex != 0);
 
+  // the GPU may still use the old buffers, SDL defers the actual release until it's done
+  SDL_ReleaseGPUBuffer(gpuDevice, buffer);
+  SDL_ReleaseGPUTransferBuffer(gpuDevice, bufferTrans);
+  SDL_ReleaseGPUBuffer(gpuDevice, bufferIdx);
+  SDL_ReleaseGPUTransferBuffer(gpuDevice, bufferIdxTrans);
+  capVertByteSize = sizeVert;
+  capIdxByteSize = sizeIndex;
+
   SDL_GPUBufferCreateInfo bufferInfo{
     .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
     .size = sizeVert
@@ -53,18 +61,18 @@ void Renderer::VertBuffer::setData(char* verts, uint32_t vertsSize, const std::v
 {
   currIdxByteSize = indices.size() * sizeof(uint16_t);
 
-  if (vertsSize != currVertByteSize) {
+  if (vertsSize > capVertByteSize || currIdxByteSize > capIdxByteSize) {
     resize(vertsSize, currIdxByteSize);
   }
   currVertByteSize = vertsSize;
 
 // @TODO: store vert/indices in one single buffer
 
-  auto data = (Vertex*)SDL_MapGPUTransferBuffer(gpuDevice, bufferTrans, false);
+  auto data = (Vertex*)SDL_MapGPUTransferBuffer(gpuDevice, bufferTrans, true);
   SDL_memcpy(data, verts, currVertByteSize);
   SDL_UnmapGPUTransferBuffer(gpuDevice, bufferTrans);
 
-  data = (Vertex*)SDL_MapGPUTransferBuffer(gpuDevice, bufferIdxTrans, false);
+  data = (Vertex*)SDL_MapGPUTransferBuffer(gpuDevice, bufferIdxTrans, true);
   SDL_memcpy(data, indices.data(), currIdxByteSize);
   SDL_UnmapGPUTransferBuffer(gpuDevice, bufferIdxTrans);
 
@@ -24,6 +24,8 @@ namespace Renderer
 
       size_t currVertByteSize{0};
       size_t currIdxByteSize{0};
+      size_t capVertByteSize{0};
+      size_t capIdxByteSize{0};
       bool needsUpload{false};
 
       void resize(uint32_t sizeVert, uint32_t sizeIndex);
@@ -0,0 +1,122 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "asyncLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <string>
+
+#include "logger.h"
+
+namespace
+{
+  constexpr uint32_t MAX_THREADS = 4;
+}
+
+Utils::AsyncLoader::~AsyncLoader()
+{
+  cancel();
+  {
+    std::lock_guard lock{mtx};
+    stopping = true;
+  }
+  cvWork.notify_all();
+  for(auto &thread : threads)thread.join();
+}
+
+void Utils::AsyncLoader::workerLoop()
+{
+  std::unique_lock lock{mtx};
+  for(;;)
+  {
+    cvWork.wait(lock, [this]{ return stopping || !queue.empty(); });
+    if(stopping)return;
+
+    auto job = queue.front();
+    queue.pop_front();
+    ++running;
+    lock.unlock();
+
+    try {
+      job->work();
+    } catch(const std::exception &e) {
+      Utils::Logger::log(std::string{"Async load failed: "} + e.what(), Utils::Logger::LEVEL_ERROR);
+    }
+
+    lock.lock();
+    job->done = true;
+    --running;
+    cvIdle.notify_all();
+  }
+}
+
+void Utils::AsyncLoader::add(WorkFunc work, ApplyFunc apply)
+{
+  std::lock_guard lock{mtx};
+  if(threads.empty()) {
+    // leave one core for the editor itself
+    uint32_t threadCount = std::clamp(std::thread::hardware_concurrency(), 2u, MAX_THREADS + 1) - 1;
+    for(uint32_t i=0; i<threadCount; ++i) {
+      threads.emplace_back([this]{ workerLoop(); });
+    }
+  }
+
+  auto job = std::make_shared<Job>(std::move(work), std::move(apply));
+  jobs.push_back(job);
+  queue.push_back(job);
+  ++jobsTotal;
+  cvWork.notify_one();
+}
+
+uint32_t Utils::AsyncLoader::update(uint64_t budgetUs)
+{
+  auto timeStart = std::chrono::steady_clock::now();
+  uint32_t applied = 0;
+
+  for(;;)
+  {
+    std::shared_ptr<Job> job{};
+    {
+      std::lock_guard lock{mtx};
+      // results are applied in order, a slow job holds back the ones after it
+      if(jobs.empty() || !jobs.front()->done)break;
+      job = jobs.front();
+      jobs.pop_front();
+    }
+
+    job->apply();
+    ++applied;
+    ++jobsApplied;
+
+    auto timeUs = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - timeStart
+    ).count();
+    if((uint64_t)timeUs >= budgetUs)break;
+  }
+
+  std::lock_guard lock{mtx};
+  if(jobs.empty()) {
+    jobsTotal = 0;
+    jobsApplied = 0;
+  }
+  return applied;
+}
+
+void Utils::AsyncLoader::cancel()
+{
+  std::unique_lock lock{mtx};
+  queue.clear();
+  cvIdle.wait(lock, [this]{ return running == 0; });
+  jobs.clear();
+  jobsTotal = 0;
+  jobsApplied = 0;
+}
+
+bool Utils::AsyncLoader::isBusy()
+{
+  std::lock_guard lock{mtx};
+  return !jobs.empty();
+}
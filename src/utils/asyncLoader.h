@@ -0,0 +1,77 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils
+{
+  /**
+   * Runs loading work (file decoding, parsing) on worker threads,
+   * and hands the results back to the main thread in the order they were added.
+   *
+   * Each job has a 'work' function running on a worker and an 'apply' function
+   * running on the main thread (e.g. GPU uploads) during 'update()'.
+   * Data between the two is passed via state captured by both, e.g. a shared_ptr.
+   */
+  class AsyncLoader
+  {
+    public:
+      typedef std::function<void()> WorkFunc;
+      typedef std::function<void()> ApplyFunc;
+
+    private:
+      struct Job
+      {
+        WorkFunc work{};
+        ApplyFunc apply{};
+        bool done{false};
+      };
+
+      std::vector<std::thread> threads{};
+      std::mutex mtx{};
+      std::condition_variable cvWork{};
+      std::condition_variable cvIdle{};
+      std::deque<std::shared_ptr<Job>> jobs{}; // all jobs not yet applied, in order
+      std::deque<std::shared_ptr<Job>> queue{}; // jobs not yet started
+      uint32_t running{0};
+      uint32_t jobsTotal{0};
+      uint32_t jobsApplied{0};
+      bool stopping{false};
+
+      void workerLoop();
+
+    public:
+      AsyncLoader() = default;
+      ~AsyncLoader();
+
+      AsyncLoader(const AsyncLoader&) = delete;
+      AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+      void add(WorkFunc work, ApplyFunc apply);
+
+      /**
+       * Applies finished jobs on the calling (main) thread.
+       * Stops once 'budgetUs' is used up, but always applies at least one job.
+       * @return number of jobs applied
+       */
+      uint32_t update(uint64_t budgetUs);
+
+      /**
+       * Drops all pending jobs and results, waits for jobs currently running on a worker.
+       */
+      void cancel();
+
+      [[nodiscard]] bool isBusy();
+      [[nodiscard]] uint32_t getJobsTotal() const { return jobsTotal; }
+      [[nodiscard]] uint32_t getJobsApplied() const { return jobsApplied; }
+  };
+}
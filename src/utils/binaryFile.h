@@ -4,8 +4,12 @@
 */
 #pragma once
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include <bit>
 #include <stdexcept>
 #include <cstdint>
@@ -29,28 +33,139 @@ namespace Utils
   class BinaryFile
   {
     private:
+      constexpr static uint32_t STREAM_FLUSH_SIZE = 1024 * 64;
+
       std::unordered_map<std::string, uint32_t> patchMap{};
       std::vector<uint32_t> posStack{};
-      std::vector<uint8_t> data{};
+      std::vector<uint8_t> data{}; // size acts as capacity, actual content ends at 'dataSize'
       uint32_t dataPos{};
       uint32_t dataSize{};
 
-      void writeRaw(const uint8_t* ptr, size_t size) {
-        if(dataPos+size > data.size()) {
-          data.resize(data.size() + size);
+      // streaming mode, anything before 'streamOffset' was already written to the file
+      std::unique_ptr<FILE, decltype(&fclose)> stream{nullptr, fclose};
+      uint32_t streamOffset{0};
+
+      // Copies 'count' elements of size N while swapping their endianness, 16 bytes at a time
+      template<size_t N>
+      static void copySwapped(uint8_t* dst, const uint8_t* src, size_t count)
+      {
+        size_t size = count * N;
+        if constexpr (N == 1) {
+          memcpy(dst, src, size);
+        } else {
+          typedef uint8_t VecU8 __attribute__((vector_size(16)));
+          size_t i = 0;
+          for(; i+16 <= size; i += 16) {
+            VecU8 v;
+            memcpy(&v, src + i, 16);
+            if constexpr (N == 2) {
+              v = __builtin_shufflevector(v, v, 1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14);
+            } else if constexpr (N == 4) {
+              v = __builtin_shufflevector(v, v, 3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+            } else {
+              static_assert(N == 8, "unsupported element size");
+              v = __builtin_shufflevector(v, v, 7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8);
+            }
+            memcpy(dst + i, &v, 16);
+          }
+          for(; i < size; i += N) {
+            for(size_t b=0; b<N; ++b)dst[i+b] = src[i+N-1-b];
+          }
         }
-        for(size_t i=0; i<size; ++i) {
-          data[dataPos++] = ptr[i];
+      }
+
+      // Returns a pointer to write 'size' bytes at the current position, and advances it.
+      // Must not be called for positions that were already flushed to a stream.
+      uint8_t* allocWrite(size_t size)
+      {
+        size_t end = dataPos - streamOffset + size;
+        if(end > data.size()) {
+          data.resize(std::max(end, data.size() * 2));
         }
+        auto ptr = data.data() + (dataPos - streamOffset);
+        dataPos += size;
         dataSize = std::max(dataSize, dataPos);
+        return ptr;
+      }
+
+      void flushIfFull() {
+        if(stream && dataPos == dataSize && (dataSize - streamOffset) >= STREAM_FLUSH_SIZE) {
+          flush();
+        }
+      }
+
+      // Writes to data that is already in the stream, e.g. offsets patched in after the fact
+      void patchStream(const uint8_t* ptr, size_t size) {
+        fseek(stream.get(), dataPos, SEEK_SET);
+        fwrite(ptr, 1, size, stream.get());
+        fseek(stream.get(), streamOffset, SEEK_SET);
+        dataPos += size;
+      }
+
+      void writeRaw(const uint8_t* ptr, size_t size) {
+        if(dataPos < streamOffset) {
+          size_t patchSize = std::min<size_t>(size, streamOffset - dataPos);
+          patchStream(ptr, patchSize);
+          ptr += patchSize;
+          size -= patchSize;
+          if(size == 0)return;
+        }
+        memcpy(allocWrite(size), ptr, size);
+        flushIfFull();
       }
 
     public:
+      BinaryFile() = default;
+      BinaryFile(BinaryFile&&) = default;
+      BinaryFile& operator=(BinaryFile&&) = default;
+
+      ~BinaryFile() {
+        closeStream();
+      }
+
+      /**
+       * Switches to streaming mode: data is written to the file whenever enough has been collected,
+       * instead of keeping everything in memory until 'writeToFile'.
+       * Going back to already flushed positions (e.g. 'posPush') is still possible.
+       * Must be called before anything is written.
+       */
+      bool openStream(const fs::path &filename) {
+        if(dataSize != 0)throw std::runtime_error("BinaryFile: stream must be opened before writing");
+        stream.reset(fopen(filename.string().c_str(), "wb"));
+        streamOffset = 0;
+        return stream != nullptr;
+      }
+
+      void flush() {
+        if(!stream)return;
+        uint32_t size = dataSize - streamOffset;
+        fwrite(data.data(), 1, size, stream.get());
+        // the buffer gets reused, gaps created by 'setPos' must read as zero
+        memset(data.data(), 0, size);
+        streamOffset = dataSize;
+      }
+
+      void closeStream() {
+        if(!stream)return;
+        flush();
+        stream.reset();
+      }
+
+      /**
+       * Pre-allocates memory for the given amount of total bytes.
+       * Has no effect in streaming mode.
+       */
+      void reserve(uint32_t bytes) {
+        if(!stream && bytes > data.size())data.resize(bytes);
+      }
 
       void skip(uint32_t bytes) {
-        for(uint32_t i=0; i<bytes; ++i) {
-          write<uint8_t>(0);
+        if(dataPos < streamOffset) {
+          for(uint32_t i=0; i<bytes; ++i)write<uint8_t>(0);
+          return;
         }
+        memset(allocWrite(bytes), 0, bytes);
+        flushIfFull();
       }
 
       template<typename T>
@@ -95,11 +210,18 @@ namespace Utils
       }
 
       void writeChars(const char* str, size_t len) {
-        for(size_t i=0; i<len; ++i)write<uint8_t>(str[i]);
+        writeRaw(reinterpret_cast<const uint8_t*>(str), len);
       }
 
       template<typename T>
       void writeArray(const T* arr, size_t count) {
+        if constexpr (std::is_arithmetic_v<T>) {
+          if(dataPos >= streamOffset) {
+            copySwapped<sizeof(T)>(allocWrite(count * sizeof(T)), reinterpret_cast<const uint8_t*>(arr), count);
+            flushIfFull();
+            return;
+          }
+        }
         for(size_t i=0; i<count; ++i) {
           write(arr[i]);
         }
@@ -116,8 +238,7 @@ namespace Utils
           case s8: write<int8_t>(std::stol(str)); break;
           case OBJECT_REF: write<uint32_t>(std::stoul(str)); break;
           case string:
-            for(char c : str)write<uint8_t>(c);
-            write<uint8_t>(0);
+            writeChars(str.c_str(), str.size() + 1);
             break;
           default:
             throw std::runtime_error("unsupported data type");
@@ -125,6 +246,7 @@ namespace Utils
       }
 
       void writeMemFile(const BinaryFile& memFile) {
+        if(memFile.stream)throw std::runtime_error("BinaryFile: cannot copy from a stream");
         writeRaw(memFile.data.data(), memFile.dataSize);
       }
 
@@ -160,10 +282,7 @@ namespace Utils
         uint32_t pos = getPos();
         uint32_t offset = pos % alignment;
         if(offset != 0) {
-          uint32_t padding = alignment - offset;
-          for(uint32_t i=0; i<padding; ++i) {
-            write<uint8_t>(0);
-          }
+          skip(alignment - offset);
         }
       }
 
@@ -172,6 +291,7 @@ namespace Utils
       }
 
       void writeToFile(const fs::path &filename) {
+        if(stream)throw std::runtime_error("BinaryFile: use 'closeStream' in streaming mode");
         FILE* file = fopen(filename.string().c_str(), "wb");
         fwrite(data.data(), 1, dataSize, file);
         fflush(file);
@@ -179,6 +299,7 @@ namespace Utils
       }
 
       std::vector<uint8_t> &getData() {
+        if(stream)throw std::runtime_error("BinaryFile: data of a stream is not in memory");
         data.resize(dataSize);
         return data;
       }
@@ -0,0 +1,246 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "dynamicBVH.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "glm/common.hpp"
+#include "glm/vector_relational.hpp"
+
+namespace
+{
+  Utils::AABB combine(const Utils::AABB &a, const Utils::AABB &b) {
+    Utils::AABB res{};
+    res.min = glm::min(a.min, b.min);
+    res.max = glm::max(a.max, b.max);
+    return res;
+  }
+
+  float getArea(const Utils::AABB &aabb) {
+    glm::vec3 size = aabb.max - aabb.min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+  }
+
+  bool contains(const Utils::AABB &outer, const Utils::AABB &inner) {
+    return glm::all(glm::lessThanEqual(outer.min, inner.min))
+        && glm::all(glm::greaterThanEqual(outer.max, inner.max));
+  }
+}
+
+int Utils::DynamicBVH::allocNode()
+{
+  if(freeList == NULL_NODE) {
+    nodes.emplace_back();
+    return (int)nodes.size() - 1;
+  }
+
+  int idx = freeList;
+  freeList = nodes[idx].parent;
+  nodes[idx] = {};
+  return idx;
+}
+
+void Utils::DynamicBVH::freeNode(int idx)
+{
+  nodes[idx].parent = freeList;
+  nodes[idx].height = -1;
+  freeList = idx;
+}
+
+int Utils::DynamicBVH::insert(const AABB &aabb, uint32_t userData)
+{
+  int leaf = allocNode();
+  auto &node = nodes[leaf];
+  node.aabb.min = aabb.min - glm::vec3{margin};
+  node.aabb.max = aabb.max + glm::vec3{margin};
+  node.userData = userData;
+  node.height = 0;
+
+  insertLeaf(leaf);
+  ++leafCount;
+  return leaf;
+}
+
+void Utils::DynamicBVH::remove(int proxy)
+{
+  assert(nodes[proxy].isLeaf());
+  removeLeaf(proxy);
+  freeNode(proxy);
+  --leafCount;
+}
+
+bool Utils::DynamicBVH::move(int proxy, const AABB &aabb)
+{
+  if(contains(nodes[proxy].aabb, aabb))return false;
+
+  removeLeaf(proxy);
+  nodes[proxy].aabb.min = aabb.min - glm::vec3{margin};
+  nodes[proxy].aabb.max = aabb.max + glm::vec3{margin};
+  insertLeaf(proxy);
+  return true;
+}
+
+void Utils::DynamicBVH::clear()
+{
+  nodes.clear();
+  root = NULL_NODE;
+  freeList = NULL_NODE;
+  leafCount = 0;
+}
+
+void Utils::DynamicBVH::insertLeaf(int leaf)
+{
+  if(root == NULL_NODE) {
+    root = leaf;
+    nodes[root].parent = NULL_NODE;
+    return;
+  }
+
+  // find the best sibling, descending into the child with the lowest cost
+  const AABB leafAABB = nodes[leaf].aabb;
+  int idx = root;
+  while(!nodes[idx].isLeaf())
+  {
+    const auto &node = nodes[idx];
+    float area = getArea(node.aabb);
+    float combinedArea = getArea(combine(node.aabb, leafAABB));
+
+    // cost of creating a new parent for this node and the leaf,
+    // and the minimum cost of pushing the leaf further down
+    float cost = 2.0f * combinedArea;
+    float inheritCost = 2.0f * (combinedArea - area);
+
+    float childCost[2];
+    for(int c=0; c<2; ++c) {
+      const auto &child = nodes[node.child[c]];
+      float newArea = getArea(combine(child.aabb, leafAABB));
+      childCost[c] = child.isLeaf()
+        ? newArea + inheritCost
+        : (newArea - getArea(child.aabb)) + inheritCost;
+    }
+
+    if(cost < childCost[0] && cost < childCost[1])break;
+    idx = childCost[0] < childCost[1] ? node.child[0] : node.child[1];
+  }
+
+  int sibling = idx;
+  int oldParent = nodes[sibling].parent;
+  int newParent = allocNode();
+  nodes[newParent].parent = oldParent;
+  nodes[newParent].aabb = combine(leafAABB, nodes[sibling].aabb);
+  nodes[newParent].height = nodes[sibling].height + 1;
+  nodes[newParent].child[0] = sibling;
+  nodes[newParent].child[1] = leaf;
+  nodes[sibling].parent = newParent;
+  nodes[leaf].parent = newParent;
+
+  if(oldParent == NULL_NODE) {
+    root = newParent;
+  } else {
+    auto &parentNode = nodes[oldParent];
+    parentNode.child[parentNode.child[0] == sibling ? 0 : 1] = newParent;
+  }
+
+  // refit and balance everything above
+  idx = nodes[leaf].parent;
+  while(idx != NULL_NODE)
+  {
+    idx = balance(idx);
+    auto &node = nodes[idx];
+    const auto &childA = nodes[node.child[0]];
+    const auto &childB = nodes[node.child[1]];
+    node.height = 1 + std::max(childA.height, childB.height);
+    node.aabb = combine(childA.aabb, childB.aabb);
+    idx = node.parent;
+  }
+}
+
+void Utils::DynamicBVH::removeLeaf(int leaf)
+{
+  if(leaf == root) {
+    root = NULL_NODE;
+    return;
+  }
+
+  int parent = nodes[leaf].parent;
+  int grandParent = nodes[parent].parent;
+  int sibling = nodes[parent].child[0] == leaf ? nodes[parent].child[1] : nodes[parent].child[0];
+
+  if(grandParent == NULL_NODE) {
+    root = sibling;
+    nodes[sibling].parent = NULL_NODE;
+    freeNode(parent);
+    return;
+  }
+
+  // replace the parent with the sibling
+  auto &grandParentNode = nodes[grandParent];
+  grandParentNode.child[grandParentNode.child[0] == parent ? 0 : 1] = sibling;
+  nodes[sibling].parent = grandParent;
+  freeNode(parent);
+
+  int idx = grandParent;
+  while(idx != NULL_NODE)
+  {
+    idx = balance(idx);
+    auto &node = nodes[idx];
+    const auto &childA = nodes[node.child[0]];
+    const auto &childB = nodes[node.child[1]];
+    node.height = 1 + std::max(childA.height, childB.height);
+    node.aabb = combine(childA.aabb, childB.aabb);
+    idx = node.parent;
+  }
+}
+
+/**
+ * Rotates 'idxA' if its children differ in height by more than one.
+ * Returns the index of the node now at its position.
+ */
+int Utils::DynamicBVH::balance(int idxA)
+{
+  auto &a = nodes[idxA];
+  if(a.isLeaf() || a.height < 2)return idxA;
+
+  int idxB = a.child[0];
+  int idxC = a.child[1];
+  int diff = nodes[idxC].height - nodes[idxB].height;
+  if(diff >= -1 && diff <= 1)return idxA;
+
+  // rotate the higher child up, 'idxUp' takes the place of 'idxA'
+  int upSlot = diff > 1 ? 1 : 0;
+  int idxUp = a.child[upSlot];
+  int idxOther = a.child[1 - upSlot];
+  auto &up = nodes[idxUp];
+
+  int idxF = up.child[0];
+  int idxG = up.child[1];
+
+  up.child[0] = idxA;
+  up.parent = a.parent;
+  a.parent = idxUp;
+
+  if(up.parent == NULL_NODE) {
+    root = idxUp;
+  } else {
+    auto &parentNode = nodes[up.parent];
+    parentNode.child[parentNode.child[0] == idxA ? 0 : 1] = idxUp;
+  }
+
+  // the higher grandchild stays below 'up', the other one moves below 'a'
+  int idxKeep = nodes[idxF].height > nodes[idxG].height ? idxF : idxG;
+  int idxMove = idxKeep == idxF ? idxG : idxF;
+
+  up.child[1] = idxKeep;
+  a.child[upSlot] = idxMove;
+  nodes[idxMove].parent = idxA;
+
+  a.aabb = combine(nodes[idxOther].aabb, nodes[idxMove].aabb);
+  a.height = 1 + std::max(nodes[idxOther].height, nodes[idxMove].height);
+  up.aabb = combine(a.aabb, nodes[idxKeep].aabb);
+  up.height = 1 + std::max(a.height, nodes[idxKeep].height);
+
+  return idxUp;
+}
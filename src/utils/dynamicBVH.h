@@ -0,0 +1,100 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "aabb.h"
+
+namespace Utils
+{
+  /**
+   * Dynamic AABB tree for objects that get added, moved and removed at any time.
+   *
+   * Leaves store a slightly enlarged ("fat") AABB, so small movements don't require any changes to the tree.
+   * Once an object leaves its fat AABB, only its own leaf gets re-inserted.
+   * Inserts pick the sibling by the smallest increase in surface area,
+   * and the tree is kept balanced with AVL-style rotations.
+   */
+  class DynamicBVH
+  {
+    public:
+      constexpr static int NULL_NODE = -1;
+
+    private:
+      struct Node
+      {
+        AABB aabb{};
+        uint32_t userData{};
+        int parent{NULL_NODE}; // also used as 'next' in the free-list
+        int child[2]{NULL_NODE, NULL_NODE};
+        int height{0}; // leaves are 0, free nodes -1
+
+        [[nodiscard]] bool isLeaf() const { return child[0] == NULL_NODE; }
+      };
+
+      std::vector<Node> nodes{};
+      std::vector<int> queryStack{};
+      int root{NULL_NODE};
+      int freeList{NULL_NODE};
+      uint32_t leafCount{0};
+      float margin{};
+
+      int allocNode();
+      void freeNode(int idx);
+      void insertLeaf(int leaf);
+      void removeLeaf(int leaf);
+      int balance(int idx);
+
+    public:
+      explicit DynamicBVH(float margin = 1.0f) : margin{margin} {}
+
+      /**
+       * Adds a leaf, the returned proxy stays valid until 'remove' is called.
+       */
+      int insert(const AABB &aabb, uint32_t userData);
+      void remove(int proxy);
+
+      /**
+       * Updates the bounds of a leaf, it's only re-inserted if 'aabb' is no longer inside its fat AABB.
+       * @return true if the tree changed
+       */
+      bool move(int proxy, const AABB &aabb);
+
+      void setUserData(int proxy, uint32_t userData) { nodes[proxy].userData = userData; }
+      [[nodiscard]] uint32_t getUserData(int proxy) const { return nodes[proxy].userData; }
+      [[nodiscard]] const AABB& getFatAABB(int proxy) const { return nodes[proxy].aabb; }
+
+      [[nodiscard]] uint32_t getLeafCount() const { return leafCount; }
+      [[nodiscard]] int getHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+      void clear();
+
+      /**
+       * Walks all nodes for which 'testAABB(aabb)' returns true,
+       * and calls 'onLeaf(userData, fatAABB)' for each leaf reached that way.
+       */
+      template<typename FTest, typename FLeaf>
+      void query(FTest &&testAABB, FLeaf &&onLeaf)
+      {
+        if(root == NULL_NODE)return;
+        queryStack.clear();
+        queryStack.push_back(root);
+
+        while(!queryStack.empty()) {
+          const Node &node = nodes[queryStack.back()];
+          queryStack.pop_back();
+          if(!testAABB(node.aabb))continue;
+
+          if(node.isLeaf()) {
+            onLeaf(node.userData, node.aabb);
+          } else {
+            queryStack.push_back(node.child[0]);
+            queryStack.push_back(node.child[1]);
+          }
+        }
+      }
+  };
+}
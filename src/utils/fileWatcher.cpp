@@ -0,0 +1,250 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "fileWatcher.h"
+
+#ifdef __linux__
+  #include <cerrno>
+  #include <poll.h>
+  #include <sys/inotify.h>
+  #include <unistd.h>
+#endif
+
+#include "fs.h"
+#include "logger.h"
+
+namespace
+{
+  // time a path must be quiet before its events are reported
+  constexpr auto SETTLE_TIME = std::chrono::milliseconds(100);
+  // scan interval if no native API is available
+  constexpr auto POLL_INTERVAL = std::chrono::milliseconds(2000);
+
+  #ifdef __linux__
+    constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_CREATE | IN_ATTRIB
+      | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+  #endif
+}
+
+Utils::FileWatcher::~FileWatcher() {
+  stop();
+}
+
+void Utils::FileWatcher::push(const std::string &path, EventType type)
+{
+  std::lock_guard lock{mtx};
+  if(type == EventType::RESCAN) {
+    rescanPending = true;
+    return;
+  }
+  // the latest event wins, e.g. a file that got created and deleted again is only reported as removed
+  pending[path] = {type, Clock::now()};
+}
+
+bool Utils::FileWatcher::addWatchRecursive(const fs::path &dir, bool reportFiles)
+{
+#ifdef __linux__
+  auto addWatch = [this](const fs::path &path) {
+    int wd = inotify_add_watch(inotifyFd, path.c_str(), WATCH_MASK);
+    if(wd < 0) {
+      if(errno == ENOENT)return true; // already gone again, nothing to watch
+      Utils::Logger::log("FileWatcher: failed to watch: " + path.string(), Utils::Logger::LEVEL_WARN);
+      return false;
+    }
+    watchDirs[wd] = path;
+    return true;
+  };
+
+  if(!addWatch(dir))return false;
+
+  std::error_code ec{};
+  for(const auto &entry : fs::recursive_directory_iterator{dir, ec}) {
+    if(entry.is_directory(ec)) {
+      if(!addWatch(entry.path()))return false;
+    } else if(reportFiles && entry.is_regular_file(ec)) {
+      // files created before the watch was added would be missed otherwise
+      push(entry.path().string(), EventType::CHANGED);
+    }
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void Utils::FileWatcher::runNative()
+{
+#ifdef __linux__
+  alignas(inotify_event) char buff[16 * 1024];
+  pollfd pfd{inotifyFd, POLLIN, 0};
+
+  while(running)
+  {
+    // time-out to notice a 'stop()'
+    if(::poll(&pfd, 1, 200) <= 0)continue;
+
+    for(;;)
+    {
+      ssize_t len = read(inotifyFd, buff, sizeof(buff));
+      if(len <= 0)break;
+
+      for(char *ptr = buff; ptr < buff + len;)
+      {
+        auto *ev = reinterpret_cast<inotify_event*>(ptr);
+        ptr += sizeof(inotify_event) + ev->len;
+
+        if(ev->mask & IN_Q_OVERFLOW) {
+          push("", EventType::RESCAN);
+          continue;
+        }
+        if(ev->mask & IN_IGNORED) {
+          watchDirs.erase(ev->wd);
+          continue;
+        }
+
+        auto itDir = watchDirs.find(ev->wd);
+        if(itDir == watchDirs.end() || ev->len == 0)continue;
+        auto path = itDir->second / ev->name;
+
+        if(ev->mask & IN_ISDIR) {
+          if(ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+            if(!addWatchRecursive(path, true))push("", EventType::RESCAN);
+          } else if(ev->mask & IN_MOVED_FROM) {
+            // no events for the files inside a directory that got moved away
+            push("", EventType::RESCAN);
+          }
+          continue;
+        }
+
+        if(ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+          push(path.string(), EventType::REMOVED);
+        } else {
+          push(path.string(), EventType::CHANGED);
+        }
+      }
+    }
+  }
+
+  close(inotifyFd);
+  inotifyFd = -1;
+  watchDirs.clear();
+#endif
+}
+
+void Utils::FileWatcher::runPolling()
+{
+  std::unordered_map<std::string, uint64_t> files{};
+  bool initialScan = true;
+
+  while(running)
+  {
+    std::unordered_map<std::string, uint64_t> currentFiles{};
+    currentFiles.reserve(files.size());
+
+    std::error_code ec{};
+    for(const auto &root : roots) {
+      for(const auto &entry : fs::recursive_directory_iterator{root, ec}) {
+        if(!entry.is_regular_file(ec))continue;
+        auto pathStr = entry.path().string();
+        uint64_t age = Utils::FS::getFileAge(entry.path());
+
+        if(!initialScan) {
+          auto it = files.find(pathStr);
+          if(it == files.end() || it->second != age) {
+            push(pathStr, EventType::CHANGED);
+          }
+        }
+        currentFiles[pathStr] = age;
+      }
+    }
+
+    if(!initialScan) {
+      for(const auto &[pathStr, age] : files) {
+        if(!currentFiles.contains(pathStr))push(pathStr, EventType::REMOVED);
+      }
+    }
+
+    files = std::move(currentFiles);
+    initialScan = false;
+
+    std::unique_lock lock{mtx};
+    cv.wait_for(lock, POLL_INTERVAL, [this]{ return !running; });
+  }
+}
+
+void Utils::FileWatcher::start(const std::vector<fs::path> &dirs)
+{
+  stop();
+  roots = dirs;
+  running = true;
+
+#ifdef __linux__
+  inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if(inotifyFd >= 0)
+  {
+    // watches are set up before returning, so no change after this call can be missed
+    bool watching = true;
+    for(const auto &dir : roots) {
+      watching = watching && addWatchRecursive(dir, false);
+    }
+
+    if(watching) {
+      native = true;
+      thread = std::thread{[this]{ runNative(); }};
+      return;
+    }
+
+    // e.g. hitting the limit of inotify watches
+    close(inotifyFd);
+    inotifyFd = -1;
+    watchDirs.clear();
+  }
+  Utils::Logger::log("FileWatcher: inotify not available, using polling", Utils::Logger::LEVEL_WARN);
+#endif
+
+  native = false;
+  thread = std::thread{[this]{ runPolling(); }};
+}
+
+void Utils::FileWatcher::stop()
+{
+  {
+    std::lock_guard lock{mtx};
+    running = false;
+  }
+  cv.notify_all();
+  if(thread.joinable())thread.join();
+  discard();
+}
+
+std::vector<Utils::FileWatcher::Event> Utils::FileWatcher::poll()
+{
+  std::vector<Event> res{};
+  std::lock_guard lock{mtx};
+
+  if(rescanPending) {
+    rescanPending = false;
+    pending.clear();
+    res.push_back({"", EventType::RESCAN});
+    return res;
+  }
+
+  auto now = Clock::now();
+  for(auto it = pending.begin(); it != pending.end();) {
+    if(now - it->second.time < SETTLE_TIME) {
+      ++it;
+      continue;
+    }
+    res.push_back({it->first, it->second.type});
+    it = pending.erase(it);
+  }
+  return res;
+}
+
+void Utils::FileWatcher::discard()
+{
+  std::lock_guard lock{mtx};
+  pending.clear();
+  rescanPending = false;
+}
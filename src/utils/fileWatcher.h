@@ -0,0 +1,99 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Utils
+{
+  /**
+   * Watches directories recursively for file changes on a background thread.
+   * Uses inotify on linux, other platforms fall back to periodically scanning the directories.
+   *
+   * Events are coalesced per path, and only handed out once a file had no new
+   * events for a short time, so multi-step saves are reported once.
+   */
+  class FileWatcher
+  {
+    public:
+      enum class EventType : uint8_t
+      {
+        CHANGED, // created or modified
+        REMOVED,
+        RESCAN, // events got lost (e.g. queue overflow), the whole tree must be re-scanned
+      };
+
+      struct Event
+      {
+        std::string path{};
+        EventType type{};
+      };
+
+    private:
+      typedef std::chrono::steady_clock Clock;
+
+      struct PendingEvent
+      {
+        EventType type{};
+        Clock::time_point time{};
+      };
+
+      std::vector<fs::path> roots{};
+      std::thread thread{};
+      std::atomic_bool running{false};
+      std::mutex mtx{};
+      std::condition_variable cv{};
+      std::unordered_map<std::string, PendingEvent> pending{};
+      bool rescanPending{false};
+      bool native{false};
+
+      // inotify handle and watched directories, only used by the watcher thread after 'start()'
+      int inotifyFd{-1};
+      std::unordered_map<int, fs::path> watchDirs{};
+
+      void push(const std::string &path, EventType type);
+      bool addWatchRecursive(const fs::path &dir, bool reportFiles);
+      void runNative();
+      void runPolling();
+
+    public:
+      FileWatcher() = default;
+      ~FileWatcher();
+
+      FileWatcher(const FileWatcher&) = delete;
+      FileWatcher& operator=(const FileWatcher&) = delete;
+
+      /**
+       * Starts watching the given directories, stops any previous watch.
+       * Changes are only reported after this call, existing files are not.
+       */
+      void start(const std::vector<fs::path> &dirs);
+      void stop();
+
+      /**
+       * Returns all settled events since the last call, one per path.
+       * Meant to be called once per frame from the main thread.
+       */
+      std::vector<Event> poll();
+
+      /**
+       * Drops all events collected so far, e.g. after a full re-scan.
+       */
+      void discard();
+
+      [[nodiscard]] bool isRunning() const { return running; }
+      [[nodiscard]] bool isNative() const { return native; }
+  };
+}
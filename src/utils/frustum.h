@@ -0,0 +1,53 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "aabb.h"
+#include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+
+namespace Utils
+{
+  /**
+   * View frustum as 6 planes (normals pointing inwards), extracted from a view-projection matrix.
+   */
+  struct Frustum
+  {
+    glm::vec4 planes[6]{};
+
+    static Frustum fromMatrix(const glm::mat4 &viewProj)
+    {
+      Frustum res{};
+      glm::vec4 row[4];
+      for(int i=0; i<4; ++i) {
+        row[i] = {viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]};
+      }
+
+      res.planes[0] = row[3] + row[0]; // left
+      res.planes[1] = row[3] - row[0]; // right
+      res.planes[2] = row[3] + row[1]; // bottom
+      res.planes[3] = row[3] - row[1]; // top
+      res.planes[4] = row[3] + row[2]; // near
+      res.planes[5] = row[3] - row[2]; // far
+      return res;
+    }
+
+    /**
+     * Conservative test, boxes close to the corners of the frustum may be reported as visible.
+     */
+    [[nodiscard]] bool vsAABB(const AABB &aabb) const
+    {
+      for(const auto &plane : planes) {
+        // corner furthest along the plane normal
+        glm::vec3 p{
+          plane.x >= 0.0f ? aabb.max.x : aabb.min.x,
+          plane.y >= 0.0f ? aabb.max.y : aabb.min.y,
+          plane.z >= 0.0f ? aabb.max.z : aabb.min.z,
+        };
+        if(plane.x * p.x + plane.y * p.y + plane.z * p.z + plane.w < 0.0f)return false;
+      }
+      return true;
+    }
+  };
+}
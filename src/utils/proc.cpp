@@ -45,18 +45,24 @@ std::string Utils::Proc::runSync(const std::string &cmd)
   return result;
 }
 
-bool Utils::Proc::runSyncLogged(const std::string&cmd) {
+bool Utils::Proc::runSyncLogged(const std::string&cmd, bool buffered) {
   auto cmdWithErr = cmd + " 2>&1"; // @TODO: windows handling
   FILE* pipe = popen(cmdWithErr.c_str(), "r");
   if(!pipe)return "";
 
   char buffer[BUFF_SIZE];
+  std::string output{};
   while(!feof(pipe))
   {
     if(fgets(buffer, BUFF_SIZE, pipe) != nullptr) {
-      Logger::logRaw(buffer);
+      if(buffered) {
+        output += buffer;
+      } else {
+        Logger::logRaw(buffer);
+      }
     }
   }
+  if(!output.empty())Logger::logRaw(output);
   return pclose(pipe) == 0;
 }
 
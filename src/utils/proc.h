@@ -11,7 +11,12 @@ namespace fs = std::filesystem;
 namespace Utils::Proc
 {
   std::string runSync(const std::string &cmd);
-  bool runSyncLogged(const std::string &cmd);
+  /**
+   * Runs a command and forwards its output (stdout + stderr) to the logger.
+   * @param buffered if true, output is logged at once after the command finished.
+   *                 Use this when running commands in parallel to avoid interleaved lines.
+   */
+  bool runSyncLogged(const std::string &cmd, bool buffered = false);
 
   /// @brief 
   /// @return Return path to itself, i.e. the executable path.
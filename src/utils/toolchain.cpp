@@ -241,7 +241,7 @@ bool Utils::Toolchain::isInstalling()
   return installing.load();
 }
 
-bool Utils::Toolchain::runCmdSyncLogged(const std::string &cmd)
+bool Utils::Toolchain::runCmdSyncLogged(const std::string &cmd, bool buffered)
 {
   #if defined(_WIN32)
     auto minttyPath = state.mingwPath / "usr" / "bin" / "bash.exe";
@@ -251,11 +251,11 @@ bool Utils::Toolchain::runCmdSyncLogged(const std::string &cmd)
     for(char &c : command) {
       if(c == '\\')c = '/';
     }
-    return Utils::Proc::runSyncLogged(command);
+    return Utils::Proc::runSyncLogged(command, buffered);
     //Utils::Logger::logRaw(run_bash(command));
     //return true;
 
   #else
-    return Utils::Proc::runSyncLogged(cmd);
+    return Utils::Proc::runSyncLogged(cmd, buffered);
   #endif
 }
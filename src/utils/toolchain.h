@@ -33,7 +33,7 @@ namespace Utils
       void install(const std::string &libdragonPin = "");
       bool isInstalling();
 
-      bool runCmdSyncLogged(const std::string &cmd);
+      bool runCmdSyncLogged(const std::string &cmd, bool buffered = false);
 
       const State& getState() const { return state; }
   };
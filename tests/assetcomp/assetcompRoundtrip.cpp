@@ -0,0 +1,187 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Compresses the same inputs with 'Build::AssetCompress' and 'mkasset' for every level and compares the bytes.
+// Levels marked as reentrant are additionally compressed from multiple threads at once,
+// which must produce the same output as the single-threaded run.
+//
+// Usage: assetcompRoundtrip <work-dir> [extra input files...]
+// mkasset is taken from '$N64_INST/bin/mkasset', returns 77 (skipped) if not found.
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "build/tools/assetCompress.h"
+
+namespace
+{
+  constexpr int SKIPPED = 77;
+  constexpr int THREAD_COUNT = 8;
+
+  struct Input
+  {
+    std::string name{};
+    std::vector<uint8_t> data{};
+  };
+
+  std::vector<uint8_t> readFile(const fs::path &path)
+  {
+    std::ifstream f{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{f}, std::istreambuf_iterator<char>{}};
+  }
+
+  void writeFile(const fs::path &path, const std::vector<uint8_t> &data)
+  {
+    std::ofstream f{path, std::ios::binary};
+    f.write((const char*)data.data(), data.size());
+  }
+
+  // fixed seeds, the output has to be identical between runs
+  std::vector<Input> createInputs()
+  {
+    std::vector<Input> res{};
+    std::mt19937 rng{1234};
+
+    auto &noise = res.emplace_back("noise.bin");
+    noise.data.resize(64 * 1024);
+    for(auto &b : noise.data)b = rng() & 0xFF;
+
+    // similar to vertex data: small deltas, lots of repeated bytes
+    auto &verts = res.emplace_back("verts.bin");
+    int16_t pos = 0;
+    for(int i=0; i<24 * 1024; ++i) {
+      pos += (int16_t)(rng() % 9) - 4;
+      verts.data.push_back(pos >> 8);
+      verts.data.push_back(pos & 0xFF);
+      verts.data.push_back(0);
+      verts.data.push_back(0xFF);
+    }
+
+    auto &text = res.emplace_back("text.bin");
+    const char* words[] = {"pyrite ", "object ", "scene ", "vertex ", "\n", "collision ", "{ }; "};
+    while(text.data.size() < 48 * 1024) {
+      for(char c : std::string{words[rng() % std::size(words)]})text.data.push_back(c);
+    }
+
+    auto &tiny = res.emplace_back("tiny.bin");
+    tiny.data = {1, 2, 3};
+    return res;
+  }
+
+  fs::path findMkAsset()
+  {
+    const char* n64Inst = std::getenv("N64_INST");
+    if(!n64Inst || !n64Inst[0])return {};
+    auto path = fs::path{n64Inst} / "bin" / "mkasset";
+    return fs::exists(path) ? path : fs::path{};
+  }
+
+  bool compressMkAsset(const fs::path &mkAsset, const fs::path &file, int level)
+  {
+    auto cmd = "\"" + mkAsset.string() + "\" -c " + std::to_string(level)
+      + " -o \"" + file.parent_path().string() + "\" \"" + file.string() + "\"";
+    return std::system(cmd.c_str()) == 0;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if(argc < 2) {
+    printf("Usage: %s <work-dir> [files...]\n", argv[0]);
+    return 1;
+  }
+
+  if(!Build::AssetCompress::isNative()) {
+    printf("Native compression not compiled in\n");
+    return 1;
+  }
+
+  auto mkAsset = findMkAsset();
+  if(mkAsset.empty()) {
+    printf("mkasset not found ($N64_INST/bin/mkasset), skipped\n");
+    return SKIPPED;
+  }
+
+  auto inputs = createInputs();
+  for(int i=2; i<argc; ++i) {
+    inputs.push_back({fs::path{argv[i]}.filename().string(), readFile(argv[i])});
+  }
+
+  fs::path workDir{argv[1]};
+  int failed = 0;
+
+  for(int level=1; level<=Build::AssetCompress::LEVEL_MAX; ++level)
+  {
+    auto dirNative = workDir / ("native_" + std::to_string(level));
+    auto dirTool = workDir / ("mkasset_" + std::to_string(level));
+    fs::create_directories(dirNative);
+    fs::create_directories(dirTool);
+
+    for(auto &input : inputs)
+    {
+      auto fileNative = dirNative / input.name;
+      auto fileTool = dirTool / input.name;
+      writeFile(fileNative, input.data);
+      writeFile(fileTool, input.data);
+
+      if(!Build::AssetCompress::compressFile(fileNative, level)) {
+        printf("[FAIL] level %d, %s: native compression failed\n", level, input.name.c_str());
+        ++failed;
+        continue;
+      }
+      if(!compressMkAsset(mkAsset, fileTool, level)) {
+        printf("[FAIL] level %d, %s: mkasset failed\n", level, input.name.c_str());
+        ++failed;
+        continue;
+      }
+
+      auto bytesNative = readFile(fileNative);
+      auto bytesTool = readFile(fileTool);
+      bool same = bytesNative == bytesTool;
+      printf("[%s] level %d, %s: %zu -> %zu bytes\n", same ? " OK " : "FAIL",
+        level, input.name.c_str(), input.data.size(), bytesNative.size());
+      if(!same) {
+        printf("       mkasset: %zu bytes\n", bytesTool.size());
+        ++failed;
+      }
+    }
+
+    if(!Build::AssetCompress::isReentrant(level))continue;
+
+    // same inputs from all threads at once, each into its own file
+    for(auto &input : inputs)
+    {
+      auto expected = readFile(dirNative / input.name);
+      std::vector<fs::path> files{};
+      for(int t=0; t<THREAD_COUNT; ++t) {
+        files.push_back(dirNative / (input.name + ".mt" + std::to_string(t)));
+        writeFile(files.back(), input.data);
+      }
+
+      std::vector<std::thread> threads{};
+      std::vector<char> results(THREAD_COUNT, 0);
+      for(int t=0; t<THREAD_COUNT; ++t) {
+        threads.emplace_back([&, t] {
+          results[t] = Build::AssetCompress::compressFile(files[t], level);
+        });
+      }
+      for(auto &t : threads)t.join();
+
+      bool same = true;
+      for(int t=0; t<THREAD_COUNT; ++t) {
+        same = same && results[t] && readFile(files[t]) == expected;
+      }
+      printf("[%s] level %d, %s: %d threads\n", same ? " OK " : "FAIL", level, input.name.c_str(), THREAD_COUNT);
+      if(!same)++failed;
+    }
+  }
+
+  printf("%s (%d failed)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,281 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Encode time and quality of the BCI encoder, compared against the previous encoder ('Reference' below).
+// Images are generated with fixed seeds, so numbers are comparable between runs and machines.
+//
+// Usage: bciBench [--quick] [files.png...]
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lodepng.h"
+#include "build/tools/bci.h"
+
+namespace
+{
+  struct Image
+  {
+    std::string name{};
+    uint32_t width{};
+    uint32_t height{};
+    std::vector<uint8_t> rgba{};
+  };
+
+  template<typename F>
+  Image generate(const std::string &name, uint32_t size, F func)
+  {
+    Image img{name, size, size};
+    img.rgba.resize(size * size * 4);
+    for(uint32_t y=0; y<size; ++y) {
+      for(uint32_t x=0; x<size; ++x) {
+        auto *px = &img.rgba[(y * size + x) * 4];
+        func(x / (float)size, y / (float)size, px);
+        px[3] = 0xFF;
+      }
+    }
+    return img;
+  }
+
+  uint8_t toByte(float v) {
+    return (uint8_t)std::clamp(v * 255.0f + 0.5f, 0.0f, 255.0f);
+  }
+
+  std::vector<Image> createImages(uint32_t size)
+  {
+    std::vector<Image> res{};
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> noise{-0.08f, 0.08f};
+
+    res.push_back(generate("gradient", size, [](float u, float v, uint8_t* px) {
+      px[0] = toByte(u); px[1] = toByte(v); px[2] = toByte(1.0f - u * v);
+    }));
+
+    // stone/grass like texture: a few octaves of waves plus noise
+    res.push_back(generate("organic", size, [&](float u, float v, uint8_t* px) {
+      float h = 0.5f + 0.25f * sinf(u * 19.0f + cosf(v * 7.0f))
+                     + 0.15f * sinf(v * 41.0f + u * 13.0f)
+                     + noise(rng);
+      px[0] = toByte(h * 0.55f); px[1] = toByte(h * 0.75f + 0.1f); px[2] = toByte(h * 0.35f);
+    }));
+
+    // hard edges with unrelated colors, worst case for 4 color blocks
+    res.push_back(generate("tiles", size, [&](float u, float v, uint8_t* px) {
+      int cell = ((int)(u * 13.0f) * 7 + (int)(v * 11.0f) * 3) % 6;
+      const uint8_t cols[6][3] = {{230,40,40}, {40,200,60}, {30,60,220}, {240,220,50}, {20,20,20}, {250,250,250}};
+      memcpy(px, cols[cell], 3);
+    }));
+
+    res.push_back(generate("noise", size, [&](float, float, uint8_t* px) {
+      px[0] = rng() & 0xFF; px[1] = rng() & 0xFF; px[2] = rng() & 0xFF;
+    }));
+    return res;
+  }
+
+  /**
+   * Previous encoder ('Build::BCI::convertPNG' before the rewrite), kept as a baseline for speed and PSNR:
+   * k-means per 4x4 block with double distances (sqrt/pow) and a palette seeded by 'rand()'.
+   * Only changes: 'srand' with a fixed seed so runs are comparable, partial blocks repeat the edge pixel
+   * (the original read uninitialized pixels), and the error is computed like 'Build::BCI::encode' does.
+   */
+  namespace Reference
+  {
+    struct Color {
+      int r, g, b;
+      Color operator+(const Color& other) const {
+        return {r + other.r, g + other.g, b + other.b};
+      }
+      Color operator/(int val) const {
+        return {r / val, g / val, b / val};
+      }
+      double distance(const Color& other) const {
+        return sqrt(pow(r - other.r, 2) + pow(g - other.g, 2) + pow(b - other.b, 2));
+      }
+      bool operator==(const Color&other) const {
+        return r == other.r && g == other.g && b == other.b;
+      }
+      Color quantized() const {
+        return {(r & 0xF8) | (r >> 5), (g & 0xF8) | (g >> 5), (b & 0xF8) | (b >> 5)};
+      }
+    };
+
+    using Block = std::array<Color, 16>;
+    using Palette = std::array<Color, 4>;
+    using Indices = std::array<int, 16>;
+
+    void initialize_palette(const Block& block, Palette& palette) {
+      for (int i = 0; i < 4; ++i) {
+        palette[i] = block[rand() % 16];
+      }
+    }
+
+    Indices assign_clusters(const Block& block, const Palette& palette) {
+      Indices assignments;
+      for (int i = 0; i < 16; ++i) {
+        double min_dist = std::numeric_limits<double>::max();
+        int best_cluster = 0;
+        for (int j = 0; j < 4; ++j) {
+          double dist = block[i].distance(palette[j]);
+          if (dist < min_dist) {
+            min_dist = dist;
+            best_cluster = j;
+          }
+        }
+        assignments[i] = best_cluster;
+      }
+      return assignments;
+    }
+
+    void update_palette(const Block& block, Palette& palette, const Indices& assignments) {
+      std::array<Color, 4> new_colors = {};
+      std::array<int, 4> counts = {};
+
+      for (int i = 0; i < 16; ++i) {
+        int cluster = assignments[i];
+        new_colors[cluster] = new_colors[cluster] + block[i];
+        counts[cluster]++;
+      }
+
+      for (int i = 0; i < 4; ++i) {
+        if (counts[i] > 0) {
+          palette[i] = new_colors[i] / counts[i];
+        }
+      }
+    }
+
+    std::pair<Palette, Indices> kmeansPalette(const Block& block, int max_iters = 100) {
+      Palette palette;
+      initialize_palette(block, palette);
+      Indices assignments;
+
+      for (int iter = 0; iter < max_iters; ++iter) {
+        assignments = assign_clusters(block, palette);
+        Palette new_palette = palette;
+        update_palette(block, new_palette, assignments);
+
+        if (palette == new_palette) break; // Converged
+        palette = new_palette;
+      }
+
+      return {palette, assignments};
+    }
+
+    // @return mean squared error per channel
+    double encode(const Image &img)
+    {
+      srand(1234);
+      uint64_t err = 0;
+      uint64_t blockCount = 0;
+      for (unsigned y = 0; y < img.height; y += 4) {
+        for (unsigned x = 0; x < img.width; x += 4) {
+          Block block;
+          for (int i = 0; i < 16; ++i) {
+            unsigned px = std::min(x + (i % 4), img.width - 1);
+            unsigned py = std::min(y + (i / 4), img.height - 1);
+            unsigned index = 4 * (py * img.width + px);
+            block[i] = {img.rgba[index], img.rgba[index + 1], img.rgba[index + 2]};
+          }
+
+          auto [palette, indices] = kmeansPalette(block);
+          for (int i = 0; i < 16; ++i) {
+            auto p = palette[indices[i]].quantized();
+            err += (block[i].r - p.r) * (block[i].r - p.r)
+                 + (block[i].g - p.g) * (block[i].g - p.g)
+                 + (block[i].b - p.b) * (block[i].b - p.b);
+          }
+          ++blockCount;
+        }
+      }
+      return blockCount ? (double)err / (blockCount * 16 * 3) : 0.0;
+    }
+  }
+
+  double encodeTimeMs(const Image &img, uint32_t threads, int runs, std::vector<uint8_t> &out, double &mse)
+  {
+    double best = INFINITY;
+    for(int r=0; r<runs; ++r) {
+      auto start = std::chrono::steady_clock::now();
+      out = Build::BCI::encode(img.rgba.data(), img.width, img.height, threads, mse);
+      std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+      best = std::min(best, time.count());
+    }
+    return best;
+  }
+
+  double referenceTimeMs(const Image &img, int runs, double &mse)
+  {
+    double best = INFINITY;
+    for(int r=0; r<runs; ++r) {
+      auto start = std::chrono::steady_clock::now();
+      mse = Reference::encode(img);
+      std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+      best = std::min(best, time.count());
+    }
+    return best;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  bool quick = false;
+  std::vector<Image> images{};
+
+  for(int i=1; i<argc; ++i) {
+    if(strcmp(argv[i], "--quick") == 0) {
+      quick = true;
+      continue;
+    }
+    Image img{argv[i]};
+    unsigned w, h;
+    std::vector<unsigned char> data{};
+    if(lodepng::decode(data, w, h, argv[i])) {
+      printf("Failed to load: %s\n", argv[i]);
+      return 1;
+    }
+    img.width = w;
+    img.height = h;
+    img.rgba = std::move(data);
+    images.push_back(std::move(img));
+  }
+
+  if(images.empty())images = createImages(quick ? 128 : 1024);
+  int runs = quick ? 1 : 5;
+  uint32_t threadsMax = std::max(std::thread::hardware_concurrency(), 1u);
+
+  printf("%-12s %10s %10s %8s %10s %10s %10s %8s\n",
+    "image", "size", "old [ms]", "old PSNR", "1T [ms]", "speedup", "NT [ms]", "PSNR");
+
+  int failed = 0;
+  for(auto &img : images)
+  {
+    std::vector<uint8_t> outSingle{}, outMulti{};
+    double mseSingle = 0, mseMulti = 0;
+    double timeSingle = encodeTimeMs(img, 1, runs, outSingle, mseSingle);
+    double timeMulti = encodeTimeMs(img, threadsMax, runs, outMulti, mseMulti);
+
+    double mseRef = 0;
+    double timeRef = referenceTimeMs(img, runs, mseRef);
+
+    auto size = std::to_string(img.width) + "x" + std::to_string(img.height);
+    printf("%-12s %10s %10.2f %8.2f %10.2f %9.2fx %10.2f %8.2f\n", img.name.c_str(), size.c_str(),
+      timeRef, Build::BCI::getPSNR(mseRef), timeSingle, timeRef / timeSingle, timeMulti, Build::BCI::getPSNR(mseSingle));
+
+    if(outSingle != outMulti || mseSingle != mseMulti) {
+      printf("[FAIL] %s: output differs between 1 and %u threads\n", img.name.c_str(), threadsMax);
+      ++failed;
+    }
+  }
+
+  printf("old = previous encoder (single-threaded), speedup = old vs. 1T, NT = %u threads\n", threadsMax);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,250 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Replays raycasts and moving spheres against generated scenes, built with the editor's collision builder.
+// Prints the BVH nodes and triangles tested per query (same metrics as the debug overlay), and the host time per query.
+// Queries and movement are generated with fixed seeds before anything is timed, so numbers are comparable between runs.
+// Sphere movement is replayed (position + velocity set each frame), it doesn't depend on how collisions were resolved.
+//
+// Usage: collBench [--quick]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "collMesh.h"
+#include "collision/scene.h"
+#include "scene/scene.h"
+
+namespace
+{
+  constexpr float DELTA_TIME = 1.0f / 30.0f;
+  constexpr float SPHERE_RADIUS = 8.0f;
+
+  struct BenchScene
+  {
+    std::string name{};
+    std::unique_ptr<Test::CollMesh> mesh{};
+    uint32_t triCount{};
+    float size{};
+  };
+
+  struct Ray
+  {
+    fm_vec3_t pos{};
+    fm_vec3_t dir{};
+  };
+
+  struct Step
+  {
+    fm_vec3_t pos{};
+    fm_vec3_t velocity{};
+  };
+
+  struct Result
+  {
+    uint64_t count{};
+    uint64_t nodes{};
+    uint64_t tris{};
+    uint64_t bvhQueries{};
+    double timeNs{};
+  };
+
+  float terrainHeight(float x, float z) {
+    return 24.0f * sinf(x / 90.0f) * cosf(z / 70.0f) + 8.0f * sinf((x + z) / 37.0f);
+  }
+
+  BenchScene createScene(const std::string &name, float size, const Test::Geometry &geo)
+  {
+    BenchScene res{name, std::make_unique<Test::CollMesh>(geo), (uint32_t)(geo.indices.size() / 3), size};
+    return res;
+  }
+
+  std::vector<BenchScene> createScenes()
+  {
+    std::vector<BenchScene> res{};
+
+    Test::Geometry floor{};
+    floor.addGrid(1024.0f, 64, [](float, float) { return 0.0f; });
+    res.push_back(createScene("floor", 1024.0f, floor));
+
+    Test::Geometry terrain{};
+    terrain.addGrid(2048.0f, 128, terrainHeight);
+    res.push_back(createScene("terrain", 2048.0f, terrain));
+
+    // terrain with buildings, lots of walls and overlapping leaves
+    Test::Geometry city{};
+    city.addGrid(1024.0f, 48, terrainHeight);
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> distPos{-480.0f, 480.0f};
+    std::uniform_real_distribution<float> distSize{6.0f, 24.0f};
+    std::uniform_real_distribution<float> distHeight{20.0f, 120.0f};
+    for(int i=0; i<200; ++i) {
+      float x = distPos(rng);
+      float z = distPos(rng);
+      float halfW = distSize(rng);
+      float halfD = distSize(rng);
+      float y = terrainHeight(x, z) - 8.0f;
+      city.addBox({x - halfW, y, z - halfD}, {x + halfW, y + distHeight(rng), z + halfD});
+    }
+    res.push_back(createScene("city", 1024.0f, city));
+
+    return res;
+  }
+
+  std::vector<Ray> createRays(float size, uint32_t count, bool down)
+  {
+    std::vector<Ray> res{};
+    std::mt19937 rng{4321};
+    std::uniform_real_distribution<float> distPos{size * -0.45f, size * 0.45f};
+    std::uniform_real_distribution<float> distHeight{20.0f, 150.0f};
+    std::normal_distribution<float> distDir{};
+
+    for(uint32_t i=0; i<count; ++i) {
+      Ray ray{{distPos(rng), distHeight(rng), distPos(rng)}, {0.0f, -1.0f, 0.0f}};
+      if(!down) {
+        ray.dir = {distDir(rng), distDir(rng), distDir(rng)};
+        fm_vec3_norm(&ray.dir, &ray.dir);
+      }
+      res.push_back(ray);
+    }
+    return res;
+  }
+
+  /**
+   * Circles across the scene, slightly sunk into the ground so that every frame has collisions to resolve.
+   * Heights come from raycasts, done here so they are not part of the timing.
+   * @return steps per frame, 'sphereCount' entries each
+   */
+  std::vector<Step> createSphereSteps(P64::Coll::Scene &scene, float size, uint32_t sphereCount, uint32_t frames)
+  {
+    std::mt19937 rng{5678};
+    std::uniform_real_distribution<float> distPos{size * -0.3f, size * 0.3f};
+    std::uniform_real_distribution<float> distRadius{40.0f, size * 0.15f};
+    std::uniform_real_distribution<float> distAngle{0.0f, 6.2831853f};
+    std::uniform_real_distribution<float> distSpeed{60.0f, 240.0f};
+
+    struct Path {
+      float x, z, radius, angle, speed;
+    };
+    std::vector<Path> paths{};
+    for(uint32_t i=0; i<sphereCount; ++i) {
+      paths.push_back({distPos(rng), distPos(rng), distRadius(rng), distAngle(rng), distSpeed(rng)});
+    }
+
+    auto getPos = [&](const Path &p, float time) {
+      float angle = p.angle + time * p.speed / p.radius;
+      fm_vec3_t pos{p.x + cosf(angle) * p.radius, 300.0f, p.z + sinf(angle) * p.radius};
+      auto hit = scene.raycast(pos, {0.0f, -1.0f, 0.0f});
+      pos.y = hit.hasResult() ? (hit.hitPos.y + SPHERE_RADIUS * 0.9f) : 0.0f;
+      return pos;
+    };
+
+    std::vector<Step> res{};
+    for(uint32_t f=0; f<frames; ++f) {
+      for(auto &p : paths) {
+        auto pos = getPos(p, f * DELTA_TIME);
+        auto posNext = getPos(p, (f + 1) * DELTA_TIME);
+        res.push_back({pos, (posNext - pos) / DELTA_TIME});
+      }
+    }
+    return res;
+  }
+
+  template<typename F>
+  Result measure(P64::Coll::Scene &scene, uint32_t runs, F &&func)
+  {
+    Result res{};
+    res.timeNs = 1e30;
+    for(uint32_t r=0; r<runs; ++r) {
+      scene.resetMetrics();
+      auto start = std::chrono::steady_clock::now();
+      res.count = func();
+      auto end = std::chrono::steady_clock::now();
+      res.timeNs = std::min(res.timeNs, (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+    res.nodes = scene.bvhNodeCount;
+    res.tris = scene.triTestCount;
+    res.bvhQueries = scene.bvhQueryCount;
+    return res;
+  }
+
+  void printResult(const BenchScene &scene, const char* query, const Result &res)
+  {
+    double count = (double)std::max<uint64_t>(res.count, 1);
+    printf("%-10s %-10s %8llu %10.2f %10.2f %10.2f %10.1f\n", scene.name.c_str(), query,
+      (unsigned long long)res.count, res.bvhQueries / count, res.nodes / count, res.tris / count, res.timeNs / count
+    );
+  }
+}
+
+int main(int argc, char** argv)
+{
+  bool quick = false;
+  for(int i=1; i<argc; ++i) {
+    if(strcmp(argv[i], "--quick") == 0)quick = true;
+  }
+
+  const uint32_t runs = quick ? 1 : 5;
+  const uint32_t rayCount = quick ? 512 : 16384;
+  const uint32_t sphereCount = quick ? 16 : 64;
+  const uint32_t frames = quick ? 30 : 240;
+
+  auto scenes = createScenes();
+  printf("%-10s %8s %8s %10s\n", "scene", "tris", "chunks", "bytes");
+  for(auto &scene : scenes) {
+    printf("%-10s %8u %8u %10u\n", scene.name.c_str(), scene.triCount, scene.mesh->get()->chunkCount, scene.mesh->getFileSize());
+  }
+  printf("\n%-10s %-10s %8s %10s %10s %10s %10s\n", "scene", "query", "count", "BVH/q", "nodes/q", "tris/q", "ns/q");
+
+  for(auto &benchScene : scenes)
+  {
+    P64::Object obj{};
+    P64::Coll::MeshInstance inst{.mesh = benchScene.mesh->get(), .object = &obj};
+    P64::Coll::Scene scene{};
+    scene.registerMesh(&inst);
+
+    for(bool down : {true, false}) {
+      auto rays = createRays(benchScene.size, rayCount, down);
+      auto res = measure(scene, runs, [&] {
+        for(auto &ray : rays)scene.raycast(ray.pos, ray.dir);
+        return (uint64_t)rays.size();
+      });
+      printResult(benchScene, down ? "ray-down" : "ray-any", res);
+    }
+
+    auto steps = createSphereSteps(scene, benchScene.size, sphereCount, frames);
+    std::vector<P64::Object> sphereObjects(sphereCount);
+    std::vector<P64::Coll::BCS> spheres(sphereCount);
+    for(uint32_t i=0; i<sphereCount; ++i) {
+      spheres[i] = {
+        .halfExtend = {SPHERE_RADIUS, SPHERE_RADIUS, SPHERE_RADIUS},
+        .obj = &sphereObjects[i],
+        .maskRead = 0xFF,
+      };
+      scene.registerBCS(&spheres[i]);
+    }
+
+    auto res = measure(scene, runs, [&] {
+      for(uint32_t f=0; f<frames; ++f) {
+        for(uint32_t i=0; i<sphereCount; ++i) {
+          auto &step = steps[f * sphereCount + i];
+          spheres[i].center = step.pos;
+          spheres[i].velocity = step.velocity;
+        }
+        scene.update(DELTA_TIME);
+      }
+      return (uint64_t)frames * sphereCount;
+    });
+    printResult(benchScene, "sphere", res);
+  }
+
+  printf("\nBVH/q: BVH queries per query (sphere: per sphere and frame), ns/q: host time, not representative of the N64\n");
+  return 0;
+}
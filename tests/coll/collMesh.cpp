@@ -0,0 +1,142 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "collMesh.h"
+#include <bit>
+#include <cstddef>
+#include <cstring>
+
+#include "build/tools/collisionMesh.h"
+
+namespace
+{
+  // sizes in the N64 data, see 'Build::CollisionMesh::write'
+  constexpr uint32_t CHUNK_HEADER_SIZE = 16;
+  constexpr uint32_t CHUNK_ENTRY_SIZE = 16;
+  constexpr uint32_t MESH_HEADER_SIZE = 6 * 4;
+
+  constexpr uint32_t MESH_HEADER_SIZE_HOST = offsetof(P64::Coll::Mesh, indices);
+  static_assert(MESH_HEADER_SIZE_HOST % 4 == 0, "mesh data must keep its 4-byte alignment");
+
+  struct Reader
+  {
+    const std::vector<uint8_t> &data;
+
+    [[nodiscard]] uint16_t u16(uint32_t pos) const {
+      return (uint16_t)((data[pos] << 8) | data[pos+1]);
+    }
+    [[nodiscard]] uint32_t u32(uint32_t pos) const {
+      return ((uint32_t)u16(pos) << 16) | u16(pos+2);
+    }
+  };
+
+  template<typename T>
+  void writeHost(std::vector<uint8_t> &out, uint32_t pos, T value) {
+    memcpy(out.data() + pos, &value, sizeof(T));
+  }
+}
+
+void Test::Geometry::addTri(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+{
+  auto base = (uint32_t)vertices.size();
+  vertices.push_back(a);
+  vertices.push_back(b);
+  vertices.push_back(c);
+  indices.push_back(base);
+  indices.push_back(base + 1);
+  indices.push_back(base + 2);
+}
+
+void Test::Geometry::addQuad(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec3 &d)
+{
+  auto base = (uint32_t)vertices.size();
+  vertices.push_back(a);
+  vertices.push_back(b);
+  vertices.push_back(c);
+  vertices.push_back(d);
+  for(uint32_t idx : {0u, 1u, 2u, 0u, 2u, 3u})indices.push_back(base + idx);
+}
+
+void Test::Geometry::addBox(const glm::vec3 &min, const glm::vec3 &max)
+{
+  glm::vec3 c[8]{};
+  for(int i=0; i<8; ++i) {
+    c[i] = {(i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z};
+  }
+  addQuad(c[0], c[4], c[6], c[2]); // -X
+  addQuad(c[1], c[3], c[7], c[5]); // +X
+  addQuad(c[0], c[1], c[5], c[4]); // -Y
+  addQuad(c[2], c[6], c[7], c[3]); // +Y
+  addQuad(c[0], c[2], c[3], c[1]); // -Z
+  addQuad(c[4], c[5], c[7], c[6]); // +Z
+}
+
+void Test::Geometry::addGrid(float size, int cells, const std::function<float(float, float)> &height)
+{
+  auto base = (uint32_t)vertices.size();
+  float step = size / (float)cells;
+  float start = size * -0.5f;
+
+  for(int z=0; z<=cells; ++z) {
+    for(int x=0; x<=cells; ++x) {
+      float posX = start + (float)x * step;
+      float posZ = start + (float)z * step;
+      vertices.push_back({posX, height(posX, posZ), posZ});
+    }
+  }
+
+  uint32_t stride = cells + 1;
+  for(int z=0; z<cells; ++z) {
+    for(int x=0; x<cells; ++x) {
+      uint32_t i = base + z * stride + x;
+      for(uint32_t idx : {i, i + stride, i + stride + 1, i, i + stride + 1, i + 1}) {
+        indices.push_back(idx);
+      }
+    }
+  }
+}
+
+Test::CollMesh::CollMesh(const Geometry &geo)
+{
+  Utils::BinaryFile file{};
+  Build::CollisionMesh::write(file, geo.vertices, geo.indices);
+  const auto &bytes = file.getData();
+  fileSize = bytes.size();
+  Reader in{bytes};
+
+  // container header and chunk table have the same layout on the host, only the byte order differs
+  uint32_t chunkCount = in.u32(0);
+  uint32_t tableSize = CHUNK_HEADER_SIZE + chunkCount * CHUNK_ENTRY_SIZE;
+  std::vector<uint8_t> out(tableSize);
+
+  writeHost(out, 0, chunkCount);
+  for(uint32_t i=4; i<CHUNK_HEADER_SIZE; i+=2)writeHost(out, i, in.u16(i));
+
+  for(uint32_t c=0; c<chunkCount; ++c)
+  {
+    uint32_t entry = CHUNK_HEADER_SIZE + c * CHUNK_ENTRY_SIZE;
+    for(uint32_t i=0; i<12; i+=2)writeHost(out, entry + i, in.u16(entry + i));
+
+    uint32_t start = in.u32(entry + 12);
+    uint32_t end = (c + 1 < chunkCount) ? in.u32(entry + CHUNK_ENTRY_SIZE + 12) : (uint32_t)bytes.size();
+
+    // 'Coll::Mesh' header with host pointers, everything after it (indices, normals, verts, BVH) is 16-bit
+    uint32_t meshPos = (out.size() + 7) & ~7u;
+    out.resize(meshPos + MESH_HEADER_SIZE_HOST + (end - start - MESH_HEADER_SIZE));
+    writeHost(out, entry + 12, meshPos);
+
+    writeHost(out, meshPos + offsetof(P64::Coll::Mesh, triCount), in.u32(start));
+    writeHost(out, meshPos + offsetof(P64::Coll::Mesh, vertCount), in.u32(start + 4));
+    writeHost(out, meshPos + offsetof(P64::Coll::Mesh, vertScale), std::bit_cast<float>(in.u32(start + 8)));
+
+    uint32_t dst = meshPos + MESH_HEADER_SIZE_HOST;
+    for(uint32_t src = start + MESH_HEADER_SIZE; src < end; src += 2, dst += 2) {
+      writeHost(out, dst, in.u16(src));
+    }
+  }
+
+  data.resize((out.size() + 7) / 8);
+  memcpy(data.data(), out.data(), out.size());
+  P64::Coll::MeshChunks::load(data.data());
+}
@@ -0,0 +1,55 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "glm/vec3.hpp"
+#include "collision/mesh.h"
+
+namespace Test
+{
+  /**
+   * Triangles to build a collision mesh from, in the same units as after 'baseScale' is applied in the editor.
+   */
+  struct Geometry
+  {
+    std::vector<glm::vec3> vertices{};
+    std::vector<uint32_t> indices{};
+
+    void addTri(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c);
+    // counter-clockwise, seen from the side the normal points to
+    void addQuad(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec3 &d);
+    // all six sides facing outwards
+    void addBox(const glm::vec3 &min, const glm::vec3 &max);
+
+    /**
+     * Grid of 'cells' x 'cells' quads in the XZ plane, centered at the origin, normals pointing up.
+     * @param height Y at the given X/Z
+     */
+    void addGrid(float size, int cells, const std::function<float(float, float)> &height);
+  };
+
+  /**
+   * Collision mesh built by 'Build::CollisionMesh::write' (the same as 'Build::buildCollision' once the glTF is parsed).
+   * The big-endian N64 data is converted into the host layout ('Coll::Mesh' has 64-bit pointers here),
+   * and loaded the same way the runtime does.
+   */
+  class CollMesh
+  {
+    private:
+      std::vector<uint64_t> data{}; // 8-byte aligned for the pointers in 'Coll::Mesh'
+      uint32_t fileSize{};
+
+    public:
+      explicit CollMesh(const Geometry &geo);
+
+      [[nodiscard]] P64::Coll::MeshChunks* get() { return (P64::Coll::MeshChunks*)data.data(); }
+
+      // size as written into the ROM
+      [[nodiscard]] uint32_t getFileSize() const { return fileSize; }
+  };
+}
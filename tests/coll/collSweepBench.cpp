@@ -0,0 +1,290 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Compares the two ways of checking a moving shape against meshes in 'Coll::Scene::vsBCS':
+// - 'per-step': the BVH of every mesh chunk is queried again on each sub-step (what 'vsBCS' did before),
+//   re-implemented here with the public BVH/mesh API.
+// - 'cached': the current 'vsBCS', one query for the whole movement, sub-steps only test the cached triangles.
+// Each sweep is a single sphere starting on the ground, moving with a fixed velocity for one frame.
+// Speeds are grouped so that sweeps use 1, ~4 and 8 sub-steps.
+// Prints sub-steps, BVH queries, nodes and triangles tested per sweep, the host time,
+// and how far the end positions of both paths are apart (should be close to zero).
+//
+// Usage: collSweepBench [--quick]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "collMesh.h"
+#include "collision/bvh.h"
+#include "collision/scene.h"
+#include "scene/scene.h"
+
+namespace
+{
+  constexpr float DELTA_TIME = 1.0f / 30.0f;
+  constexpr float SPHERE_RADIUS = 8.0f;
+  constexpr float MIN_PENETRATION = 0.00004f; // same as in 'vsBCS'
+
+  struct BenchScene
+  {
+    std::string name{};
+    std::unique_ptr<Test::CollMesh> mesh{};
+    float size{};
+  };
+
+  struct Sweep
+  {
+    fm_vec3_t pos{};
+    fm_vec3_t velocity{};
+  };
+
+  struct SpeedClass
+  {
+    const char* name;
+    float minSpeed; // units per second
+    float maxSpeed;
+  };
+
+  // sub-steps are 'len * 1.5' clamped to 1-8, with 'len' the distance moved in a frame
+  constexpr SpeedClass SPEED_CLASSES[] = {
+    {"slow", 6.0f, 18.0f},
+    {"medium", 60.0f, 100.0f},
+    {"fast", 180.0f, 600.0f},
+  };
+
+  struct Metrics
+  {
+    uint64_t steps{};
+    uint64_t bvhQueries{};
+    uint64_t nodes{};
+    uint64_t tris{};
+  };
+
+  struct Result
+  {
+    Metrics metrics{};
+    double timeNs{};
+    std::vector<fm_vec3_t> endPos{};
+  };
+
+  float terrainHeight(float x, float z) {
+    return 24.0f * sinf(x / 90.0f) * cosf(z / 70.0f) + 8.0f * sinf((x + z) / 37.0f);
+  }
+
+  std::vector<BenchScene> createScenes()
+  {
+    std::vector<BenchScene> res{};
+
+    Test::Geometry terrain{};
+    terrain.addGrid(2048.0f, 128, terrainHeight);
+    res.push_back({"terrain", std::make_unique<Test::CollMesh>(terrain), 2048.0f});
+
+    // walls to run into, collisions push the sphere around during the movement
+    Test::Geometry city{};
+    city.addGrid(1024.0f, 48, terrainHeight);
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> distPos{-480.0f, 480.0f};
+    std::uniform_real_distribution<float> distSize{6.0f, 24.0f};
+    std::uniform_real_distribution<float> distHeight{20.0f, 120.0f};
+    for(int i=0; i<200; ++i) {
+      float x = distPos(rng);
+      float z = distPos(rng);
+      float halfW = distSize(rng);
+      float halfD = distSize(rng);
+      float y = terrainHeight(x, z) - 8.0f;
+      city.addBox({x - halfW, y, z - halfD}, {x + halfW, y + distHeight(rng), z + halfD});
+    }
+    res.push_back({"city", std::make_unique<Test::CollMesh>(city), 1024.0f});
+
+    return res;
+  }
+
+  /**
+   * Spheres slightly sunk into the ground, moving in a random direction along it.
+   * Heights come from raycasts, done here so they are not part of the timing.
+   */
+  std::vector<Sweep> createSweeps(P64::Coll::Scene &scene, float size, const SpeedClass &speed, uint32_t count)
+  {
+    std::mt19937 rng{5678};
+    std::uniform_real_distribution<float> distPos{size * -0.4f, size * 0.4f};
+    std::uniform_real_distribution<float> distAngle{0.0f, 6.2831853f};
+    std::uniform_real_distribution<float> distSpeed{speed.minSpeed, speed.maxSpeed};
+    std::uniform_real_distribution<float> distFall{-60.0f, 0.0f};
+
+    std::vector<Sweep> res{};
+    while(res.size() < count) {
+      fm_vec3_t pos{distPos(rng), 300.0f, distPos(rng)};
+      float angle = distAngle(rng);
+      float velocity = distSpeed(rng);
+
+      auto hit = scene.raycast(pos, {0.0f, -1.0f, 0.0f});
+      if(!hit.hasResult())continue;
+      pos.y = hit.hitPos.y + SPHERE_RADIUS * 0.9f;
+      res.push_back({pos, {cosf(angle) * velocity, distFall(rng), sinf(angle) * velocity}});
+    }
+    return res;
+  }
+
+  /**
+   * 'vsBCS' as it was before the triangle cache, spheres only:
+   * each sub-step queries the BVH of all chunks overlapping the shape, and tests every triangle returned.
+   */
+  fm_vec3_t sweepPerStep(const P64::Coll::MeshInstance &meshInst, P64::Coll::BCS bcs, float deltaTime, Metrics &metrics)
+  {
+    float len = fm_vec3_len(&bcs.velocity) * deltaTime;
+    int steps = std::clamp((int)(len * 1.5f), 1, 8);
+    auto velocityStep = bcs.velocity * (deltaTime / steps);
+    metrics.steps += steps;
+
+    P64::Coll::BVHResult bvhRes{};
+    uint64_t ticksBVH{};
+    const auto &chunks = *meshInst.mesh;
+
+    for(int s=0; s<steps; ++s)
+    {
+      bcs.center = bcs.center + velocityStep;
+
+      auto bcsLocal = bcs;
+      bcsLocal.center = meshInst.intoLocalSpace(bcs.center);
+      bcsLocal.halfExtend *= meshInst.invScale;
+      auto aabbLocal = bcsLocal.toAABB();
+
+      for(uint32_t c=0; c<chunks.chunkCount; ++c)
+      {
+        if(!chunks.chunks[c].aabb.vsAABB(aabbLocal))continue;
+        const auto &mesh = chunks.getMesh(c);
+
+        bvhRes.reset();
+        do {
+          auto ticksBvhStart = get_ticks();
+          mesh.bvh->vsBCS(bcsLocal, bvhRes);
+          ticksBVH += get_ticks() - ticksBvhStart;
+          metrics.tris += bvhRes.count;
+
+          for(int b=0; b<bvhRes.count; ++b) {
+            P64::Coll::Triangle tri;
+            mesh.getTriangle(bvhRes.triIndex[b], tri);
+
+            auto collInfo = mesh.vsSphere(bcsLocal, tri);
+            if(collInfo.collCount && t3d_vec3_len2(&collInfo.penetration) >= MIN_PENETRATION) {
+              bcsLocal.center -= collInfo.penetration;
+            }
+          }
+        } while(bvhRes.hasMore());
+
+        ++metrics.bvhQueries;
+        metrics.nodes += bvhRes.nodesVisited;
+      }
+
+      bcs.center = meshInst.outOfLocalSpace(bcsLocal.center);
+    }
+    return bcs.center;
+  }
+
+  template<typename F>
+  Result measure(uint32_t runs, const std::vector<Sweep> &sweeps, F &&sweepFunc)
+  {
+    Result res{};
+    res.timeNs = 1e30;
+    for(uint32_t r=0; r<runs; ++r) {
+      res.metrics = {};
+      res.endPos.clear();
+      auto start = std::chrono::steady_clock::now();
+      for(auto &sweep : sweeps) {
+        res.endPos.push_back(sweepFunc(sweep, res.metrics));
+      }
+      auto end = std::chrono::steady_clock::now();
+      res.timeNs = std::min(res.timeNs, (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+    return res;
+  }
+
+  void printResult(const BenchScene &scene, const SpeedClass &speed, const char* path, const Result &res, float maxDiff)
+  {
+    double count = (double)std::max<size_t>(res.endPos.size(), 1);
+    const auto &m = res.metrics;
+    printf("%-8s %-7s %-9s %8.2f %8.2f %9.2f %8.2f %9.1f %8.3f\n", scene.name.c_str(), speed.name, path,
+      m.steps / count, m.bvhQueries / count, m.nodes / count, m.tris / count, res.timeNs / count, maxDiff
+    );
+  }
+}
+
+int main(int argc, char** argv)
+{
+  bool quick = false;
+  for(int i=1; i<argc; ++i) {
+    if(strcmp(argv[i], "--quick") == 0)quick = true;
+  }
+
+  const uint32_t runs = quick ? 1 : 5;
+  const uint32_t sweepCount = quick ? 256 : 8192;
+
+  auto scenes = createScenes();
+  printf("%-8s %-7s %-9s %8s %8s %9s %8s %9s %8s\n",
+    "scene", "speed", "path", "steps/s", "BVH/s", "nodes/s", "tris/s", "ns/s", "diff");
+
+  for(auto &benchScene : scenes)
+  {
+    P64::Object obj{};
+    P64::Coll::MeshInstance inst{.mesh = benchScene.mesh->get(), .object = &obj};
+    P64::Coll::Scene scene{};
+    scene.registerMesh(&inst);
+
+    P64::Object sphereObj{};
+    P64::Coll::BCS sphere{
+      .halfExtend = {SPHERE_RADIUS, SPHERE_RADIUS, SPHERE_RADIUS},
+      .obj = &sphereObj,
+      .maskRead = 0xFF,
+    };
+
+    for(auto &speed : SPEED_CLASSES)
+    {
+      auto sweeps = createSweeps(scene, benchScene.size, speed, sweepCount);
+
+      auto resStep = measure(runs, sweeps, [&](const Sweep &sweep, Metrics &metrics) {
+        auto bcs = sphere;
+        bcs.center = sweep.pos;
+        bcs.velocity = sweep.velocity;
+        return sweepPerStep(inst, bcs, DELTA_TIME, metrics);
+      });
+
+      // the real 'vsBCS', through the scene with only this sphere registered
+      scene.registerBCS(&sphere);
+      auto resCached = measure(runs, sweeps, [&](const Sweep &sweep, Metrics &metrics) {
+        sphere.center = sweep.pos;
+        sphere.velocity = sweep.velocity;
+        scene.resetMetrics();
+        scene.update(DELTA_TIME);
+
+        float len = fm_vec3_len(&sweep.velocity) * DELTA_TIME;
+        metrics.steps += std::clamp((int)(len * 1.5f), 1, 8);
+        metrics.bvhQueries += scene.bvhQueryCount;
+        metrics.nodes += scene.bvhNodeCount;
+        metrics.tris += scene.triTestCount;
+        return sphere.center;
+      });
+      scene.unregisterBCS(&sphere);
+
+      float maxDiff = 0.0f;
+      for(size_t i=0; i<sweeps.size(); ++i) {
+        auto diff = resCached.endPos[i] - resStep.endPos[i];
+        maxDiff = std::max(maxDiff, fm_vec3_len(&diff));
+      }
+
+      printResult(benchScene, speed, "per-step", resStep, 0.0f);
+      printResult(benchScene, speed, "cached", resCached, maxDiff);
+    }
+  }
+
+  printf("\n/s: per sweep (one sphere moving for one frame), ns/s: host time, not representative of the N64\n");
+  printf("diff: max. distance between the end positions of both paths\n");
+  return 0;
+}
@@ -0,0 +1,281 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Golden tests for the runtime collision ('P64::Coll'), pins raycast hits and where shapes end up after 'Scene::update'.
+// Expected values are derived from the generated geometry, tolerances cover the precision of the N64 format
+// (fixed-point vertices, 8-bit octahedral normals).
+//
+// Usage: collTest
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "collMesh.h"
+#include "collision/scene.h"
+#include "scene/scene.h"
+#include "scene/sceneManager.h"
+
+namespace
+{
+  constexpr float DELTA_TIME = 1.0f / 30.0f;
+
+  constexpr float TERRAIN_SIZE = 1024.0f;
+  constexpr int TERRAIN_CELLS = 48;
+
+  int failCount = 0;
+
+  void expect(const std::string &name, bool ok, const std::string &info = {})
+  {
+    printf("[%s] %s%s%s\n", ok ? " OK " : "FAIL", name.c_str(), info.empty() ? "" : ": ", info.c_str());
+    if(!ok)++failCount;
+  }
+
+  std::string toString(const fm_vec3_t &v) {
+    char buff[64];
+    snprintf(buff, sizeof(buff), "%.3f %.3f %.3f", v.x, v.y, v.z);
+    return buff;
+  }
+
+  void expectNear(const std::string &name, const fm_vec3_t &actual, const fm_vec3_t &expected, const fm_vec3_t &tolerance)
+  {
+    auto diff = actual - expected;
+    bool ok = fabsf(diff.x) <= tolerance.x && fabsf(diff.y) <= tolerance.y && fabsf(diff.z) <= tolerance.z;
+    expect(name, ok, toString(actual) + " (expected " + toString(expected) + ")");
+  }
+
+  void expectNear(const std::string &name, const fm_vec3_t &actual, const fm_vec3_t &expected, float tolerance) {
+    expectNear(name, actual, expected, fm_vec3_t{tolerance, tolerance, tolerance});
+  }
+
+  // Shapes resting on the floor can slide a bit sideways, pushed by the edges of neighboring triangles.
+  // How much depends on the order triangles are tested in (BVH layout), so only the height is checked exactly.
+  void expectResting(const std::string &name, const fm_vec3_t &actual, const fm_vec3_t &expected) {
+    expectNear(name, actual, expected, fm_vec3_t{1.0f, 0.05f, 1.0f});
+  }
+
+  void expectHit(const std::string &name, const P64::Coll::RaycastRes &res, const fm_vec3_t &pos, const fm_vec3_t &normal, float tolerance)
+  {
+    if(!res.hasResult())return expect(name, false, "no hit");
+    expectNear(name + " (pos)", res.hitPos, pos, tolerance);
+    expectNear(name + " (normal)", res.normal, normal, 0.01f);
+  }
+
+  float terrainHeight(float x, float z) {
+    return 24.0f * sinf(x / 90.0f) * cosf(z / 70.0f) + 8.0f * sinf((x + z) / 37.0f);
+  }
+
+  // height of the triangulated terrain, same split as 'Geometry::addGrid'
+  float terrainHeightTri(float x, float z)
+  {
+    float step = TERRAIN_SIZE / TERRAIN_CELLS;
+    float start = TERRAIN_SIZE * -0.5f;
+    float cellX = floorf((x - start) / step);
+    float cellZ = floorf((z - start) / step);
+    float x0 = start + cellX * step;
+    float z0 = start + cellZ * step;
+    float u = (x - x0) / step;
+    float v = (z - z0) / step;
+
+    float h00 = terrainHeight(x0, z0);
+    float h10 = terrainHeight(x0 + step, z0);
+    float h01 = terrainHeight(x0, z0 + step);
+    float h11 = terrainHeight(x0 + step, z0 + step);
+    if(u <= v)return h00 + (h01 - h00) * v + (h11 - h01) * u;
+    return h00 + (h10 - h00) * u + (h11 - h10) * v;
+  }
+
+  // Floor at Y=0 (dense enough that large shapes overlap more triangles than a single BVH query returns),
+  // a wall-like box at X=100..120 and a ramp going up towards -X.
+  Test::Geometry createRoom()
+  {
+    Test::Geometry geo{};
+    geo.addGrid(512.0f, 64, [](float, float) { return 0.0f; });
+    geo.addBox({100.0f, 0.0f, -100.0f}, {120.0f, 60.0f, 100.0f});
+    geo.addQuad({-100.0f, 0.0f, -50.0f}, {-200.0f, 50.0f, -50.0f}, {-200.0f, 50.0f, 50.0f}, {-100.0f, 0.0f, 50.0f});
+    return geo;
+  }
+
+  Test::Geometry createTerrain()
+  {
+    Test::Geometry geo{};
+    geo.addGrid(TERRAIN_SIZE, TERRAIN_CELLS, terrainHeight);
+    return geo;
+  }
+
+  P64::Coll::BCS createShape(P64::Object &obj, const fm_vec3_t &pos, float radius, const fm_vec3_t &velocity, uint8_t flags = 0)
+  {
+    obj.pos = pos;
+    return {
+      .center = pos,
+      .halfExtend = {radius, radius, radius},
+      .velocity = velocity,
+      .obj = &obj,
+      .maskRead = 0xFF,
+      .maskWrite = 0xFF,
+      .flags = flags,
+    };
+  }
+
+  void simulate(P64::Coll::Scene &scene, int frames) {
+    for(int f=0; f<frames; ++f)scene.update(DELTA_TIME);
+  }
+
+  void testRoomRaycast(Test::CollMesh &room)
+  {
+    P64::Object obj{};
+    P64::Coll::MeshInstance inst{.mesh = room.get(), .object = &obj};
+    P64::Coll::Scene scene{};
+    scene.registerMesh(&inst);
+
+    const fm_vec3_t up{0.0f, 1.0f, 0.0f};
+    const fm_vec3_t down{0.0f, -1.0f, 0.0f};
+    const fm_vec3_t slopeNormal{0.4472136f, 0.8944272f, 0.0f};
+
+    expectHit("room: floor", scene.raycast({0.0f, 100.0f, 0.0f}, down), {0.0f, 0.0f, 0.0f}, up, 0.01f);
+    expectHit("room: floor, not normalized", scene.raycast({30.0f, 100.0f, -20.0f}, down * 40.0f), {30.0f, 0.0f, -20.0f}, up, 0.01f);
+    expectHit("room: box top", scene.raycast({110.0f, 200.0f, 0.0f}, down), {110.0f, 60.0f, 0.0f}, up, 0.01f);
+    expectHit("room: box side", scene.raycast({0.0f, 20.0f, 5.0f}, {1.0f, 0.0f, 0.0f}), {100.0f, 20.0f, 5.0f}, {-1.0f, 0.0f, 0.0f}, 0.01f);
+    expectHit("room: ramp", scene.raycast({-150.0f, 100.0f, 10.0f}, down), {-150.0f, 25.0f, 10.0f}, slopeNormal, 0.5f);
+
+    // back-faces are ignored, and nothing is above the floor here
+    expect("room: up from the floor misses", !scene.raycast({0.0f, 1.0f, 0.0f}, up).hasResult());
+    expect("room: from below misses", !scene.raycast({0.0f, -10.0f, 0.0f}, up).hasResult());
+    expect("room: outside misses", !scene.raycast({1000.0f, 100.0f, 0.0f}, down).hasResult());
+  }
+
+  void testRoomTransformed(Test::CollMesh &room)
+  {
+    const fm_vec3_t up{0.0f, 1.0f, 0.0f};
+    const fm_vec3_t down{0.0f, -1.0f, 0.0f};
+
+    // 90 degrees around Y: +X turns into -Z
+    P64::Object objRot{};
+    objRot.rot = {{0.0f, 0.70710678f, 0.0f, 0.70710678f}};
+    P64::Coll::MeshInstance instRot{.mesh = room.get(), .object = &objRot};
+    P64::Coll::Scene sceneRot{};
+    sceneRot.registerMesh(&instRot);
+
+    expectHit("rotated: box top", sceneRot.raycast({0.0f, 200.0f, -110.0f}, down), {0.0f, 60.0f, -110.0f}, up, 0.01f);
+    expectHit("rotated: box side", sceneRot.raycast({5.0f, 20.0f, 0.0f}, {0.0f, 0.0f, -1.0f}), {5.0f, 20.0f, -100.0f}, {0.0f, 0.0f, 1.0f}, 0.01f);
+
+    P64::Object objScaled{};
+    objScaled.pos = {0.0f, -50.0f, 0.0f};
+    objScaled.scale = {2.0f, 1.0f, 2.0f};
+    P64::Coll::MeshInstance instScaled{.mesh = room.get(), .object = &objScaled};
+    P64::Coll::Scene sceneScaled{};
+    sceneScaled.registerMesh(&instScaled);
+
+    expectHit("scaled: floor", sceneScaled.raycast({300.0f, 100.0f, 0.0f}, down), {300.0f, -50.0f, 0.0f}, up, 0.01f);
+    expectHit("scaled: box top", sceneScaled.raycast({220.0f, 100.0f, 150.0f}, down), {220.0f, 10.0f, 150.0f}, up, 0.01f);
+
+    P64::Object sphereObj{};
+    auto sphere = createShape(sphereObj, {0.0f, 0.0f, 0.0f}, 10.0f, {0.0f, -150.0f, 0.0f});
+    sceneScaled.registerBCS(&sphere);
+    simulate(sceneScaled, 30);
+    expectResting("scaled: sphere on floor", sphere.center, {0.0f, -40.0f, 0.0f});
+  }
+
+  void testRoomShapes(Test::CollMesh &room)
+  {
+    P64::Object obj{};
+    P64::Coll::MeshInstance inst{.mesh = room.get(), .object = &obj};
+    P64::Coll::Scene scene{};
+    scene.registerMesh(&inst);
+
+    P64::Object objects[6]{};
+    auto sphereDrop = createShape(objects[0], {0.0f, 40.0f, -60.0f}, 10.0f, {0.0f, -150.0f, 0.0f});
+    auto sphereFast = createShape(objects[1], {-40.0f, 150.0f, 60.0f}, 10.0f, {0.0f, -3000.0f, 0.0f});
+    auto sphereWall = createShape(objects[2], {50.0f, 20.0f, 0.0f}, 10.0f, {300.0f, 0.0f, 0.0f});
+    auto sphereRamp = createShape(objects[3], {-150.0f, 60.0f, 0.0f}, 10.0f, {0.0f, -150.0f, 0.0f});
+    // overlaps more triangles of the floor than fit into a single BVH query
+    auto sphereLarge = createShape(objects[4], {-20.0f, 80.0f, -180.0f}, 40.0f, {0.0f, -150.0f, 0.0f});
+    auto box = createShape(objects[5], {40.0f, 40.0f, 150.0f}, 10.0f, {0.0f, -150.0f, 0.0f}, P64::Coll::BCSFlags::SHAPE_BOX);
+
+    for(auto bcs : {&sphereDrop, &sphereFast, &sphereWall, &sphereRamp, &sphereLarge, &box}) {
+      scene.registerBCS(bcs);
+    }
+
+    auto &events = P64::SceneManager::getCurrent().collEventCount;
+    events = 0;
+    simulate(scene, 30);
+
+    expectResting("sphere on floor", sphereDrop.center, {0.0f, 10.0f, -60.0f});
+    expect("sphere on floor: stopped", sphereDrop.velocity.y == 0.0f);
+    expectNear("sphere on floor: object", objects[0].pos, sphereDrop.center, 0.0f);
+
+    expectResting("fast sphere on floor", sphereFast.center, {-40.0f, 10.0f, 60.0f});
+    expectNear("sphere against wall", sphereWall.center, {90.0f, 20.0f, 0.0f}, 0.05f);
+    expect("sphere against wall: hit wall", sphereWall.hitTriTypes & P64::Coll::TriType::WALL);
+    expectResting("large sphere on floor", sphereLarge.center, {-20.0f, 40.0f, -180.0f});
+    expectResting("box on floor", box.center, {40.0f, 10.0f, 150.0f});
+
+    // distance to the plane of the ramp, which goes through (-100, 0, 0)
+    auto rampDiff = sphereRamp.center - fm_vec3_t{-100.0f, 0.0f, 0.0f};
+    float rampDist = t3d_vec3_dot(rampDiff, fm_vec3_t{0.4472136f, 0.8944272f, 0.0f});
+    expect("sphere on ramp", fabsf(rampDist - 10.0f) < 0.5f, std::to_string(rampDist) + " from the surface (expected 10)");
+
+    expect("collision events", events >= 5, std::to_string(events));
+  }
+
+  void testTerrain(Test::CollMesh &terrain)
+  {
+    auto &chunks = *terrain.get();
+    uint32_t triCount = 0;
+    for(uint32_t c=0; c<chunks.chunkCount; ++c)triCount += chunks.getMesh(c).triCount;
+    expect("terrain: chunks", chunks.chunkCount == 4, std::to_string(chunks.chunkCount) + " chunks");
+    expect("terrain: triangles", triCount == TERRAIN_CELLS * TERRAIN_CELLS * 2, std::to_string(triCount));
+
+    P64::Object obj{};
+    P64::Coll::MeshInstance inst{.mesh = terrain.get(), .object = &obj};
+    P64::Coll::Scene scene{};
+    scene.registerMesh(&inst);
+
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> dist{-480.0f, 480.0f};
+    float maxError = 0.0f;
+    int missed = 0;
+    for(int i=0; i<256; ++i) {
+      float x = dist(rng);
+      float z = dist(rng);
+      auto res = scene.raycast({x, 200.0f, z}, {0.0f, -1.0f, 0.0f});
+      if(!res.hasResult()) {
+        ++missed;
+        continue;
+      }
+      maxError = fmaxf(maxError, fabsf(res.hitPos.y - terrainHeightTri(x, z)));
+    }
+    expect("terrain: raycasts hit", missed == 0, std::to_string(missed) + " missed");
+    expect("terrain: raycast height", maxError < 0.5f, "max. error " + std::to_string(maxError));
+
+    // rolls across the borders of all chunks, must never end up below the surface
+    P64::Object sphereObj{};
+    auto sphere = createShape(sphereObj, {-460.0f, 60.0f, -400.0f}, 10.0f, {200.0f, -100.0f, 200.0f});
+    scene.registerBCS(&sphere);
+
+    float minDist = 999.0f;
+    bool hitFloor = false;
+    for(int f=0; f<120; ++f) {
+      scene.update(DELTA_TIME);
+      minDist = fminf(minDist, sphere.center.y - terrainHeightTri(sphere.center.x, sphere.center.z));
+      hitFloor = hitFloor || (sphere.hitTriTypes & P64::Coll::TriType::FLOOR);
+    }
+    expect("terrain: sphere stays above", minDist > 5.0f, "min. height above surface " + std::to_string(minDist));
+    expect("terrain: sphere hit floor", hitFloor);
+  }
+}
+
+int main()
+{
+  Test::CollMesh room{createRoom()};
+  Test::CollMesh terrain{createTerrain()};
+
+  testRoomRaycast(room);
+  testRoomTransformed(room);
+  testRoomShapes(room);
+  testTerrain(terrain);
+
+  printf("%s (%d failed)\n", failCount ? "FAILED" : "PASSED", failCount);
+  return failCount ? 1 : 0;
+}
@@ -0,0 +1,14 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Host replacement for the debug drawing, nothing is drawn.
+#pragma once
+#include <libdragon.h>
+
+namespace Debug
+{
+  inline void drawAABB(const fm_vec3_t &p, const fm_vec3_t &halfExtend, color_t color = {0xFF, 0xFF, 0xFF, 0xFF}) {}
+  inline void drawLine(const fm_vec3_t &a, const fm_vec3_t &b, color_t color = {0xFF,0xFF,0xFF,0xFF}) {}
+  inline void drawSphere(const fm_vec3_t &center, float radius, color_t color = {0xFF,0xFF,0xFF,0xFF}) {}
+}
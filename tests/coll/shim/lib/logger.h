@@ -0,0 +1,19 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Host replacement for the engine logger, prints to stderr.
+#pragma once
+#include <libdragon.h>
+
+namespace P64::Log
+{
+  template <typename... ARGS>
+  void info(const char* str, ARGS &&... args) { debugf(str, args...); }
+
+  template <typename... ARGS>
+  void warn(const char* str, ARGS &&... args) { debugf(str, args...); }
+
+  template <typename... ARGS>
+  void error(const char* str, ARGS &&... args) { debugf(str, args...); }
+}
@@ -0,0 +1,114 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Host replacement for the parts of libdragon used by the runtime collision ('n64/engine/src/collision').
+// Types match libdragon's layout, math is plain float without any of the N64 specific approximations.
+#pragma once
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#define debugf(...) fprintf(stderr, __VA_ARGS__)
+
+// ticks are nanoseconds on the host
+#define TICKS_PER_SECOND 1000000000ull
+#define TICKS_TO_US(t) ((t) / 1000ull)
+#define TICKS_TO_MS(t) ((t) / 1000000ull)
+#define TICKS_FROM_US(us) ((us) * 1000ull)
+
+inline uint64_t get_ticks() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count();
+}
+
+typedef struct {
+  uint8_t r, g, b, a;
+} color_t;
+
+typedef union {
+  struct { float x, y; };
+  float v[2];
+} fm_vec2_t;
+
+typedef union {
+  struct { float x, y, z; };
+  float v[3];
+} fm_vec3_t;
+
+typedef union {
+  struct { float x, y, z, w; };
+  float v[4];
+} fm_quat_t;
+
+inline float fm_sinf(float x) { return sinf(x); }
+
+inline float fm_vec2_dot(const fm_vec2_t *a, const fm_vec2_t *b) {
+  return a->x * b->x + a->y * b->y;
+}
+
+inline float fm_vec3_dot(const fm_vec3_t *a, const fm_vec3_t *b) {
+  return a->x * b->x + a->y * b->y + a->z * b->z;
+}
+
+inline float fm_vec3_len(const fm_vec3_t *a) {
+  return sqrtf(fm_vec3_dot(a, a));
+}
+
+inline void fm_vec3_norm(fm_vec3_t *out, const fm_vec3_t *a) {
+  float len = fm_vec3_len(a);
+  if(len < 1e-20f)len = 1e-20f;
+  *out = fm_vec3_t{{a->x / len, a->y / len, a->z / len}};
+}
+
+inline void fm_vec3_cross(fm_vec3_t *out, const fm_vec3_t *a, const fm_vec3_t *b) {
+  *out = fm_vec3_t{{
+    a->y * b->z - a->z * b->y,
+    a->z * b->x - a->x * b->z,
+    a->x * b->y - a->y * b->x
+  }};
+}
+
+inline void fm_quat_inverse(fm_quat_t *out, const fm_quat_t *q) {
+  float len2 = q->x*q->x + q->y*q->y + q->z*q->z + q->w*q->w;
+  float inv = 1.0f / len2;
+  *out = fm_quat_t{{-q->x * inv, -q->y * inv, -q->z * inv, q->w * inv}};
+}
+
+inline void fm_vec3_rotate(fm_vec3_t *out, const fm_quat_t *q, const fm_vec3_t *v) {
+  // v + 2w(q x v) + 2(q x (q x v))
+  fm_vec3_t qv{{q->x, q->y, q->z}};
+  fm_vec3_t t;
+  fm_vec3_cross(&t, &qv, v);
+  t = fm_vec3_t{{t.x * 2.0f, t.y * 2.0f, t.z * 2.0f}};
+  fm_vec3_t c;
+  fm_vec3_cross(&c, &qv, &t);
+  *out = fm_vec3_t{{
+    v->x + q->w * t.x + c.x,
+    v->y + q->w * t.y + c.y,
+    v->z + q->w * t.z + c.z
+  }};
+}
+
+inline fm_vec3_t operator+(const fm_vec3_t &a, const fm_vec3_t &b) { return {{a.x + b.x, a.y + b.y, a.z + b.z}}; }
+inline fm_vec3_t operator-(const fm_vec3_t &a, const fm_vec3_t &b) { return {{a.x - b.x, a.y - b.y, a.z - b.z}}; }
+inline fm_vec3_t operator*(const fm_vec3_t &a, const fm_vec3_t &b) { return {{a.x * b.x, a.y * b.y, a.z * b.z}}; }
+inline fm_vec3_t operator/(const fm_vec3_t &a, const fm_vec3_t &b) { return {{a.x / b.x, a.y / b.y, a.z / b.z}}; }
+inline fm_vec3_t operator*(const fm_vec3_t &a, float s) { return {{a.x * s, a.y * s, a.z * s}}; }
+inline fm_vec3_t operator/(const fm_vec3_t &a, float s) { return {{a.x / s, a.y / s, a.z / s}}; }
+inline fm_vec3_t operator-(const fm_vec3_t &a) { return {{-a.x, -a.y, -a.z}}; }
+
+inline fm_vec3_t& operator+=(fm_vec3_t &a, const fm_vec3_t &b) { return a = a + b; }
+inline fm_vec3_t& operator-=(fm_vec3_t &a, const fm_vec3_t &b) { return a = a - b; }
+inline fm_vec3_t& operator*=(fm_vec3_t &a, const fm_vec3_t &b) { return a = a * b; }
+inline fm_vec3_t& operator*=(fm_vec3_t &a, float s) { return a = a * s; }
+
+inline fm_vec3_t operator*(const fm_quat_t &q, const fm_vec3_t &v) {
+  fm_vec3_t res;
+  fm_vec3_rotate(&res, &q, &v);
+  return res;
+}
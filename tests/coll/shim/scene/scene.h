@@ -0,0 +1,29 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Host replacement for the engine scene, only the object transform and collision events are used.
+#pragma once
+#include <libdragon.h>
+#include "collision/shapes.h"
+
+namespace P64
+{
+  class Object
+  {
+    public:
+      fm_quat_t rot{{0.0f, 0.0f, 0.0f, 1.0f}};
+      fm_vec3_t pos{};
+      fm_vec3_t scale{{1.0f, 1.0f, 1.0f}};
+  };
+
+  class Scene
+  {
+    public:
+      uint32_t collEventCount{0};
+
+      void onObjectCollision(const Coll::CollEvent &event) {
+        ++collEventCount;
+      }
+  };
+}
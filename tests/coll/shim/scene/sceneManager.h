@@ -0,0 +1,19 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <libdragon.h>
+
+namespace P64
+{
+  class Scene;
+}
+
+namespace P64::SceneManager
+{
+  /**
+   * Scene receiving the collision events, a single one that lives for the whole process.
+   */
+  Scene &getCurrent();
+}
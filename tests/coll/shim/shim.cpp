@@ -0,0 +1,12 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "scene/scene.h"
+#include "scene/sceneManager.h"
+
+P64::Scene &P64::SceneManager::getCurrent()
+{
+  static Scene scene{};
+  return scene;
+}
@@ -0,0 +1,24 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Host replacement for the vector functions of tiny3d used by the runtime collision.
+#pragma once
+#include <libdragon.h>
+
+typedef fm_vec3_t T3DVec3;
+
+inline float t3d_vec3_dot(const T3DVec3 *a, const T3DVec3 *b) { return fm_vec3_dot(a, b); }
+inline float t3d_vec3_len2(const T3DVec3 *a) { return fm_vec3_dot(a, a); }
+inline float t3d_vec3_len(const T3DVec3 *a) { return fm_vec3_len(a); }
+inline void t3d_vec3_norm(T3DVec3 *a) { fm_vec3_norm(a, a); }
+
+inline float t3d_vec3_distance2(const T3DVec3 *a, const T3DVec3 *b) {
+  T3DVec3 diff = *a - *b;
+  return t3d_vec3_len2(&diff);
+}
+
+inline float t3d_vec3_dot(const T3DVec3 &a, const T3DVec3 &b) { return fm_vec3_dot(&a, &b); }
+inline float t3d_vec3_len2(const T3DVec3 &a) { return fm_vec3_dot(&a, &a); }
+inline float t3d_vec3_len(const T3DVec3 &a) { return fm_vec3_len(&a); }
+inline float t3d_vec3_distance2(const T3DVec3 &a, const T3DVec3 &b) { return t3d_vec3_distance2(&a, &b); }
@@ -0,0 +1,261 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+// Compares the two ways the viewport can collect the objects to draw in a scene of 10k objects:
+// - 'walk': the full recursive walk over the object tree ('iterateObjects' in the viewport, as it was before
+//   the scene index), here with a frustum test against the bounds of each object so both paths return the same.
+// - 'index': 'Editor::SceneIndex::sync' with the changes logged since the last frame, then a frustum query
+//   through its 'Utils::DynamicBVH'.
+// The camera flies over the scene, each scenario edits the scene differently per frame:
+// - 'static': nothing changes
+// - 'gizmo': a few objects get moved, as when dragging a selection
+// - 'structure': objects get added and removed, which makes the index walk the tree again
+// Prints the time per frame of both paths (host time), and fails if they ever return different objects.
+//
+// The objects are a plain 'Project::Object' tree with a 'Project::SceneChanges' log,
+// 'Project::Scene' itself needs the editor context and can't be created here.
+//
+// Usage: sceneIndexBench [--quick]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "editor/sceneIndex.h"
+#include "project/scene/object.h"
+#include "project/scene/sceneChanges.h"
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace
+{
+  constexpr uint32_t GROUP_COUNT = 100;
+  constexpr uint32_t GROUP_SIZE = 100; // 10k objects in total
+  constexpr float SCENE_SIZE = 40'000.0f;
+  constexpr uint32_t MOVED_PER_FRAME = 8;
+  constexpr uint32_t ADDED_PER_FRAME = 1;
+
+  struct Scenario
+  {
+    const char* name;
+    uint32_t moved; // objects moved per frame
+    uint32_t added; // objects added (and removed again) per frame
+  };
+
+  constexpr Scenario SCENARIOS[] = {
+    {"static", 0, 0},
+    {"gizmo", MOVED_PER_FRAME, 0},
+    {"structure", 0, ADDED_PER_FRAME},
+  };
+
+  struct BenchScene
+  {
+    Project::Object root{};
+    Project::SceneChanges changes{};
+    std::vector<Project::Object*> objects{};
+    uint32_t nextUUID{1};
+  };
+
+  /**
+   * Stand-in for the viewport's 'getObjectBounds', a box from the object's UUID.
+   * Every 50th object has no bounds (e.g. a light) and is always visible.
+   */
+  Utils::AABB getBounds(Project::Object &obj, bool &alwaysVisible)
+  {
+    Utils::AABB aabb{};
+    if(obj.uuid % 50 == 0) {
+      alwaysVisible = true;
+      aabb.min = {-1,-1,-1};
+      aabb.max = {1,1,1};
+      return aabb;
+    }
+    float size = 4.0f + (float)(obj.uuid % 7) * 6.0f;
+    aabb.min = {-size, 0.0f, -size};
+    aabb.max = {size, size * 2.0f, size};
+    return aabb;
+  }
+
+  std::shared_ptr<Project::Object> createObject(BenchScene &scene, Project::Object &parent, const glm::vec3 &pos)
+  {
+    auto obj = std::make_shared<Project::Object>(parent);
+    obj->uuid = scene.nextUUID++;
+    obj->pos.value = pos;
+    obj->rot.value = glm::quat{1, 0, 0, 0};
+    obj->scale.value = {1, 1, 1};
+    return obj;
+  }
+
+  /**
+   * Groups of objects placed around a random point, like props of a level.
+   * Some groups and objects are disabled.
+   */
+  void createScene(BenchScene &scene)
+  {
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> distPos{SCENE_SIZE * -0.5f, SCENE_SIZE * 0.5f};
+    std::uniform_real_distribution<float> distOffset{-300.0f, 300.0f};
+    std::uniform_real_distribution<float> distHeight{0.0f, 50.0f};
+    std::uniform_int_distribution<int> distDisabled{0, 49};
+
+    for(uint32_t g=0; g<GROUP_COUNT; ++g) {
+      glm::vec3 center{distPos(rng), 0.0f, distPos(rng)};
+      auto group = createObject(scene, scene.root, center);
+      group->enabled = distDisabled(rng) != 0;
+      scene.root.children.push_back(group);
+      scene.objects.push_back(group.get());
+
+      for(uint32_t i=1; i<GROUP_SIZE; ++i) {
+        glm::vec3 pos = center + glm::vec3{distOffset(rng), distHeight(rng), distOffset(rng)};
+        auto obj = createObject(scene, *group, pos);
+        obj->enabled = distDisabled(rng) != 0;
+        group->children.push_back(obj);
+        scene.objects.push_back(obj.get());
+      }
+    }
+  }
+
+  /**
+   * The old path: visit every enabled object (disabled ones hide their children),
+   * get its bounds and test them against the frustum.
+   */
+  void walkObjects(Project::Object &parent, const Utils::Frustum &frustum, std::vector<Project::Object*> &out)
+  {
+    for(auto &child : parent.children)
+    {
+      if(!child->enabled)continue;
+
+      bool alwaysVisible = false;
+      auto aabb = getBounds(*child, alwaysVisible);
+      aabb.transform(
+        child->pos.resolve(child->propOverrides),
+        child->rot.resolve(child->propOverrides),
+        child->scale.resolve(child->propOverrides)
+      );
+      if(alwaysVisible || frustum.vsAABB(aabb))out.push_back(child.get());
+
+      walkObjects(*child, frustum, out);
+    }
+  }
+
+  Utils::Frustum getFrustum(uint32_t frame)
+  {
+    float angle = (float)frame * 0.01f;
+    glm::vec3 camPos{sinf(angle) * SCENE_SIZE * 0.3f, 400.0f, cosf(angle) * SCENE_SIZE * 0.3f};
+    glm::vec3 camTarget{sinf(angle + 0.6f) * SCENE_SIZE * 0.2f, 0.0f, cosf(angle + 0.6f) * SCENE_SIZE * 0.2f};
+    // same FOV and near/far planes as the viewport camera
+    auto proj = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 10.0f, 10'000.0f);
+    auto view = glm::lookAt(camPos, camTarget, glm::vec3{0, 1, 0});
+    return Utils::Frustum::fromMatrix(proj * view);
+  }
+
+  /**
+   * Edits of a single frame, done through the same calls as in the editor
+   * ('Scene::markObjectChanged', 'Scene::addObject', 'Scene::removeObject' all log to 'SceneChanges').
+   */
+  void editScene(BenchScene &scene, const Scenario &scenario, std::mt19937 &rng)
+  {
+    std::uniform_int_distribution<uint32_t> distObj{0, (uint32_t)scene.objects.size() - 1};
+    std::uniform_real_distribution<float> distMove{-20.0f, 20.0f};
+
+    for(uint32_t i=0; i<scenario.moved; ++i) {
+      auto &obj = *scene.objects[distObj(rng)];
+      obj.pos.resolve(obj.propOverrides) += glm::vec3{distMove(rng), 0.0f, distMove(rng)};
+      obj.markChanged();
+      scene.changes.markObject(obj.uuid);
+    }
+
+    for(uint32_t i=0; i<scenario.added; ++i) {
+      auto &group = *scene.root.children[distObj(rng) % scene.root.children.size()];
+      auto &children = group.children;
+      if(children.size() >= GROUP_SIZE) {
+        std::erase(scene.objects, children.front().get());
+        children.erase(children.begin());
+      }
+      auto obj = createObject(scene, group, group.pos.value + glm::vec3{distMove(rng), 0.0f, distMove(rng)});
+      children.push_back(obj);
+      scene.objects.push_back(obj.get());
+      scene.changes.markStructure();
+    }
+  }
+
+  struct Result
+  {
+    double timeWalkMs{};
+    double timeIndexMs{};
+    uint64_t visible{};
+    uint32_t mismatches{};
+  };
+
+  Result runScenario(const Scenario &scenario, uint32_t frames)
+  {
+    BenchScene scene{};
+    createScene(scene);
+
+    Editor::SceneIndex index{getBounds};
+    index.sync(scene.root, scene.changes); // initial build, not part of the timing
+
+    std::mt19937 rng{5678};
+    std::vector<Project::Object*> resWalk{};
+    std::vector<Project::Object*> resIndex{};
+    Result res{};
+
+    for(uint32_t f=0; f<frames; ++f)
+    {
+      editScene(scene, scenario, rng);
+      auto frustum = getFrustum(f);
+
+      auto start = std::chrono::steady_clock::now();
+      resWalk.clear();
+      walkObjects(scene.root, frustum, resWalk);
+      auto mid = std::chrono::steady_clock::now();
+      index.sync(scene.root, scene.changes);
+      index.query(frustum, resIndex, true);
+      auto end = std::chrono::steady_clock::now();
+
+      res.timeWalkMs += std::chrono::duration<double, std::milli>(mid - start).count();
+      res.timeIndexMs += std::chrono::duration<double, std::milli>(end - mid).count();
+      res.visible += resIndex.size();
+
+      // the index returns objects without bounds last, the walk in tree order
+      std::sort(resWalk.begin(), resWalk.end());
+      std::sort(resIndex.begin(), resIndex.end());
+      if(resWalk != resIndex)++res.mismatches;
+    }
+
+    res.timeWalkMs /= frames;
+    res.timeIndexMs /= frames;
+    res.visible /= frames;
+    return res;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  bool quick = false;
+  for(int i=1; i<argc; ++i) {
+    if(strcmp(argv[i], "--quick") == 0)quick = true;
+  }
+
+  const uint32_t frames = quick ? 60 : 1000;
+
+  printf("%-10s %8s %8s %10s %10s %8s\n", "scenario", "objects", "visible", "walk [ms]", "index [ms]", "speedup");
+
+  bool failed = false;
+  for(auto &scenario : SCENARIOS)
+  {
+    auto res = runScenario(scenario, frames);
+    printf("%-10s %8u %8lu %10.4f %10.4f %7.1fx\n", scenario.name, GROUP_COUNT * GROUP_SIZE, (unsigned long)res.visible,
+      res.timeWalkMs, res.timeIndexMs, res.timeWalkMs / std::max(res.timeIndexMs, 1e-9)
+    );
+    if(res.mismatches) {
+      printf("  ERROR: index and walk returned different objects in %u of %u frames\n", res.mismatches, frames);
+      failed = true;
+    }
+  }
+
+  printf("\nms: host time per frame, 'index' includes 'SceneIndex::sync' and the query\n");
+  return failed ? 1 : 0;
+}